@@ -23,6 +23,7 @@
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/grid/reference_cell.h>
 
@@ -32,6 +33,7 @@
 #include <boost/serialization/map.hpp>
 
 #include <limits>
+#include <list>
 #include <string>
 #include <tuple>
 #include <typeinfo>
@@ -2590,10 +2592,10 @@ public:
   DataOutInterface();
 
   /**
-   * Destructor. Does nothing, but is declared virtual since this class has
-   * virtual functions.
+   * Destructor. Waits for all output started by write_vtu_in_background()
+   * that has not finished yet.
    */
-  virtual ~DataOutInterface() = default;
+  virtual ~DataOutInterface();
 
   /**
    * Obtain data through get_patches() and write it to <tt>out</tt> in OpenDX
@@ -2687,6 +2689,42 @@ public:
   write_vtu_in_parallel(const std::string &filename,
                         const MPI_Comm &   comm) const;
 
+  /**
+   * Write the data currently held by this object in VTU format to the file
+   * @p filename on a background task and return immediately. In contrast to
+   * write_vtu(), this function first takes a snapshot of the patches, the
+   * names of the data sets and the VTK flags, so that the object can be
+   * reused, e.g., by calling build_patches() for the next time step, while
+   * the previous snapshot is still being encoded and written. Writing to
+   * the file happens concurrently to the calling thread if more than one
+   * thread is available, see MultithreadInfo.
+   *
+   * Since every snapshot holds a copy of the patches, at most
+   * @p max_pending_writes snapshots are kept in flight. If this number has
+   * been reached, the function waits for the oldest write to finish before
+   * starting a new one.
+   *
+   * Errors that occur while writing, such as a file that cannot be opened,
+   * are reported by the next call to wait_for_background_writes(), or by a
+   * call to this function that needs to wait for the failing write.
+   *
+   * @note In a parallel program, each process can write its own piece this
+   * way, with the process with rank zero calling write_pvtu_record() as
+   * usual. Writing a single file through MPI I/O as in
+   * write_vtu_in_parallel() involves collective communication and is not
+   * supported in the background.
+   */
+  void
+  write_vtu_in_background(const std::string &filename,
+                          const unsigned int max_pending_writes = 2) const;
+
+  /**
+   * Wait for all output started by write_vtu_in_background() to finish. If
+   * one of the writes has thrown an exception, it is rethrown here.
+   */
+  void
+  wait_for_background_writes() const;
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -3109,6 +3147,12 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  /**
+   * The tasks writing the snapshots handed to write_vtu_in_background()
+   * that have not been waited for yet, oldest first.
+   */
+  mutable std::list<Threads::Task<void>> background_writes;
 };
 
 
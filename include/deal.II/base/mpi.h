@@ -549,6 +549,33 @@ namespace Utilities
         const MPI_Comm &          mpi_communicator,
         const ArrayView<T> &      sums);
 
+    /**
+     * Start a non-blocking sum over all processors of the elements of the
+     * array @p values, corresponding to the <code>MPI_Iallreduce</code>
+     * function. The function returns immediately, and the sums are only
+     * available in @p sums once the operation identified by @p request has
+     * completed, i.e., after a call to <code>MPI_Wait()</code> on it. Until
+     * then, neither @p values nor @p sums may be accessed. This allows to
+     * overlap a global reduction with local work, as done in the
+     * SolverPipelinedCG class.
+     *
+     * If the result is available immediately, which is the case if deal.II
+     * is not configured for use of MPI, if MPI has not been initialized, or
+     * if the MPI implementation does not support MPI 3.0 and a blocking
+     * reduction is used instead, @p request is set to
+     * <code>MPI_REQUEST_NULL</code> and there is nothing to wait for.
+     *
+     * Input and output arrays may be the same.
+     *
+     * @note This function is only implemented for real scalar types.
+     */
+    template <typename T>
+    void
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums,
+         MPI_Request &             request);
+
     /**
      * Perform an MPI sum of the entries of a symmetric tensor.
      *
@@ -275,6 +275,49 @@ namespace Utilities
               std::copy(values.begin(), values.end(), output.begin());
           }
       }
+
+
+
+      template <typename T>
+      void
+      iall_reduce(const MPI_Op &            mpi_op,
+                  const ArrayView<const T> &values,
+                  const MPI_Comm &          mpi_communicator,
+                  const ArrayView<T> &      output,
+                  MPI_Request &             request)
+      {
+        AssertDimension(values.size(), output.size());
+        request = MPI_REQUEST_NULL;
+#ifdef DEAL_II_WITH_MPI
+        if (job_supports_mpi())
+          {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+            const int ierr =
+              MPI_Iallreduce(values != output ?
+                               DEAL_II_MPI_CONST_CAST(values.data()) :
+                               MPI_IN_PLACE,
+                             static_cast<void *>(output.data()),
+                             static_cast<int>(values.size()),
+                             internal::mpi_type_id(values.data()),
+                             mpi_op,
+                             mpi_communicator,
+                             &request);
+            AssertThrowMPI(ierr);
+#  else
+            // fall back to a blocking reduction without support for
+            // non-blocking collectives
+            all_reduce(mpi_op, values, mpi_communicator, output);
+#  endif
+          }
+        else
+#endif
+          {
+            (void)mpi_op;
+            (void)mpi_communicator;
+            if (values != output)
+              std::copy(values.begin(), values.end(), output.begin());
+          }
+      }
     } // namespace internal
 
 
@@ -321,6 +364,18 @@ namespace Utilities
 
 
 
+    template <typename T>
+    void
+    isum(const ArrayView<const T> &values,
+         const MPI_Comm &          mpi_communicator,
+         const ArrayView<T> &      sums,
+         MPI_Request &             request)
+    {
+      internal::iall_reduce(MPI_SUM, values, mpi_communicator, sums, request);
+    }
+
+
+
     template <int rank, int dim, typename Number>
     Tensor<rank, dim, Number>
     sum(const Tensor<rank, dim, Number> &t, const MPI_Comm &mpi_communicator)
@@ -79,6 +79,35 @@ namespace Utilities
              const Triangulation<dim, spacedim> &tria,
              const Mapping<dim, spacedim> &      mapping);
 
+      /**
+       * Update the internal data structures for new positions @p points of
+       * the points passed to the last call of reinit(), e.g., for an
+       * interface that has moved slightly, using the same triangulation and
+       * mapping as before.
+       *
+       * The new positions are sent to the processes that own the cells found
+       * for the points during the last setup, reusing the existing
+       * communication pattern. There, the previous cell of each point is
+       * tested first, and only points that have left their cell are searched
+       * for among the locally owned cells around it. If every point is still
+       * owned by the same process, the reference positions and the
+       * assignment to cells are patched in place, and the communication
+       * pattern is kept. Otherwise, and if the triangulation has changed,
+       * the number of points is different, or the map from points to cells
+       * has not been unique (see is_map_unique()), the function falls back to
+       * a full reinit().
+       *
+       * @note In contrast to reinit(), only a single cell is kept for a point
+       *   that has moved onto a geometric entity shared by several cells.
+       *
+       * @return Whether the previous communication pattern could be reused.
+       *
+       * @warning This is a collective call that needs to be executed by all
+       *   processors in the communicator.
+       */
+      bool
+      reinit_incremental(const std::vector<Point<spacedim>> &points);
+
       /**
        * Data of points positioned in a cell.
        */
@@ -167,6 +196,17 @@ namespace Utilities
       const Mapping<dim, spacedim> &
       get_mapping() const;
 
+      /**
+       * Return the GridTools::Cache object used for the point searches. It is
+       * created by the first call to reinit() for a given triangulation and
+       * mapping and kept across subsequent calls of reinit() and
+       * reinit_incremental(), so that the vertex-to-cell maps and the
+       * bounding-box trees are only computed again once the triangulation
+       * has changed.
+       */
+      const GridTools::Cache<dim, spacedim> &
+      get_cache() const;
+
       /**
        * Return if the internal data structures have been set up and if yes
        * whether they are still valid (and not invalidated due to changes of the
@@ -215,6 +255,13 @@ namespace Utilities
        */
       SmartPointer<const Mapping<dim, spacedim>> mapping;
 
+      /**
+       * Cache of the point search data structures of the triangulation and
+       * mapping used during reinit(). The cache marks its content as
+       * outdated when the triangulation signals a change.
+       */
+      std::unique_ptr<GridTools::Cache<dim, spacedim>> cache;
+
       /**
        * (One-to-one) relation of points and cells.
        */
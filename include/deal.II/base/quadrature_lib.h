@@ -871,6 +871,43 @@ public:
                                     const bool         use_odd_order = true);
 };
 
+/**
+ * Gauss quadrature for simplex entities defined in collapsed coordinates.
+ *
+ * The points are the image of the tensor product of @p n_points_1D
+ * QGauss<1> points per direction on the unit hypercube under the collapsed
+ * (Duffy) map
+ * @f{align*}{
+ *   x = a (1-b) (1-c), \quad y = b (1-c), \quad z = c
+ * @f}
+ * (with the obvious restriction in 2D), and the weights contain the
+ * determinant $(1-b)(1-c)^2$ of this map. The points are numbered
+ * lexicographically in the collapsed coordinates $(a,b,c)$ with $a$ running
+ * fastest. A rule with $n$ points per direction integrates polynomials of
+ * complete degree $2n-d$ exactly, where $d$ is the space dimension.
+ *
+ * While this rule needs more points than QGaussSimplex for the same order,
+ * its tensor-product structure in collapsed coordinates is detected by the
+ * matrix-free framework, which then evaluates FE_SimplexP and FE_SimplexDGP
+ * with sum-factorization kernels instead of a dense matrix-vector product,
+ * see internal::MatrixFreeFunctions::ElementType::tensor_collapsed_simplex.
+ *
+ * For 1D, the quadrature rule degenerates to a
+ * `dealii::QGauss<1>(n_points_1D)`.
+ *
+ * @ingroup simplex
+ */
+template <int dim>
+class QCollapsedSimplex : public QSimplex<dim>
+{
+public:
+  /**
+   * Constructor taking the number of quadrature points in each collapsed
+   * coordinate direction @p n_points_1D.
+   */
+  explicit QCollapsedSimplex(const unsigned int n_points_1D);
+};
+
 /**
  * Iterated quadrature for simplices. Since simplex cannot be described as
  * tensor products the base quadrature has equal dimension.
@@ -28,12 +28,21 @@
 #  include <deal.II/base/thread_management.h>
 
 #  ifdef DEAL_II_WITH_TBB
-#    include <tbb/pipeline.h>
+#    include <tbb/blocked_range.h>
+// oneTBB moved the lambda interface of the pipeline to a header of its own
+#    if TBB_INTERFACE_VERSION >= 12000
+#      include <tbb/parallel_pipeline.h>
+#    else
+#      include <tbb/pipeline.h>
+#    endif
 #  endif
 
+#  include <algorithm>
 #  include <functional>
 #  include <iterator>
+#  include <limits>
 #  include <memory>
+#  include <type_traits>
 #  include <utility>
 #  include <vector>
 
@@ -168,8 +177,8 @@ namespace WorkStream
      * implementation described in the paper by Turcksin, Kronbichler and
      * Bangerth (see
      * @ref workstream_paper).
-     * Here, no coloring is provided, so copying is done sequentially using a
-     * TBB filter.
+     * Here, no coloring is provided, so copying is done sequentially in a
+     * serial stage of a tbb::parallel_pipeline.
      *
      * Even though this implementation is slower than the third implementation
      * discussed in that paper, we need to keep it around for two reasons: (i)
@@ -178,11 +187,69 @@ namespace WorkStream
      */
     namespace tbb_no_coloring
     {
+      /**
+       * The type that selects whether a stage of the pipeline runs serially
+       * or in parallel. Legacy TBB declares it as tbb::filter::mode, whereas
+       * oneTBB has the scoped enumeration tbb::filter_mode.
+       */
+#    if TBB_INTERFACE_VERSION >= 12000
+      using filter_mode = tbb::filter_mode;
+#    else
+      using filter_mode = tbb::filter::mode;
+#    endif
+
+
+
+      /**
+       * A type trait that is true if @p Iterator is a random access iterator,
+       * and false for all other iterators, including those for which
+       * std::iterator_traits does not define an iterator category.
+       */
+      template <typename Iterator, typename = void>
+      struct IsRandomAccessIterator : std::false_type
+      {};
+
+      template <typename Iterator>
+      struct IsRandomAccessIterator<
+        Iterator,
+        typename std::enable_if<std::is_base_of<
+          std::random_access_iterator_tag,
+          typename std::iterator_traits<Iterator>::iterator_category>::value>::
+          type> : std::true_type
+      {};
+
+
+
+      /**
+       * Return the number of elements in the range from @p begin to @p end
+       * if it can be computed in constant time, i.e., for random access
+       * iterators. For all other iterators, return the largest representable
+       * number to indicate that the length of the range is unknown.
+       */
+      template <typename Iterator>
+      typename std::enable_if<IsRandomAccessIterator<Iterator>::value,
+                              std::size_t>::type
+      n_elements_in_range(const Iterator &begin, const Iterator &end)
+      {
+        return static_cast<std::size_t>(end - begin);
+      }
+
+      template <typename Iterator>
+      typename std::enable_if<!IsRandomAccessIterator<Iterator>::value,
+                              std::size_t>::type
+      n_elements_in_range(const Iterator &, const Iterator &)
+      {
+        return std::numeric_limits<std::size_t>::max();
+      }
+
+
+
       /**
        * A class that creates a sequence of items from a range of iterators.
+       * It forms the first, serial stage of the pipeline.
        */
       template <typename Iterator, typename ScratchData, typename CopyData>
-      class IteratorRangeToItemStream : public tbb::filter
+      class IteratorRangeToItemStream
       {
       public:
         /**
@@ -248,7 +315,9 @@ namespace WorkStream
           /**
            * Number of items identified by the work_items array that the
            * Worker and Copier pipeline stage need to work on. The maximum
-           * value of this variable will be chunk_size.
+           * value of this variable will be chunk_size, but it may be smaller
+           * towards the end of the iterator range, see
+           * IteratorRangeToItemStream::operator().
            */
           unsigned int n_items;
 
@@ -322,8 +391,8 @@ namespace WorkStream
                                   const unsigned int chunk_size,
                                   const ScratchData &sample_scratch_data,
                                   const CopyData &   sample_copy_data)
-          : tbb::filter(/*is_serial=*/true)
-          , remaining_iterator_range(begin, end)
+          : remaining_iterator_range(begin, end)
+          , n_remaining_elements(n_elements_in_range(begin, end))
           , item_buffer(buffer_size)
           , sample_scratch_data(sample_scratch_data)
           , chunk_size(chunk_size)
@@ -346,10 +415,22 @@ namespace WorkStream
 
 
         /**
-         * Create an item and return a pointer to it.
+         * Create an item and return a pointer to it. If there are no elements
+         * left, stop the pipeline via the @p flow_control argument and return
+         * a null pointer.
+         *
+         * The number of elements in the item is chosen by guided
+         * self-scheduling: As long as there is plenty of work left, each item
+         * holds chunk_size elements. Towards the end of the range, the items
+         * get smaller so that the remaining elements are spread over all
+         * items that can be in flight at the same time, rather than leaving
+         * most threads idle while a few of them work on the last full chunks.
+         * This requires the length of the range, which is only known for
+         * random access iterators; for all other iterators, every item holds
+         * chunk_size elements.
          */
-        virtual void *
-        operator()(void *) override
+        ItemType *
+        operator()(tbb::flow_control &flow_control)
         {
           // find first unused item. we know that there must be one
           // because we have set the maximal number of tokens in flight
@@ -376,13 +457,23 @@ namespace WorkStream
           Assert(current_item != nullptr,
                  ExcMessage("This can't be. There must be a free item!"));
 
-          // initialize the next item. it may
-          // consist of at most chunk_size
-          // elements
+          // initialize the next item. it may consist of at most chunk_size
+          // elements, and of fewer elements once the remaining range gets
+          // too short to keep all items in the buffer busy. (round up
+          // without computing n_remaining_elements+item_buffer.size(), which
+          // overflows if the length of the range is unknown)
+          const std::size_t n_elements_per_buffered_item =
+            (n_remaining_elements == 0) ?
+              0 :
+              (n_remaining_elements - 1) / item_buffer.size() + 1;
+          const std::size_t n_elements_in_item = std::max<std::size_t>(
+            1,
+            std::min<std::size_t>(chunk_size, n_elements_per_buffered_item));
+
           current_item->n_items = 0;
           while ((remaining_iterator_range.first !=
                   remaining_iterator_range.second) &&
-                 (current_item->n_items < chunk_size))
+                 (current_item->n_items < n_elements_in_item))
             {
               current_item->work_items[current_item->n_items] =
                 remaining_iterator_range.first;
@@ -390,11 +481,17 @@ namespace WorkStream
               ++remaining_iterator_range.first;
               ++current_item->n_items;
             }
+          n_remaining_elements -=
+            std::min<std::size_t>(n_remaining_elements, current_item->n_items);
 
           if (current_item->n_items == 0)
-            // there were no items
-            // left. terminate the pipeline
-            return nullptr;
+            {
+              // there were no items left. release the item again and
+              // terminate the pipeline
+              current_item->currently_in_use = false;
+              flow_control.stop();
+              return nullptr;
+            }
           else
             return current_item;
         }
@@ -406,6 +503,13 @@ namespace WorkStream
          */
         std::pair<Iterator, Iterator> remaining_iterator_range;
 
+        /**
+         * The number of elements in remaining_iterator_range, or the largest
+         * representable number if the length of the range is unknown, see
+         * n_elements_in_range().
+         */
+        std::size_t n_remaining_elements;
+
         /**
          * A buffer that will store items.
          */
@@ -452,10 +556,11 @@ namespace WorkStream
         const ScratchData &sample_scratch_data;
 
         /**
-         * Number of elements of the iterator range that each thread should
-         * work on sequentially; a large number makes sure that each thread
-         * gets a significant amount of work before the next task switch
-         * happens, whereas a small number is better for load balancing.
+         * Maximal number of elements of the iterator range that each thread
+         * should work on sequentially; a large number makes sure that each
+         * thread gets a significant amount of work before the next task
+         * switch happens, whereas a small number is better for load
+         * balancing.
          */
         const unsigned int chunk_size;
       };
@@ -468,9 +573,13 @@ namespace WorkStream
        * can run in parallel.
        */
       template <typename Iterator, typename ScratchData, typename CopyData>
-      class TBBWorker : public tbb::filter
+      class TBBWorker
       {
       public:
+        using ItemType =
+          typename IteratorRangeToItemStream<Iterator, ScratchData, CopyData>::
+            ItemType;
+
         /**
          * Constructor. Takes a reference to the object on which we will
          * operate as well as a pointer to the function that will do the
@@ -480,8 +589,7 @@ namespace WorkStream
           const std::function<void(const Iterator &, ScratchData &, CopyData &)>
             &  worker,
           bool copier_exist = true)
-          : tbb::filter(/* is_serial= */ false)
-          , worker(worker)
+          : worker(worker)
           , copier_exist(copier_exist)
         {}
 
@@ -489,17 +597,9 @@ namespace WorkStream
         /**
          * Work on an item.
          */
-        void *
-        operator()(void *item) override
+        ItemType *
+        operator()(ItemType *current_item) const
         {
-          // first unpack the current item
-          using ItemType =
-            typename IteratorRangeToItemStream<Iterator,
-                                               ScratchData,
-                                               CopyData>::ItemType;
-
-          ItemType *current_item = static_cast<ItemType *>(item);
-
           // we need to find an unused scratch data object in the list that
           // corresponds to the current thread and then mark it as used. if
           // we can't find one, create one
@@ -589,7 +689,7 @@ namespace WorkStream
 
           // then return the original pointer
           // to the now modified object
-          return item;
+          return current_item;
         }
 
 
@@ -616,9 +716,13 @@ namespace WorkStream
        * items are copied in the same order in which they are created.
        */
       template <typename Iterator, typename ScratchData, typename CopyData>
-      class TBBCopier : public tbb::filter
+      class TBBCopier
       {
       public:
+        using ItemType =
+          typename IteratorRangeToItemStream<Iterator, ScratchData, CopyData>::
+            ItemType;
+
         /**
          * Constructor. Takes a reference to the object on which we will
          * operate as well as a pointer to the function that will do the
@@ -626,25 +730,16 @@ namespace WorkStream
          * similar.
          */
         TBBCopier(const std::function<void(const CopyData &)> &copier)
-          : tbb::filter(/*is_serial=*/true)
-          , copier(copier)
+          : copier(copier)
         {}
 
 
         /**
          * Work on a single item.
          */
-        void *
-        operator()(void *item) override
+        void
+        operator()(ItemType *current_item) const
         {
-          // first unpack the current item
-          using ItemType =
-            typename IteratorRangeToItemStream<Iterator,
-                                               ScratchData,
-                                               CopyData>::ItemType;
-
-          ItemType *current_item = static_cast<ItemType *>(item);
-
           // initiate copying data. for the same reasons as in the worker class
           // above, catch exceptions rather than letting it propagate into
           // unknown territories
@@ -667,11 +762,6 @@ namespace WorkStream
 
           // mark current item as usable again
           current_item->currently_in_use = false;
-
-
-          // return an invalid item since we are at the end of the
-          // pipeline
-          return nullptr;
         }
 
 
@@ -706,19 +796,31 @@ namespace WorkStream
                                         sample_scratch_data,
                                         sample_copy_data);
 
-        TBBWorker<Iterator, ScratchData, CopyData> worker_filter(worker);
-        TBBCopier<Iterator, ScratchData, CopyData> copier_filter(copier);
-
-        // now create a pipeline from these stages
-        tbb::pipeline assembly_line;
-        assembly_line.add_filter(iterator_range_to_item_stream);
-        assembly_line.add_filter(worker_filter);
-        assembly_line.add_filter(copier_filter);
-
-        // and run it
-        assembly_line.run(queue_length);
-
-        assembly_line.clear();
+        const TBBWorker<Iterator, ScratchData, CopyData> worker_filter(worker);
+        const TBBCopier<Iterator, ScratchData, CopyData> copier_filter(copier);
+
+        using ItemType =
+          typename IteratorRangeToItemStream<Iterator, ScratchData, CopyData>::
+            ItemType;
+
+        // now create a pipeline from these stages and run it. the first and
+        // the last stage run serially and in order, whereas the tasks of the
+        // worker stage are scheduled onto all threads by work stealing. at
+        // most queue_length items are in flight at any time, which is the
+        // number of items the first stage has buffer space for
+        tbb::parallel_pipeline(
+          queue_length,
+          tbb::make_filter<void, ItemType *>(
+            filter_mode::serial_in_order,
+            [&iterator_range_to_item_stream](tbb::flow_control &flow_control) {
+              return iterator_range_to_item_stream(flow_control);
+            }) &
+            tbb::make_filter<ItemType *, ItemType *>(
+              filter_mode::parallel,
+              [&worker_filter](ItemType *item) { return worker_filter(item); }) &
+            tbb::make_filter<ItemType *, void>(
+              filter_mode::serial_in_order,
+              [&copier_filter](ItemType *item) { copier_filter(item); }));
       }
 
     }    // namespace tbb_no_coloring
@@ -1034,19 +1136,32 @@ namespace WorkStream
           const CopyData &                          sample_copy_data,
           const unsigned int                        chunk_size)
       {
+        using WorkerAndCopier = internal::tbb_colored::
+          WorkerAndCopier<Iterator, ScratchData, CopyData>;
+
+        // set up the worker and copier object once for all colors. since the
+        // thread-local scratch and copy data objects are marked as unused
+        // whenever a range has been worked on, the objects created while
+        // working on one color are re-used for all later colors instead of
+        // being created anew for each color
+        WorkerAndCopier worker_and_copier(worker,
+                                          copier,
+                                          sample_scratch_data,
+                                          sample_copy_data);
+
         // loop over the various colors of what we're given
         for (unsigned int color = 0; color < colored_iterators.size(); ++color)
           if (colored_iterators[color].size() > 0)
             {
-              using WorkerAndCopier = internal::tbb_colored::
-                WorkerAndCopier<Iterator, ScratchData, CopyData>;
-
-              using RangeType = typename std::vector<Iterator>::const_iterator;
-
-              WorkerAndCopier worker_and_copier(worker,
-                                                copier,
-                                                sample_scratch_data,
-                                                sample_copy_data);
+              // the chunk size is an upper bound for the grain size. small
+              // colors, which are typical for the last colors of a greedy
+              // coloring, are split more finely so that every thread gets
+              // at least two ranges to work on
+              const unsigned int grain_size = std::max<std::size_t>(
+                1,
+                std::min<std::size_t>(chunk_size,
+                                      colored_iterators[color].size() /
+                                        (2 * MultithreadInfo::n_threads())));
 
               parallel::internal::parallel_for(
                 colored_iterators[color].begin(),
@@ -1056,7 +1171,7 @@ namespace WorkStream
                     typename std::vector<Iterator>::const_iterator> &range) {
                   worker_and_copier(range);
                 },
-                chunk_size);
+                grain_size);
             }
       }
 
@@ -1095,7 +1210,9 @@ namespace WorkStream
    * The @p queue_length argument indicates the number of items that can be
    * live at any given time. Each item consists of @p chunk_size elements of
    * the input stream that will be worked on by the worker and copier
-   * functions one after the other on the same thread.
+   * functions one after the other on the same thread. For colors with few
+   * elements compared to the number of threads, the items are made smaller
+   * than @p chunk_size so that all threads get work.
    *
    * @note If your data objects are large, or their constructors are
    * expensive, it is helpful to keep in mind that <tt>queue_length</tt>
@@ -1157,9 +1274,11 @@ namespace WorkStream
    * from the <tt>worker</tt> to the <tt>copier</tt>.
    *
    * The @p queue_length argument indicates the number of items that can be
-   * live at any given time. Each item consists of @p chunk_size elements of
-   * the input stream that will be worked on by the worker and copier
-   * functions one after the other on the same thread.
+   * live at any given time. Each item consists of at most @p chunk_size
+   * elements of the input stream that will be worked on by the worker and
+   * copier functions one after the other on the same thread. Towards the end
+   * of the input stream, the items are made smaller so that the remaining
+   * elements are spread over as many threads as possible.
    *
    * @note If your data objects are large, or their constructors are
    * expensive, it is helpful to keep in mind that <tt>queue_length</tt>
@@ -1396,9 +1515,11 @@ namespace WorkStream
    * DoFHandler::raw_cell_iterator.
    *
    * The @p queue_length argument indicates the number of items that can be
-   * live at any given time. Each item consists of @p chunk_size elements of
-   * the input stream that will be worked on by the worker and copier
-   * functions one after the other on the same thread.
+   * live at any given time. Each item consists of at most @p chunk_size
+   * elements of the input stream that will be worked on by the worker and
+   * copier functions one after the other on the same thread. Towards the end
+   * of the input stream, the items are made smaller so that the remaining
+   * elements are spread over as many threads as possible.
    *
    * @note If your data objects are large, or their constructors are
    * expensive, it is helpful to keep in mind that <tt>queue_length</tt>
@@ -19,6 +19,7 @@
 #include <deal.II/grid/tria.h>
 
 #include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/sparsity_tools.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -173,6 +174,112 @@ namespace RepartitioningPolicyTools
       weighting_function;
   };
 
+  /**
+   * A policy that partitions the graph of the active cells, in which two
+   * cells are connected if they share a face, with a graph partitioner. In
+   * contrast to the other policies, which only balance the number of cells
+   * or their weights, this policy also tries to minimize the number of faces
+   * between cells on different processes, i.e., the size of the interfaces
+   * between the subdomains and, with it, the number of ghost cells and the
+   * volume of the communication in halo exchanges. This is useful if the
+   * partition of the given triangulation, e.g., one along a space-filling
+   * curve, leads to subdomains with ragged boundaries.
+   *
+   * By default, the multilevel graph partitioner built into deal.II is used
+   * (see SparsityTools::Partitioner::multilevel), but METIS or ZOLTAN can be
+   * selected as well if deal.II has been configured with them.
+   *
+   * The graph is collected and partitioned on the process with rank zero,
+   * so memory and time on that process grow with the size of the graph. To
+   * reduce them, each process can first combine up to
+   * @p max_cells_per_graph_vertex connected locally owned cells into a
+   * single vertex of the graph (weighted by the total weight of its cells),
+   * which shrinks the graph collected on rank zero by about that factor.
+   * The cells of a vertex are then moved together, so the balance of the
+   * weights and the size of the interfaces are only controlled on the level
+   * of these groups of cells.
+   *
+   * @note Even with groups of cells, the size of the graph on rank zero
+   *   grows linearly with the global number of active cells, so this policy
+   *   is meant for meshes whose coarsened graph fits into the memory of a
+   *   single process, not for the largest process counts.
+   */
+  template <int dim, int spacedim = dim>
+  class GraphPartitioningPolicy : public Base<dim, spacedim>
+  {
+  public:
+    /**
+     * Constructor taking the graph partitioner to be used and the maximal
+     * number of cells combined into a vertex of the graph. All cells have
+     * the same weight.
+     */
+    GraphPartitioningPolicy(const SparsityTools::Partitioner partitioner =
+                              SparsityTools::Partitioner::multilevel,
+                            const unsigned int max_cells_per_graph_vertex = 1);
+
+    /**
+     * Constructor taking a function that gives a weight to each cell, the
+     * graph partitioner to be used, and the maximal number of cells combined
+     * into a vertex of the graph. The partitioner tries to distribute the
+     * weights equally among the processes.
+     */
+    GraphPartitioningPolicy(
+      const std::function<unsigned int(
+        const typename Triangulation<dim, spacedim>::cell_iterator &,
+        const typename Triangulation<dim, spacedim>::CellStatus)>
+        &                              weighting_function,
+      const SparsityTools::Partitioner partitioner =
+        SparsityTools::Partitioner::multilevel,
+      const unsigned int max_cells_per_graph_vertex = 1);
+
+    virtual LinearAlgebra::distributed::Vector<double>
+    partition(const Triangulation<dim, spacedim> &tria_in) const override;
+
+  private:
+    /**
+     * The graph partitioner.
+     */
+    const SparsityTools::Partitioner partitioner;
+
+    /**
+     * The maximal number of locally owned cells combined into a vertex of
+     * the graph.
+     */
+    const unsigned int max_cells_per_graph_vertex;
+
+    /**
+     * A function that gives a weight to each cell, or an empty function if
+     * all cells have the same weight.
+     */
+    const std::function<
+      unsigned int(const typename Triangulation<dim, spacedim>::cell_iterator &,
+                   const typename Triangulation<dim, spacedim>::CellStatus)>
+      weighting_function;
+  };
+
+  /**
+   * Return the number of ghost cells each process would have if the active
+   * cells of @p tria were distributed among the processes according to
+   * @p partition, which is a vector as returned by Base::partition(). An
+   * empty @p partition is interpreted as the current partition of @p tria,
+   * as done by DefaultPolicy. The ghost cells of a process are the cells
+   * owned by other processes that share at least a vertex with one of its
+   * locally owned cells.
+   *
+   * This function can be used to compare the quality of the partitions
+   * produced by different policies, since the number of ghost cells is a
+   * measure of the amount of data to be exchanged with the neighboring
+   * processes.
+   *
+   * @note This is a collective operation, which returns the numbers of all
+   *   processes on every process.
+   */
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  compute_n_ghost_cells(
+    const Triangulation<dim, spacedim> &              tria,
+    const LinearAlgebra::distributed::Vector<double> &partition);
+
 } // namespace RepartitioningPolicyTools
 
 DEAL_II_NAMESPACE_CLOSE
@@ -27,9 +27,11 @@
 
 #include <deal.II/grid/tria.h>
 
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <set>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -470,6 +472,14 @@ namespace parallel
      * system. See the SolutionTransfer class on how to store solution vectors
      * into this file. Additional cell-based data can be saved using
      * register_data_attach().
+     *
+     * The data attached to the cells is written with collective MPI-IO calls
+     * exactly as returned by the callbacks, i.e., it is not compressed any
+     * further. Callbacks whose data compresses well can do so themselves,
+     * e.g., by packing it with Utilities::pack(). The function only returns
+     * once all data has been written; there is no asynchronous variant that
+     * would let the computation continue while the data is flushed to the
+     * file system.
      */
     virtual void
     save(const std::string &filename) const = 0;
@@ -662,6 +672,49 @@ namespace parallel
              const boost::iterator_range<std::vector<char>::const_iterator> &)>
         &unpack_callback);
 
+    /**
+     * Enable or disable differential checkpoints of the fixed size data
+     * attached to cells via register_data_attach().
+     *
+     * By default, every call to save() writes all data attached to the
+     * cells. For long transient computations in which only a part of this
+     * data changes between two checkpoints, this is wasteful. If
+     * differential checkpoints are enabled, the first call to save() writes
+     * a complete checkpoint as usual (the <i>base</i> checkpoint) and
+     * remembers a hash of every chunk of @p chunk_size bytes of the fixed
+     * size data on the current process. Subsequent calls to save() then
+     * only write those chunks whose hash differs from the one in the base
+     * checkpoint, along with the name of the base checkpoint, into a file
+     * with the suffix <tt>_fixed.delta</tt>. The load() function recognizes
+     * such a checkpoint and reconstructs the data from the base checkpoint
+     * and the changed chunks. Consequently, the files of a base checkpoint
+     * must not be removed as long as differential checkpoints refer to it.
+     * The name of the base checkpoint is stored relative to the directory of
+     * the differential checkpoint, so that the checkpoints can be loaded
+     * from a different working directory or after moving the directory that
+     * contains them. If the relative name cannot be determined from the two
+     * file names passed to save(), e.g., because only one of them is an
+     * absolute path, a new base checkpoint is written. A differential
+     * checkpoint also stores a hash of the data of the base checkpoint on
+     * each process, and load() throws an exception if the base checkpoint
+     * has been overwritten since.
+     *
+     * A new base checkpoint is written whenever the layout of the fixed size
+     * data on any process differs from the one of the base checkpoint, e.g.,
+     * because the mesh has been refined or repartitioned, or because a
+     * different set of data has been attached. Calling this function also
+     * discards the current base checkpoint, i.e., the next call to save()
+     * writes a complete checkpoint. Data of variable size is always written
+     * completely.
+     *
+     * @note Differential checkpoints can only be loaded on the same number
+     *   of processes and with the same partition of the cells they were
+     *   written with.
+     */
+    void
+    set_differential_checkpoints(const bool         enable,
+                                 const unsigned int chunk_size = 4096);
+
   protected:
     /**
      * Save additional cell-attached data into the given file. The first
@@ -817,18 +870,27 @@ namespace parallel
        * The data will be written in a separate file, whose name
        * consists of the stem @p filename and an attached identifier
        * <tt>_fixed.data</tt> for fixed size data and <tt>_variable.data</tt>
-       * for variable size data.
+       * for variable size data. If differential checkpoints are enabled via
+       * set_checkpoint_chunk_size() and a base checkpoint with the same
+       * layout of the fixed size data exists, only the chunks of the fixed
+       * size data that changed since the base checkpoint are written into a
+       * file with the identifier <tt>_fixed.delta</tt> instead.
        *
-       * All processors write into these files simultaneously via MPIIO.
-       * Each processor's position to write to will be determined
-       * from the provided input parameters.
+       * All processors write into these files simultaneously via
+       * collective MPIIO calls. Each processor's position to write to will
+       * be determined from the provided input parameters. The collective
+       * calls allow the MPI implementation to gather the data of many
+       * processors on a few aggregators before writing it to the file
+       * system, which we explicitly request via the hint
+       * <tt>romio_cb_write</tt>. On parallel file systems, this is much
+       * faster than many small independent writes.
        *
        * Data has to be previously packed with pack_data().
        */
       void
       save(const unsigned int global_first_cell,
            const unsigned int global_num_cells,
-           const std::string &filename) const;
+           const std::string &filename);
 
       /**
        * Transfer data from file system.
@@ -836,14 +898,17 @@ namespace parallel
        * The data will be read from separate file, whose name
        * consists of the stem @p filename and an attached identifier
        * <tt>_fixed.data</tt> for fixed size data and <tt>_variable.data</tt>
-       * for variable size data.
+       * for variable size data. If a differential checkpoint has been
+       * written under the name @p filename, the fixed size data is read from
+       * its base checkpoint and the chunks stored in the file with the
+       * identifier <tt>_fixed.delta</tt> are applied on top.
        * The @p n_attached_deserialize_fixed and @p n_attached_deserialize_variable
        * parameters are required to gather the memory offsets for each
        * callback.
        *
-       * All processors read from these files simultaneously via MPIIO.
-       * Each processor's position to read from will be determined
-       * from the provided input arguments.
+       * All processors read from these files simultaneously via collective
+       * MPIIO calls, see save(). Each processor's position to read from will
+       * be determined from the provided input arguments.
        *
        * After loading, unpack_data() needs to be called to finally
        * distribute data across the associated triangulation.
@@ -865,6 +930,14 @@ namespace parallel
       void
       clear();
 
+      /**
+       * Set the size of the chunks in bytes in which the fixed size data is
+       * compared against the base checkpoint by save(), where zero disables
+       * differential checkpoints, and discard the current base checkpoint.
+       */
+      void
+      set_checkpoint_chunk_size(const unsigned int chunk_size);
+
       /**
        * Flag that denotes if variable size data has been packed.
        */
@@ -900,6 +973,24 @@ namespace parallel
 
     private:
       MPI_Comm mpi_communicator;
+
+      /**
+       * Size of the chunks of the fixed size data for differential
+       * checkpoints in bytes, or zero if differential checkpoints are
+       * disabled.
+       */
+      unsigned int checkpoint_chunk_size;
+
+      /**
+       * File name of the base checkpoint that differential checkpoints refer
+       * to, or an empty string if there is none. The contents of the
+       * checkpoint are described by the layout of the fixed size data on the
+       * current process, i.e., its position in the file, its size and
+       * sizes_fixed_cumulative, and the hash of each of its chunks.
+       */
+      std::string                base_checkpoint_filename;
+      std::vector<unsigned int>  base_checkpoint_layout;
+      std::vector<std::uint64_t> base_checkpoint_hashes;
     };
 
     DataTransfer data_transfer;
@@ -280,6 +280,25 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * When a triangulation is refined isotropically,
+ * Triangulation::execute_coarsening_and_refinement() computes the locations
+ * of the new vertices of many lines, quads, and hexes concurrently on
+ * several threads. The same manifold object may then be asked for new
+ * points from several threads at the same time, i.e., get_new_point(),
+ * get_new_points(), project_to_manifold(), and, for ChartManifold, the
+ * functions pull_back() and push_forward() must be safe to call
+ * concurrently. This is the case as long as these functions only read the
+ * state of the object. Derived classes that modify internal data in these
+ * functions, e.g., a cache of previously computed points, or that call into
+ * a library that is not reentrant, must protect this data by a mutex. As an
+ * alternative, such a class can overload supports_concurrent_calls() to
+ * return false, in which case the triangulation places all new vertices on
+ * the calling thread as long as the manifold is attached to it. Limiting the
+ * number of threads to one with MultithreadInfo::set_thread_limit() has the
+ * same effect for all manifolds.
+ *
  * @ingroup manifold
  */
 template <int dim, int spacedim = dim>
@@ -321,6 +340,17 @@ public:
   virtual std::unique_ptr<Manifold<dim, spacedim>>
   clone() const = 0;
 
+  /**
+   * Return whether the functions of this class that compute new points may
+   * be called concurrently from several threads, see the section on thread
+   * safety in the general documentation of this class. The default
+   * implementation returns true. Derived classes whose implementation of
+   * these functions is not thread safe should overload this function to
+   * return false.
+   */
+  virtual bool
+  supports_concurrent_calls() const;
+
   /**
    * @name Computing the location of points.
    */
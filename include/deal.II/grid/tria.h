@@ -1953,7 +1953,9 @@ public:
    * not create such an exception if no cells have created distorted children.
    * Note that for the check for distorted cells to happen, the
    * <code>check_for_distorted_cells</code> flag has to be specified upon
-   * creation of a triangulation object.
+   * creation of a triangulation object. Only the children of quadrilaterals
+   * and hexahedra are checked; children of simplex, wedge, and pyramid cells
+   * are never reported as distorted.
    *
    * See the general docs for more information.
    *
@@ -1966,6 +1968,12 @@ public:
    * distorted (see the extensive discussion on
    * @ref GlossDistorted "distorted cells").
    *
+   * @note For isotropic refinement, the locations of the new vertices on the
+   * manifolds are computed on several threads at once, unless one of the
+   * manifolds attached to the triangulation returns false from
+   * Manifold::supports_concurrent_calls(). See the section on thread safety
+   * in the documentation of the Manifold class.
+   *
    * @note This function is <tt>virtual</tt> to allow derived classes to
    * insert hooks, such as saving refinement flags and the like (see e.g. the
    * PersistentTriangulation class).
@@ -3340,6 +3348,16 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Print a breakdown of memory_consumption() to @p out. For the data stored
+   * for the cells, the memory used by each field is listed, summed over all
+   * levels, followed by the memory used for the vertices and the faces, and
+   * by everything else. This allows to find out which parts of the data
+   * structures dominate the memory consumption of large meshes.
+   */
+  void
+  print_memory_consumption(std::ostream &out) const;
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization using the [BOOST serialization
@@ -4258,9 +4276,9 @@ Triangulation<dim, spacedim>::load(Archive &ar, const unsigned int)
   {
     for (auto &level : levels)
       {
-        level->active_cell_indices.resize(level->refine_flags.size());
-        level->global_active_cell_indices.resize(level->refine_flags.size());
-        level->global_level_cell_indices.resize(level->refine_flags.size());
+        level->active_cell_indices.resize(level->cell_flags.size());
+        level->global_active_cell_indices.resize(level->cell_flags.size());
+        level->global_level_cell_indices.resize(level->cell_flags.size());
       }
     reset_cell_vertex_indices_cache();
     reset_active_cell_indices();
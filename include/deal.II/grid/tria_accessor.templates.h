@@ -3358,9 +3358,8 @@ CellAccessor<dim, spacedim>::neighbor_index(const unsigned int face_no) const
 {
   AssertIndexRange(face_no, this->n_faces());
   return this->tria->levels[this->present_level]
-    ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell +
-                face_no]
-    .second;
+    ->neighbor_indices[this->present_index * GeometryInfo<dim>::faces_per_cell +
+                       face_no];
 }
 
 
@@ -3370,10 +3369,8 @@ inline int
 CellAccessor<dim, spacedim>::neighbor_level(const unsigned int face_no) const
 {
   AssertIndexRange(face_no, this->n_faces());
-  return this->tria->levels[this->present_level]
-    ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell +
-                face_no]
-    .first;
+  return this->tria->levels[this->present_level]->neighbor_level(
+    this->present_index * GeometryInfo<dim>::faces_per_cell + face_no);
 }
 
 
@@ -3389,10 +3386,10 @@ CellAccessor<dim, spacedim>::refine_flag_set() const
   // executed and for some reason the refine
   // flag is not cleared).
   Assert(this->is_active() || !this->tria->levels[this->present_level]
-                                 ->refine_flags[this->present_index],
+                                 ->refine_flag(this->present_index),
          ExcRefineCellNotActive());
   return RefinementCase<dim>(
-    this->tria->levels[this->present_level]->refine_flags[this->present_index]);
+    this->tria->levels[this->present_level]->refine_flag(this->present_index));
 }
 
 
@@ -3405,8 +3402,8 @@ CellAccessor<dim, spacedim>::set_refine_flag(
   Assert(this->used() && this->is_active(), ExcRefineCellNotActive());
   Assert(!coarsen_flag_set(), ExcCellFlaggedForCoarsening());
 
-  this->tria->levels[this->present_level]->refine_flags[this->present_index] =
-    refinement_case;
+  this->tria->levels[this->present_level]->set_refine_flag(this->present_index,
+                                                          refinement_case);
 }
 
 
@@ -3416,8 +3413,8 @@ inline void
 CellAccessor<dim, spacedim>::clear_refine_flag() const
 {
   Assert(this->used() && this->is_active(), ExcRefineCellNotActive());
-  this->tria->levels[this->present_level]->refine_flags[this->present_index] =
-    RefinementCase<dim>::no_refinement;
+  this->tria->levels[this->present_level]->set_refine_flag(
+    this->present_index, RefinementCase<dim>::no_refinement);
 }
 
 
@@ -3613,10 +3610,10 @@ CellAccessor<dim, spacedim>::coarsen_flag_set() const
   // executed and for some reason the refine
   // flag is not cleared).
   Assert(this->is_active() || !this->tria->levels[this->present_level]
-                                 ->coarsen_flags[this->present_index],
+                                 ->coarsen_flag(this->present_index),
          ExcRefineCellNotActive());
-  return this->tria->levels[this->present_level]
-    ->coarsen_flags[this->present_index];
+  return this->tria->levels[this->present_level]->coarsen_flag(
+    this->present_index);
 }
 
 
@@ -3628,8 +3625,8 @@ CellAccessor<dim, spacedim>::set_coarsen_flag() const
   Assert(this->used() && this->is_active(), ExcRefineCellNotActive());
   Assert(!refine_flag_set(), ExcCellFlaggedForRefinement());
 
-  this->tria->levels[this->present_level]->coarsen_flags[this->present_index] =
-    true;
+  this->tria->levels[this->present_level]->set_coarsen_flag(this->present_index,
+                                                           true);
 }
 
 
@@ -3639,8 +3636,8 @@ inline void
 CellAccessor<dim, spacedim>::clear_coarsen_flag() const
 {
   Assert(this->used() && this->is_active(), ExcRefineCellNotActive());
-  this->tria->levels[this->present_level]->coarsen_flags[this->present_index] =
-    false;
+  this->tria->levels[this->present_level]->set_coarsen_flag(this->present_index,
+                                                           false);
 }
 
 
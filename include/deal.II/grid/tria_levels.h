@@ -19,14 +19,18 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 
 #include <deal.II/grid/reference_cell.h>
 #include <deal.II/grid/tria_objects.h>
 
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/utility.hpp>
 
 #include <cstdint>
+#include <string>
+#include <utility>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -79,21 +83,115 @@ namespace internal
       unsigned int dim;
 
       /**
-       * @p RefinementCase<dim>::Type flags for the cells to be refined with
-       * or not (RefinementCase<dim>::no_refinement). The meaning what a cell
-       * is, is dimension specific, therefore also the length of this vector
-       * depends on the dimension: in one dimension, the length of this vector
-       * equals the length of the @p lines vector, in two dimensions that of
-       * the @p quads vector, etc.
+       * The flags of the cells, one byte per cell. The bits selected by
+       * #refine_case_mask store the @p RefinementCase<dim>::Type with which
+       * the cell is to be refined, or RefinementCase<dim>::no_refinement. The
+       * bit #coarsen_flag_bit stores whether the cell is to be coarsened, and
+       * the bit #direction_flag_bit stores the direction flag of the cell
+       * (see @ref GlossDirectionFlag), which is only used for codim==1
+       * meshes. The meaning what a cell is, is dimension specific, therefore
+       * also the length of this vector depends on the dimension: in one
+       * dimension, the length of this vector equals the length of the
+       * @p lines vector, in two dimensions that of the @p quads vector, etc.
+       *
+       * Keeping the flags of a cell in one byte, rather than in separate
+       * vectors of which some are a std::vector<bool>, lets the accessors
+       * read all flags of a cell from one memory location. It also allows
+       * to set the flags of different cells from different threads.
+       *
+       * Use the functions refine_flag(), coarsen_flag(), direction_flag(),
+       * and the corresponding set functions to access the individual flags.
        */
-      std::vector<std::uint8_t> refine_flags;
+      std::vector<std::uint8_t> cell_flags;
 
       /**
-       * Same meaning as the one above, but specifies whether a cell must be
-       * coarsened.
+       * The bits of #cell_flags that store the refinement case.
        */
-      std::vector<bool> coarsen_flags;
+      static constexpr std::uint8_t refine_case_mask = 0x07;
 
+      /**
+       * The bit of #cell_flags that stores the coarsen flag.
+       */
+      static constexpr std::uint8_t coarsen_flag_bit = 0x08;
+
+      /**
+       * The bit of #cell_flags that stores the direction flag.
+       */
+      static constexpr std::uint8_t direction_flag_bit = 0x10;
+
+      /**
+       * The value of #cell_flags for a newly created cell: not flagged for
+       * refinement or coarsening, and with a direction flag that is true.
+       */
+      static constexpr std::uint8_t default_cell_flags = direction_flag_bit;
+
+      /**
+       * Whether the direction flags stored in #cell_flags are used, which is
+       * the case for codim==1 meshes. Only then are the direction flags
+       * written to an archive by save().
+       */
+      bool direction_flags_used = false;
+
+      /**
+       * Return the refinement case the cell with index @p i is flagged for.
+       */
+      std::uint8_t
+      refine_flag(const std::size_t i) const
+      {
+        return cell_flags[i] & refine_case_mask;
+      }
+
+      /**
+       * Set the refinement case the cell with index @p i is flagged for.
+       */
+      void
+      set_refine_flag(const std::size_t i, const std::uint8_t refinement_case)
+      {
+        Assert((refinement_case & ~refine_case_mask) == 0, ExcInternalError());
+        cell_flags[i] = (cell_flags[i] & ~refine_case_mask) | refinement_case;
+      }
+
+      /**
+       * Return whether the cell with index @p i is flagged for coarsening.
+       */
+      bool
+      coarsen_flag(const std::size_t i) const
+      {
+        return (cell_flags[i] & coarsen_flag_bit) != 0;
+      }
+
+      /**
+       * Set whether the cell with index @p i is flagged for coarsening.
+       */
+      void
+      set_coarsen_flag(const std::size_t i, const bool flag)
+      {
+        if (flag)
+          cell_flags[i] |= coarsen_flag_bit;
+        else
+          cell_flags[i] &= ~coarsen_flag_bit;
+      }
+
+      /**
+       * Return the direction flag of the cell with index @p i.
+       */
+      bool
+      direction_flag(const std::size_t i) const
+      {
+        return (cell_flags[i] & direction_flag_bit) != 0;
+      }
+
+      /**
+       * Set the direction flag of the cell with index @p i.
+       */
+      void
+      set_direction_flag(const std::size_t i, const bool flag)
+      {
+        if (flag)
+          cell_flags[i] |= direction_flag_bit;
+        else
+          cell_flags[i] &= ~direction_flag_bit;
+      }
 
       /**
        * An integer that, for every active cell, stores the how many-th active
@@ -113,19 +211,17 @@ namespace internal
       std::vector<types::global_cell_index> global_level_cell_indices;
 
       /**
-       * Levels and indices of the neighbors of the cells. Convention is, that
-       * the neighbors of the cell with index @p i are stored in the fields
+       * Indices of the neighbors of the cells. Convention is, that the
+       * neighbors of the cell with index @p i are stored in the fields
        * following $i*(2*real\_space\_dimension)$, e.g. in one spatial
        * dimension, the neighbors of cell 0 are stored in
-       * <tt>neighbors[0]</tt> and <tt>neighbors[1]</tt>, the neighbors of
-       * cell 1 are stored in <tt>neighbors[2]</tt> and <tt>neighbors[3]</tt>,
-       * and so on.
-       *
-       * In neighbors, <tt>neighbors[i].first</tt> is the level, while
-       * <tt>neighbors[i].second</tt> is the index of the neighbor.
+       * <tt>neighbor_indices[0]</tt> and <tt>neighbor_indices[1]</tt>, the
+       * neighbors of cell 1 are stored in <tt>neighbor_indices[2]</tt> and
+       * <tt>neighbor_indices[3]</tt>, and so on. The levels of the neighbors
+       * are stored in the same positions of #neighbor_levels.
        *
        * If a neighbor does not exist (cell is at the boundary),
-       * <tt>level=index=-1</tt> is set.
+       * <tt>index=-1</tt> is set.
        *
        * <em>Conventions:</em> The @p ith neighbor of a cell is the one which
        * shares the @p ith face (@p Line in 2D, @p Quad in 3D) of this cell.
@@ -145,7 +241,49 @@ namespace internal
        * level down (in which case its neighbor pointer points to the mother
        * cell of this cell).
        */
-      std::vector<std::pair<int, int>> neighbors;
+      std::vector<int> neighbor_indices;
+
+      /**
+       * Levels of the neighbors of the cells, in the same order as
+       * #neighbor_indices. In order to keep the neighbor information of a
+       * cell small, the level is stored plus one in two bytes, so that the
+       * value zero denotes a neighbor that does not exist. Use
+       * neighbor_level() to read the level of a neighbor.
+       */
+      std::vector<std::uint16_t> neighbor_levels;
+
+      /**
+       * The largest level a neighbor can have in the encoding used in
+       * #neighbor_levels. This is far beyond the number of levels that can
+       * be represented by the coordinates of the vertices in double
+       * precision, so it does not restrict the triangulation in practice.
+       */
+      static constexpr int max_neighbor_level = 65534;
+
+      /**
+       * Return the level of the neighbor stored at position @p i of
+       * #neighbor_levels, or -1 if there is no neighbor.
+       */
+      int
+      neighbor_level(const std::size_t i) const
+      {
+        return static_cast<int>(neighbor_levels[i]) - 1;
+      }
+
+      /**
+       * Set the level and index of the neighbor stored at position @p i of
+       * #neighbor_indices and #neighbor_levels. A level or index of -1
+       * denotes a neighbor that does not exist.
+       */
+      void
+      set_neighbor(const std::size_t i, const int level, const int index)
+      {
+        Assert(level >= -1 && level <= max_neighbor_level,
+               ExcMessage("The level of a neighbor must not exceed " +
+                          std::to_string(max_neighbor_level) + "."));
+        neighbor_indices[i] = (level == -1 ? -1 : index);
+        neighbor_levels[i]  = static_cast<std::uint16_t>(level + 1);
+      }
 
       /**
        * One integer per cell to store which subdomain it belongs to. This
@@ -177,15 +315,6 @@ namespace internal
        */
       std::vector<int> parents;
 
-      /**
-       * One bool per cell to indicate the direction of the normal true:  use
-       * orientation from vertex false: revert the orientation. See
-       * @ref GlossDirectionFlag.
-       *
-       * This is only used for codim==1 meshes.
-       */
-      std::vector<bool> direction_flags;
-
       /**
        * The object containing the data on lines and related functions
        */
@@ -239,6 +368,33 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Return an estimate for the memory consumption (in bytes) of each of
+       * the fields of this object, together with the name of the field. The
+       * sum of all entries equals memory_consumption().
+       */
+      std::vector<std::pair<std::string, std::size_t>>
+      memory_consumption_per_field() const;
+
+      /**
+       * Write the data of this object to a stream for the purpose of
+       * serialization using the [BOOST serialization
+       * library](https://www.boost.org/doc/libs/1_74_0/libs/serialization/doc/index.html).
+       */
+      template <class Archive>
+      void
+      save(Archive &ar, const unsigned int version) const;
+
+      /**
+       * Read the data of this object from a stream for the purpose of
+       * serialization using the [BOOST serialization
+       * library](https://www.boost.org/doc/libs/1_74_0/libs/serialization/doc/index.html).
+       */
+      template <class Archive>
+      void
+      load(Archive &ar, const unsigned int version);
+
+#ifdef DOXYGEN
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization using the [BOOST serialization
@@ -246,27 +402,96 @@ namespace internal
        */
       template <class Archive>
       void
-      serialize(Archive &ar, const unsigned int version);
+      serialize(Archive &archive, const unsigned int version);
+#else
+      // This macro defines the serialize() method that is compatible with
+      // the templated save() and load() method that have been implemented.
+      BOOST_SERIALIZATION_SPLIT_MEMBER()
+#endif
     };
 
 
     template <class Archive>
     void
-    TriaLevel::serialize(Archive &ar, const unsigned int)
+    TriaLevel::save(Archive &ar, const unsigned int) const
     {
       ar &dim;
 
+      // write the flags as separate vectors, which keeps the format of the
+      // archive independent of the packed storage
+      std::vector<std::uint8_t> refine_flags(cell_flags.size());
+      std::vector<bool>         coarsen_flags(cell_flags.size());
+      std::vector<bool>         direction_flags;
+      if (direction_flags_used)
+        direction_flags.resize(cell_flags.size());
+      for (std::size_t i = 0; i < cell_flags.size(); ++i)
+        {
+          refine_flags[i]  = refine_flag(i);
+          coarsen_flags[i] = coarsen_flag(i);
+          if (direction_flags_used)
+            direction_flags[i] = direction_flag(i);
+        }
       ar &refine_flags &coarsen_flags;
 
       // do not serialize `active_cell_indices` and `vertex_indices_cache`
       // here. instead of storing them to the stream and re-reading them again
       // later, we just rebuild them in Triangulation::load()
 
+      // write the neighbors as pairs of level and index, which keeps the
+      // format of the archive independent of the compact storage
+      std::vector<std::pair<int, int>> neighbors(neighbor_indices.size());
+      for (std::size_t i = 0; i < neighbors.size(); ++i)
+        neighbors[i] = {neighbor_level(i), neighbor_indices[i]};
+      ar &neighbors;
+
+      ar &subdomain_ids;
+      ar &level_subdomain_ids;
+      ar &parents;
+      ar &direction_flags;
+      ar &cells;
+      ar &face_orientations;
+      ar &reference_cell;
+    }
+
+
+
+    template <class Archive>
+    void
+    TriaLevel::load(Archive &ar, const unsigned int)
+    {
+      ar &dim;
+
+      std::vector<std::uint8_t> refine_flags;
+      std::vector<bool>         coarsen_flags;
+      ar &refine_flags &coarsen_flags;
+
+      std::vector<std::pair<int, int>> neighbors;
       ar &neighbors;
+      neighbor_indices.resize(neighbors.size());
+      neighbor_levels.resize(neighbors.size());
+      for (std::size_t i = 0; i < neighbors.size(); ++i)
+        set_neighbor(i, neighbors[i].first, neighbors[i].second);
+
       ar &subdomain_ids;
       ar &level_subdomain_ids;
       ar &parents;
+
+      std::vector<bool> direction_flags;
       ar &direction_flags;
+      direction_flags_used = !direction_flags.empty();
+      AssertDimension(coarsen_flags.size(), refine_flags.size());
+      Assert(!direction_flags_used ||
+               direction_flags.size() == refine_flags.size(),
+             ExcDimensionMismatch(direction_flags.size(), refine_flags.size()));
+      cell_flags.assign(refine_flags.size(), default_cell_flags);
+      for (std::size_t i = 0; i < cell_flags.size(); ++i)
+        {
+          set_refine_flag(i, refine_flags[i]);
+          set_coarsen_flag(i, coarsen_flags[i]);
+          if (direction_flags_used)
+            set_direction_flag(i, direction_flags[i]);
+        }
+
       ar &cells;
       ar &face_orientations;
       ar &reference_cell;
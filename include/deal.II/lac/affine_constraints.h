@@ -20,6 +20,7 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/index_set.h>
+#include <deal.II/base/memory_space.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
@@ -51,6 +52,15 @@ class SparseMatrix;
 template <typename number>
 class BlockSparseMatrix;
 
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename Number, typename MemorySpace>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+
 namespace internal
 {
   namespace AffineConstraints
@@ -1578,6 +1588,62 @@ public:
   void
   distribute(VectorType &vec) const;
 
+  /**
+   * Same as above for LinearAlgebra::distributed::Vector. This function
+   * overlaps the import of the values from other processes with the work on
+   * the constraints that only involve locally owned entries, by calling
+   * distribute_start() and distribute_finish() with a temporary vector.
+   */
+  template <typename VectorNumber>
+  void
+  distribute(
+    LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec)
+    const;
+
+  /**
+   * Start the split-phase version of distribute() for a
+   * LinearAlgebra::distributed::Vector @p vec. This function begins the
+   * import of the vector entries owned by other processes that some of the
+   * locally owned constrained degrees of freedom depend on, and meanwhile
+   * sets all locally owned constrained entries that only depend on locally
+   * owned entries. The remaining entries are set by distribute_finish(),
+   * which must be called with the same arguments before the vector is used
+   * again. Work that does not touch @p vec and @p ghosted_vector can be
+   * scheduled between the two calls to hide the latency of the
+   * communication.
+   *
+   * The vector @p ghosted_vector holds the imported values. If it is empty,
+   * i.e., has size zero, it is set up with the appropriate ghost entries in
+   * this call, which requires global communication. Otherwise, it must have
+   * been set up by a previous call to this function for the same
+   * constraints and a vector with the same parallel layout, in which case
+   * the setup is skipped. This allows to keep @p ghosted_vector around for
+   * repeated calls, e.g., in every iteration of a solver. Since all
+   * processes must make the same decision, pass an empty vector on all
+   * processes whenever the constraints or the layout of @p vec change.
+   *
+   * @note As for distribute(), the vector @p vec must not contain ghost
+   * elements.
+   */
+  template <typename VectorNumber>
+  void
+  distribute_start(
+    LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec,
+    LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host>
+      &ghosted_vector) const;
+
+  /**
+   * Finish the split-phase version of distribute() started by
+   * distribute_start(), setting the locally owned constrained entries of
+   * @p vec that depend on entries owned by other processes.
+   */
+  template <typename VectorNumber>
+  void
+  distribute_finish(
+    LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec,
+    LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host>
+      &ghosted_vector) const;
+
   /**
    * @}
    */
@@ -21,6 +21,7 @@
 #include <deal.II/base/cuda_size.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi_compute_index_owner_internal.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/thread_local_storage.h>
 
@@ -54,6 +55,7 @@
 
 #include <algorithm>
 #include <complex>
+#include <cstdint>
 #include <iomanip>
 #include <numeric>
 #include <ostream>
@@ -62,6 +64,21 @@
 DEAL_II_NAMESPACE_OPEN
 
 
+namespace internal
+{
+  namespace AffineConstraints
+  {
+    /**
+     * The number of constraint lines that close(), merge(), and distribute()
+     * hand to a single task when working on the lines in parallel. Each line
+     * typically only has a handful of entries, so the chunks need to be
+     * large enough to make up for the overhead of spawning tasks.
+     */
+    constexpr unsigned int n_lines_per_task = 512;
+  } // namespace AffineConstraints
+} // namespace internal
+
+
 
 template <typename number>
 bool
@@ -655,8 +672,14 @@ AffineConstraints<number>::close()
   if (sorted == true)
     return;
 
-  // sort the lines
-  std::sort(lines.begin(), lines.end());
+  // make sure the index set is compressed before it is queried from several
+  // threads below
+  local_lines.compress();
+
+  // sort the lines. they are often added in ascending order already, which
+  // is cheap to check
+  if (!std::is_sorted(lines.begin(), lines.end()))
+    std::sort(lines.begin(), lines.end());
 
   // update list of pointers and give the vector a sharp size since we
   // won't modify the size any more after this point.
@@ -678,18 +701,53 @@ AffineConstraints<number>::close()
       Assert(i == calculate_line_index(lines[lines_cache[i]].index),
              ExcInternalError());
 
-  // first, strip zero entries, as we have to do that only once
-  for (ConstraintLine &line : lines)
-    // first remove zero entries. that would mean that in the linear
-    // constraint for a node, x_i = ax_1 + bx_2 + ..., another node times 0
-    // appears. obviously, 0*something can be omitted
-    line.entries.erase(std::remove_if(line.entries.begin(),
-                                      line.entries.end(),
-                                      [](
-                                        const std::pair<size_type, number> &p) {
-                                        return p.second == number(0.);
-                                      }),
-                       line.entries.end());
+  // an entry of a line needs to be resolved if it refers to a dof that is
+  // itself constrained. ignore elements that we don't store on the current
+  // processor
+  const auto is_chained_entry = [&](const size_type dof_index) {
+    return ((local_lines.size() == 0) || (local_lines.is_element(dof_index))) &&
+           is_constrained(dof_index);
+  };
+
+  // first, strip zero entries, as we have to do that only once. that would
+  // mean that in the linear constraint for a node, x_i = ax_1 + bx_2 + ...,
+  // another node times 0 appears. obviously, 0*something can be omitted.
+  //
+  // at the same time, find the lines that contain chains of constraints.
+  // this only reads the other lines, so all lines can be worked on in
+  // parallel. the resolution of the chains below modifies the lines while
+  // reading others and is done serially, but only on the lines found here,
+  // which are usually few compared to all lines
+  std::vector<std::uint8_t> line_has_chain(lines.size(), 0);
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        {
+          ConstraintLine &line = lines[l];
+          line.entries.erase(
+            std::remove_if(line.entries.begin(),
+                           line.entries.end(),
+                           [](const std::pair<size_type, number> &p) {
+                             return p.second == number(0.);
+                           }),
+            line.entries.end());
+
+          for (const std::pair<size_type, number> &entry : line.entries)
+            if (is_chained_entry(entry.first))
+              {
+                line_has_chain[l] = 1;
+                break;
+              }
+        }
+    },
+    internal::AffineConstraints::n_lines_per_task);
+
+  std::vector<size_type> chained_lines;
+  for (size_type l = 0; l < lines.size(); ++l)
+    if (line_has_chain[l] != 0)
+      chained_lines.push_back(l);
 
 
 
@@ -719,13 +777,18 @@ AffineConstraints<number>::close()
   // we sort the list so that throwing out duplicates becomes much more
   // efficient. also, we have to do it only once, rather than in each
   // iteration
+  //
+  // lines that do not contain chains are never changed by this loop, so
+  // only the lines found above need to be visited
   size_type iteration = 0;
-  while (true)
+  while (chained_lines.size() > 0)
     {
       bool chained_constraint_replaced = false;
 
-      for (ConstraintLine &line : lines)
+      for (const size_type l : chained_lines)
         {
+          ConstraintLine &line = lines[l];
+
 #ifdef DEBUG
           // we need to keep track of how many replacements we do in this line,
           // because we can end up in a cycle A->B->C->A without the number of
@@ -739,9 +802,7 @@ AffineConstraints<number>::close()
           // the current processor
           size_type entry = 0;
           while (entry < line.entries.size())
-            if (((local_lines.size() == 0) ||
-                 (local_lines.is_element(line.entries[entry].first))) &&
-                is_constrained(line.entries[entry].first))
+            if (is_chained_entry(line.entries[entry].first))
               {
                 // ok, this entry is further constrained:
                 chained_constraint_replaced = true;
@@ -832,91 +893,75 @@ AffineConstraints<number>::close()
   // finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
   // entries might have had zero weights, we replace them by a vector with
-  // sharp sizes.
-  for (ConstraintLine &line : lines)
-    {
-      std::sort(line.entries.begin(),
-                line.entries.end(),
-                [](const std::pair<unsigned int, number> &a,
-                   const std::pair<unsigned int, number> &b) -> bool {
-                  // Let's use lexicogrpahic ordering with std::abs for number
-                  // type (it might be complex valued).
-                  return (a.first < b.first) ||
-                         (a.first == b.first &&
-                          std::abs(a.second) < std::abs(b.second));
-                });
-
-      // loop over the now sorted list and see whether any of the entries
-      // references the same dofs more than once in order to find how many
-      // non-duplicate entries we have. This lets us allocate the correct
-      // amount of memory for the constraint entries.
-      size_type duplicates = 0;
-      for (size_type i = 1; i < line.entries.size(); ++i)
-        if (line.entries[i].first == line.entries[i - 1].first)
-          duplicates++;
-
-      if (duplicates > 0 || line.entries.size() < line.entries.capacity())
+  // sharp sizes. each line is treated independently, so we can work on
+  // them in parallel.
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
         {
-          typename ConstraintLine::Entries new_entries;
-
-          // if we have no duplicates, copy verbatim the entries. this way,
-          // the final size is of the vector is correct.
-          if (duplicates == 0)
-            new_entries = line.entries;
-          else
+          ConstraintLine &line = lines[l];
+
+          std::sort(line.entries.begin(),
+                    line.entries.end(),
+                    [](const std::pair<unsigned int, number> &a,
+                       const std::pair<unsigned int, number> &b) -> bool {
+                      // Let's use lexicogrpahic ordering with std::abs for
+                      // number type (it might be complex valued).
+                      return (a.first < b.first) ||
+                             (a.first == b.first &&
+                              std::abs(a.second) < std::abs(b.second));
+                    });
+
+          // loop over the now sorted list and merge entries that reference
+          // the same dof more than once. this is done in place, so that we
+          // only need to allocate memory once below when giving the vector
+          // its sharp size
+          if (line.entries.size() > 1)
             {
-              // otherwise, we need to go through the list and resolve the
-              // duplicates
-              new_entries.reserve(line.entries.size() - duplicates);
-              new_entries.push_back(line.entries[0]);
+              size_type n_unique = 1;
               for (size_type j = 1; j < line.entries.size(); ++j)
-                if (line.entries[j].first == line.entries[j - 1].first)
-                  {
-                    Assert(new_entries.back().first == line.entries[j].first,
-                           ExcInternalError());
-                    new_entries.back().second += line.entries[j].second;
-                  }
+                if (line.entries[j].first == line.entries[n_unique - 1].first)
+                  line.entries[n_unique - 1].second += line.entries[j].second;
                 else
-                  new_entries.push_back(line.entries[j]);
-
-              Assert(new_entries.size() == line.entries.size() - duplicates,
-                     ExcInternalError());
+                  line.entries[n_unique++] = line.entries[j];
+              line.entries.resize(n_unique);
 
               // make sure there are really no duplicates left and that the
               // list is still sorted
-              for (size_type j = 1; j < new_entries.size(); ++j)
-                {
-                  Assert(new_entries[j].first != new_entries[j - 1].first,
-                         ExcInternalError());
-                  Assert(new_entries[j].first > new_entries[j - 1].first,
-                         ExcInternalError());
-                }
+              for (size_type j = 1; j < line.entries.size(); ++j)
+                Assert(line.entries[j].first > line.entries[j - 1].first,
+                       ExcInternalError());
             }
 
-          // replace old list of constraints for this dof by the new one
-          line.entries.swap(new_entries);
-        }
-
-      // Finally do the following check: if the sum of weights for the
-      // constraints is close to one, but not exactly one, then rescale all
-      // the weights so that they sum up to 1. this adds a little numerical
-      // stability and avoids all sorts of problems where the actual value
-      // is close to, but not quite what we expected
-      //
-      // the case where the weights don't quite sum up happens when we
-      // compute the interpolation weights "on the fly", i.e. not from
-      // precomputed tables. in this case, the interpolation weights are
-      // also subject to round-off
-      number sum = 0.;
-      for (const std::pair<size_type, number> &entry : line.entries)
-        sum += entry.second;
-      if (std::abs(sum - number(1.)) < 1.e-13)
-        {
-          for (std::pair<size_type, number> &entry : line.entries)
-            entry.second /= sum;
-          line.inhomogeneity /= sum;
-        }
-    } // end of loop over all constraint lines
+          // replace the list of constraints for this dof by one with sharp
+          // size
+          if (line.entries.size() < line.entries.capacity())
+            typename ConstraintLine::Entries(line.entries).swap(line.entries);
+
+          // Finally do the following check: if the sum of weights for the
+          // constraints is close to one, but not exactly one, then rescale
+          // all the weights so that they sum up to 1. this adds a little
+          // numerical stability and avoids all sorts of problems where the
+          // actual value is close to, but not quite what we expected
+          //
+          // the case where the weights don't quite sum up happens when we
+          // compute the interpolation weights "on the fly", i.e. not from
+          // precomputed tables. in this case, the interpolation weights are
+          // also subject to round-off
+          number sum = 0.;
+          for (const std::pair<size_type, number> &entry : line.entries)
+            sum += entry.second;
+          if (std::abs(sum - number(1.)) < 1.e-13)
+            {
+              for (std::pair<size_type, number> &entry : line.entries)
+                entry.second /= sum;
+              line.inhomogeneity /= sum;
+            }
+        } // end of loop over all constraint lines
+    },
+    internal::AffineConstraints::n_lines_per_task);
 
 #ifdef DEBUG
   // if in debug mode: check that no dof is constrained to another dof that
@@ -964,46 +1009,57 @@ AffineConstraints<number>::merge(
   //
   // for this, loop over all constraints and replace the constraint lines
   // with a new one where constraints are replaced if necessary.
-  typename ConstraintLine::Entries tmp;
-  for (ConstraintLine &line : lines)
-    {
-      tmp.clear();
-      for (const std::pair<size_type, number> &entry : line.entries)
+  //
+  // each line is replaced independently, reading only from the other
+  // object, so we can work on the lines in parallel.
+  other_constraints.local_lines.compress();
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      typename ConstraintLine::Entries tmp;
+      for (size_type l = begin; l < end; ++l)
         {
-          // if the present dof is not stored, or not constrained, or if we
-          // won't take the constraint from the other object, then simply copy
-          // it over
-          if ((other_constraints.local_lines.size() != 0. &&
-               other_constraints.local_lines.is_element(entry.first) ==
-                 false) ||
-              other_constraints.is_constrained(entry.first) == false ||
-              ((merge_conflict_behavior != right_object_wins) &&
-               other_constraints.is_constrained(entry.first) &&
-               this->is_constrained(entry.first)))
-            tmp.push_back(entry);
-          else
-            // otherwise resolve further constraints by replacing the old
-            // entry by a sequence of new entries taken from the other
-            // object, but with multiplied weights
+          ConstraintLine &line = lines[l];
+          tmp.clear();
+          for (const std::pair<size_type, number> &entry : line.entries)
             {
-              const typename ConstraintLine::Entries *other_entries =
-                other_constraints.get_constraint_entries(entry.first);
-              Assert(other_entries != nullptr, ExcInternalError());
+              // if the present dof is not stored, or not constrained, or if
+              // we won't take the constraint from the other object, then
+              // simply copy it over
+              if ((other_constraints.local_lines.size() != 0. &&
+                   other_constraints.local_lines.is_element(entry.first) ==
+                     false) ||
+                  other_constraints.is_constrained(entry.first) == false ||
+                  ((merge_conflict_behavior != right_object_wins) &&
+                   other_constraints.is_constrained(entry.first) &&
+                   this->is_constrained(entry.first)))
+                tmp.push_back(entry);
+              else
+                // otherwise resolve further constraints by replacing the old
+                // entry by a sequence of new entries taken from the other
+                // object, but with multiplied weights
+                {
+                  const typename ConstraintLine::Entries *other_entries =
+                    other_constraints.get_constraint_entries(entry.first);
+                  Assert(other_entries != nullptr, ExcInternalError());
 
-              const number weight = entry.second;
+                  const number weight = entry.second;
 
-              for (const std::pair<size_type, number> &other_entry :
-                   *other_entries)
-                tmp.emplace_back(other_entry.first,
-                                 other_entry.second * weight);
+                  for (const std::pair<size_type, number> &other_entry :
+                       *other_entries)
+                    tmp.emplace_back(other_entry.first,
+                                     other_entry.second * weight);
 
-              line.inhomogeneity +=
-                other_constraints.get_inhomogeneity(entry.first) * weight;
+                  line.inhomogeneity +=
+                    other_constraints.get_inhomogeneity(entry.first) * weight;
+                }
             }
+          // finally exchange old and newly resolved line
+          line.entries.swap(tmp);
         }
-      // finally exchange old and newly resolved line
-      line.entries.swap(tmp);
-    }
+    },
+    internal::AffineConstraints::n_lines_per_task);
 
   if (local_lines.size() != 0)
     local_lines.add_indices(other_constraints.local_lines);
@@ -2647,27 +2703,185 @@ AffineConstraints<number>::distribute(VectorType &vec) const
   else
     // purely sequential vector (either because the type doesn't
     // support anything else or because it's completely stored
-    // locally)
+    // locally). since the constraints are closed, no constrained entry
+    // depends on another constrained entry, so the lines can be worked on
+    // in parallel
+    {
+      parallel::apply_to_subranges(
+        size_type(0),
+        size_type(lines.size()),
+        [&](const size_type begin, const size_type end) {
+          for (size_type c = begin; c < end; ++c)
+            {
+              const ConstraintLine &next_constraint = lines[c];
+
+              // fill entry in line next_constraint.index by adding the
+              // different contributions
+              typename VectorType::value_type new_value =
+                next_constraint.inhomogeneity;
+              for (const std::pair<size_type, number> &entry :
+                   next_constraint.entries)
+                new_value += (static_cast<typename VectorType::value_type>(
+                                internal::ElementAccess<VectorType>::get(
+                                  vec, entry.first)) *
+                              entry.second);
+              AssertIsFinite(new_value);
+              internal::ElementAccess<VectorType>::set(new_value,
+                                                       next_constraint.index,
+                                                       vec);
+            }
+        },
+        internal::AffineConstraints::n_lines_per_task);
+    }
+}
+
+
+
+template <typename number>
+template <typename VectorNumber>
+void
+AffineConstraints<number>::distribute(
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec)
+  const
+{
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host>
+    ghosted_vector;
+  distribute_start(vec, ghosted_vector);
+  distribute_finish(vec, ghosted_vector);
+}
+
+
+
+template <typename number>
+template <typename VectorNumber>
+void
+AffineConstraints<number>::distribute_start(
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec,
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host>
+    &ghosted_vector) const
+{
+  Assert(sorted == true, ExcMatrixNotClosed());
+
+  const Utilities::MPI::Partitioner &partitioner = *vec.get_partitioner();
+
+  // set up a vector with the locally owned elements of the given vector plus
+  // the sources of the locally owned constraints that live elsewhere as
+  // ghost entries, unless this has been done in an earlier call
+  if (ghosted_vector.size() == 0)
+    {
+      std::vector<size_type> needed_indices;
+      for (const ConstraintLine &line : lines)
+        if (partitioner.in_local_range(line.index))
+          for (const std::pair<size_type, number> &entry : line.entries)
+            if (!partitioner.in_local_range(entry.first))
+              needed_indices.push_back(entry.first);
+      std::sort(needed_indices.begin(), needed_indices.end());
+      needed_indices.erase(std::unique(needed_indices.begin(),
+                                       needed_indices.end()),
+                           needed_indices.end());
+
+      IndexSet needed_elements(vec.size());
+      needed_elements.add_indices(needed_indices.begin(),
+                                  needed_indices.end());
+      ghosted_vector.reinit(partitioner.locally_owned_range(),
+                            needed_elements,
+                            partitioner.get_mpi_communicator());
+    }
+  else
     {
-      for (const ConstraintLine &next_constraint : lines)
+      AssertDimension(ghosted_vector.size(), vec.size());
+      Assert(ghosted_vector.get_partitioner()->locally_owned_range() ==
+               partitioner.locally_owned_range(),
+             ExcMessage("The ghosted vector passed to distribute_start() "
+                        "must have been set up for a vector with the same "
+                        "parallel layout, or be empty."));
+    }
+
+  vec.zero_out_ghost_values();
+  ghosted_vector.copy_locally_owned_data_from(vec);
+  ghosted_vector.update_ghost_values_start();
+
+  // while the data is in flight, set the constrained entries that only
+  // depend on locally owned entries. as in distribute(), read from the copy
+  // in ghosted_vector
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      for (size_type c = begin; c < end; ++c)
         {
-          // fill entry in line
-          // next_constraint.index by adding the
-          // different contributions
-          typename VectorType::value_type new_value =
-            next_constraint.inhomogeneity;
-          for (const std::pair<size_type, number> &entry :
-               next_constraint.entries)
-            new_value +=
-              (static_cast<typename VectorType::value_type>(
-                 internal::ElementAccess<VectorType>::get(vec, entry.first)) *
-               entry.second);
+          const ConstraintLine &line = lines[c];
+          if (!partitioner.in_local_range(line.index))
+            continue;
+
+          bool         all_sources_local = true;
+          VectorNumber new_value         = line.inhomogeneity;
+          for (const std::pair<size_type, number> &entry : line.entries)
+            {
+              if (!partitioner.in_local_range(entry.first))
+                {
+                  all_sources_local = false;
+                  break;
+                }
+              new_value += static_cast<VectorNumber>(
+                             ghosted_vector.local_element(
+                               partitioner.global_to_local(entry.first))) *
+                           entry.second;
+            }
+          if (all_sources_local)
+            {
+              AssertIsFinite(new_value);
+              vec.local_element(partitioner.global_to_local(line.index)) =
+                new_value;
+            }
+        }
+    },
+    internal::AffineConstraints::n_lines_per_task);
+}
+
+
+
+template <typename number>
+template <typename VectorNumber>
+void
+AffineConstraints<number>::distribute_finish(
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host> &vec,
+  LinearAlgebra::distributed::Vector<VectorNumber, MemorySpace::Host>
+    &ghosted_vector) const
+{
+  const Utilities::MPI::Partitioner &partitioner = *vec.get_partitioner();
+
+  ghosted_vector.update_ghost_values_finish();
+
+  // set the constrained entries that have at least one source on another
+  // process, which are exactly those skipped in distribute_start()
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      for (size_type c = begin; c < end; ++c)
+        {
+          const ConstraintLine &line = lines[c];
+          if (!partitioner.in_local_range(line.index) ||
+              std::all_of(line.entries.begin(),
+                          line.entries.end(),
+                          [&](const std::pair<size_type, number> &entry) {
+                            return partitioner.in_local_range(entry.first);
+                          }))
+            continue;
+
+          VectorNumber new_value = line.inhomogeneity;
+          for (const std::pair<size_type, number> &entry : line.entries)
+            new_value += static_cast<VectorNumber>(ghosted_vector.local_element(
+                           ghosted_vector.get_partitioner()->global_to_local(
+                             entry.first))) *
+                         entry.second;
           AssertIsFinite(new_value);
-          internal::ElementAccess<VectorType>::set(new_value,
-                                                   next_constraint.index,
-                                                   vec);
+          vec.local_element(partitioner.global_to_local(line.index)) =
+            new_value;
         }
-    }
+    },
+    internal::AffineConstraints::n_lines_per_task);
 }
 
 // Some helper definitions for the local_to_global functions.
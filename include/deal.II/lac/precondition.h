@@ -30,7 +30,9 @@
 
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/tridiagonal_matrix.h>
 #include <deal.II/lac/vector_memory.h>
 
 DEAL_II_NAMESPACE_OPEN
@@ -946,6 +948,43 @@ private:
  * AdditionalData::eig_cg_n_iterations to zero, and provide the variable
  * AdditionalData::max_eigenvalue instead. The minimal eigenvalue is
  * implicitly specified via `max_eigenvalue/smoothing_range`.
+ *
+ * <h4>Shortening the eigenvalue computation</h4>
+ *
+ * The largest Ritz value of the Lanczos process underlying the CG iteration
+ * increases monotonically towards the largest eigenvalue and usually
+ * converges much faster than the residual of the linear system. The
+ * distance of a Ritz value $\theta$ to the closest eigenvalue is bounded by
+ * the residual of the Ritz pair, which is $\beta_n |s_n|$: $\beta_n$ is the
+ * entry that couples the tridiagonal Lanczos matrix $T_n$ of the first $n$
+ * iterations to the next Lanczos vector, and $s_n$ is the last entry of the
+ * normalized eigenvector of $T_n$ for $\theta$. Both are available from the
+ * coefficients of the CG iteration. If
+ * AdditionalData::eig_cg_relative_tolerance is positive, the iteration is
+ * stopped as soon as this bound for the largest Ritz value is below the
+ * tolerance times the largest Ritz value, which often stops the iteration
+ * after a few steps instead of AdditionalData::eig_cg_n_iterations steps.
+ *
+ * In time-dependent or nonlinear problems, the operator often changes only
+ * slowly between two calls to initialize(). If
+ * AdditionalData::eig_warm_start is set, the object remembers the estimate
+ * of the largest eigenvalue of the previous computation (across calls to
+ * initialize()). In the same way, an estimate taken from another operator
+ * with a similar spectrum, e.g., the operator on another level of a
+ * multigrid hierarchy with the same polynomial degree, can be passed in
+ * AdditionalData::max_eigenvalue_guess. These values only enter the
+ * stopping test above: the bound for the largest Ritz value is compared with
+ * the tolerance times the larger of the largest Ritz value and the guess
+ * without the safety factor of 1.2. This allows to stop earlier while the
+ * Ritz value is still below its final value. A guess that is too small,
+ * e.g. because the spectrum has grown since the previous computation, falls
+ * back to the test without a guess, since the residual bound must be small
+ * in any case. A guess that is larger than the largest eigenvalue of the
+ * current operator, on the other hand, weakens the test: the iteration may
+ * stop while the largest Ritz value is up to the tolerance times the guess
+ * away from an eigenvalue, and the safety factor of 1.2 has to cover the
+ * remaining distance to the largest eigenvalue. The guess should therefore
+ * only be taken from operators whose spectrum is known to be similar.
 
  * <h4>Using the PreconditionChebyshev as a solver</h4>
  *
@@ -1074,6 +1113,37 @@ public:
      */
     double max_eigenvalue;
 
+    /**
+     * Relative tolerance on the residual bound of the largest Ritz value in
+     * the eigenvalue computation, below which the iteration is stopped
+     * before @p eig_cg_n_iterations are reached, see the general
+     * documentation of this class. If zero (the default), the iteration is
+     * only stopped by @p eig_cg_n_iterations and @p eig_cg_residual.
+     */
+    double eig_cg_relative_tolerance;
+
+    /**
+     * If true, the estimate of the largest eigenvalue of the previous
+     * eigenvalue computation of this object is kept across calls to
+     * initialize() and used in place of @p max_eigenvalue_guess in the next
+     * eigenvalue computation. See the general documentation of this class.
+     */
+    bool eig_warm_start;
+
+    /**
+     * An estimate of the largest eigenvalue, including the safety factor of
+     * 1.2, e.g. the PreconditionChebyshev::EigenvalueInformation::
+     * max_eigenvalue_estimate of an operator with similar spectrum. If
+     * positive, this value divided by 1.2 replaces the largest Ritz value
+     * in the test with @p eig_cg_relative_tolerance if it is larger, which
+     * stops the eigenvalue computation earlier. An overestimated guess
+     * weakens this test, see the general documentation of this class. The
+     * guess has no effect if that tolerance is zero. If @p eig_warm_start is
+     * set and this object has computed an estimate before, that estimate is
+     * used instead.
+     */
+    double max_eigenvalue_guess;
+
     /**
      * Constraints to be used for the operator given. This variable is used to
      * zero out the correct entries when creating an initial guess.
@@ -1249,6 +1319,13 @@ private:
    */
   bool eigenvalues_are_initialized;
 
+  /**
+   * The estimate of the largest eigenvalue of the last eigenvalue
+   * computation, used by AdditionalData::eig_warm_start, or a negative number
+   * if there is none. This value is kept when calling initialize().
+   */
+  double previous_max_eigenvalue_estimate;
+
   /**
    * A mutex to avoid that multiple vmult() invocations by different threads
    * overwrite the temporary vectors.
@@ -2198,6 +2275,9 @@ inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   , eig_cg_n_iterations(eig_cg_n_iterations)
   , eig_cg_residual(eig_cg_residual)
   , max_eigenvalue(max_eigenvalue)
+  , eig_cg_relative_tolerance(0.)
+  , eig_warm_start(false)
+  , max_eigenvalue_guess(0.)
 {}
 
 
@@ -2209,12 +2289,15 @@ inline typename PreconditionChebyshev<MatrixType,
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   AdditionalData::operator=(const AdditionalData &other_data)
 {
-  degree              = other_data.degree;
-  smoothing_range     = other_data.smoothing_range;
-  eig_cg_n_iterations = other_data.eig_cg_n_iterations;
-  eig_cg_residual     = other_data.eig_cg_residual;
-  max_eigenvalue      = other_data.max_eigenvalue;
-  preconditioner      = other_data.preconditioner;
+  degree                    = other_data.degree;
+  smoothing_range           = other_data.smoothing_range;
+  eig_cg_n_iterations       = other_data.eig_cg_n_iterations;
+  eig_cg_residual           = other_data.eig_cg_residual;
+  max_eigenvalue            = other_data.max_eigenvalue;
+  eig_cg_relative_tolerance = other_data.eig_cg_relative_tolerance;
+  eig_warm_start            = other_data.eig_warm_start;
+  max_eigenvalue_guess      = other_data.max_eigenvalue_guess;
+  preconditioner            = other_data.preconditioner;
   constraints.copy_from(other_data.constraints);
 
   return *this;
@@ -2228,6 +2311,7 @@ inline PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
   : theta(1.)
   , delta(1.)
   , eigenvalues_are_initialized(false)
+  , previous_max_eigenvalue_estimate(-1.)
 {
   static_assert(
     std::is_same<size_type, typename VectorType::size_type>::value,
@@ -2257,7 +2341,8 @@ template <typename MatrixType, typename VectorType, typename PreconditionerType>
 inline void
 PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::clear()
 {
-  eigenvalues_are_initialized = false;
+  eigenvalues_are_initialized      = false;
+  previous_max_eigenvalue_estimate = -1.;
   theta = delta = 1.0;
   matrix_ptr    = nullptr;
   {
@@ -2310,6 +2395,62 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
           eigenvalue_tracker.slot(eigenvalues);
         });
 
+      // stop the iteration once the residual bound of the largest Ritz
+      // value is small enough. To this end, build the tridiagonal Lanczos
+      // matrix from the CG coefficients in the same way as SolverCG does;
+      // the last entry of the off-diagonal couples it to the next Lanczos
+      // vector. Returning SolverControl::failure from an additional slot
+      // ends the loop of SolverCG, which still computes the final
+      // eigenvalues before throwing the exception caught below.
+      const double max_eigenvalue_guess =
+        (data.eig_warm_start && previous_max_eigenvalue_estimate > 0.) ?
+          previous_max_eigenvalue_estimate :
+          data.max_eigenvalue_guess;
+      std::vector<double> lanczos_diagonal;
+      std::vector<double> lanczos_offdiagonal;
+      double              previous_beta_over_alpha = 0.;
+      bool                ritz_value_converged     = false;
+      if (data.eig_cg_relative_tolerance > 0.)
+        {
+          solver.connect_coefficients_slot(
+            [&](const typename VectorType::value_type alpha,
+                const typename VectorType::value_type beta) {
+              lanczos_diagonal.push_back(1. / alpha + previous_beta_over_alpha);
+              previous_beta_over_alpha = beta / alpha;
+              lanczos_offdiagonal.push_back(std::sqrt(beta) / alpha);
+
+              const unsigned int n = lanczos_diagonal.size();
+              if (n < 2)
+                return;
+              TridiagonalMatrix<double> T(n, true);
+              for (unsigned int i = 0; i < n; ++i)
+                {
+                  T(i, i) = lanczos_diagonal[i];
+                  if (i + 1 < n)
+                    T(i, i + 1) = lanczos_offdiagonal[i];
+                }
+              FullMatrix<double> eigenvectors;
+              T.compute_eigenvalues(eigenvectors);
+
+              // a guess larger than the Ritz value relaxes the test, see the
+              // class documentation
+              const double largest_ritz_value = T.eigenvalue(n - 1);
+              const double residual_bound =
+                lanczos_offdiagonal.back() *
+                std::abs(eigenvectors(n - 1, n - 1));
+              ritz_value_converged =
+                residual_bound <=
+                data.eig_cg_relative_tolerance *
+                  std::max(largest_ritz_value, max_eigenvalue_guess / 1.2);
+            });
+          solver.connect([&ritz_value_converged](const unsigned int,
+                                                 const double,
+                                                 const VectorType &) {
+            return ritz_value_converged ? SolverControl::failure :
+                                          SolverControl::success;
+          });
+        }
+
       // set an initial guess that contains some high-frequency parts (to the
       // extent possible without knowing the discretization and the numbering)
       // to trigger high eigenvalues according to the external function
@@ -2340,6 +2481,11 @@ PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>::
         }
 
       info.cg_iterations = control.last_step();
+
+      const_cast<
+        PreconditionChebyshev<MatrixType, VectorType, PreconditionerType> *>(
+        this)
+        ->previous_max_eigenvalue_estimate = info.max_eigenvalue_estimate;
     }
   else
     {
@@ -21,19 +21,36 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
+#include <deal.II/lac/vector_operations_internal.h>
 
 #include <cmath>
+#include <functional>
+#include <type_traits>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
 // forward declaration
 #ifndef DOXYGEN
 class PreconditionIdentity;
+template <typename VectorType>
+class DiagonalMatrix;
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
 #endif
 
 
@@ -90,6 +107,55 @@ class PreconditionIdentity;
  * The solve() function of this class uses the mechanism described in the
  * Solver base class to determine convergence. This mechanism can also be used
  * to observe the progress of the iteration.
+ *
+ * @note For large parallel computations in which the global reductions of
+ * the inner products limit the iteration, SolverPipelinedCG offers a variant
+ * with a single reduction per iteration that overlaps with the
+ * preconditioner and the matrix-vector product.
+ *
+ * <h3>Fused vector operations for matrix-free operators</h3>
+ *
+ * Each CG iteration consists of a matrix-vector product, a preconditioner
+ * application, three vector updates and two or three inner products. If
+ * these are done one after the other, every iteration sweeps over the
+ * vectors five to six times, and for cheap matrix-free operators the
+ * iteration is limited by memory bandwidth rather than by the operator.
+ * The solve() function therefore merges all vector operations into two
+ * sweeps per iteration if
+ * <ul>
+ * <li> @p VectorType is LinearAlgebra::distributed::Vector on the host,
+ * <li> the preconditioner is PreconditionIdentity or a DiagonalMatrix, and
+ * <li> the matrix provides a member function
+ * @code
+ * void vmult(VectorType &dst,
+ *            const VectorType &src,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_before_matrix_vector_product,
+ *            const std::function<void(const unsigned int, const unsigned int)>
+ *              &operation_after_matrix_vector_product) const;
+ * @endcode
+ * </ul>
+ * This vmult() must compute <tt>dst = A*src</tt> like the two-argument
+ * variant. It must call the first function on every locally owned range
+ * <tt>[begin, end)</tt> of @p src before it reads these entries, and the
+ * second function on every locally owned range of @p dst after the last
+ * write to these entries. Ranges must not overlap, and together they must
+ * cover all locally owned entries. A matrix-free operator obtains this
+ * behavior by passing the two functions as @p operation_before_loop and
+ * @p operation_after_loop to MatrixFree::cell_loop(). The solver then
+ * updates the search direction in the first function and computes the inner
+ * product for the step length in the second function, so these operations
+ * act on data that is in cache anyway. The updates of the solution and the
+ * residual and the inner products for the next search direction follow in
+ * one more sweep. The inner products of this sweep are combined into a
+ * single global reduction.
+ *
+ * All inner products are summed in an order that does not depend on how
+ * the threads are scheduled, so repeated runs give identical results. For
+ * the inner product in the second function, this works best if the ranges
+ * start at multiples of 64 entries, as they do in MatrixFree. Other ranges
+ * are allowed, but the solver then has to compute the inner product of some
+ * entries in a separate serial loop after the matrix-vector product.
  */
 template <typename VectorType = Vector<double>>
 class SolverCG : public SolverBase<VectorType>
@@ -312,6 +378,485 @@ SolverCG<VectorType>::compute_eigs_and_cond(
 
 
 
+namespace internal
+{
+  namespace SolverCG
+  {
+    // A helper type-trait that leverage SFINAE to figure out if type T has
+    // a vmult() function that takes two additional functions to be run on
+    // the vector entries before and after the matrix-vector product
+    template <typename T, typename VectorType>
+    struct has_vmult_with_std_functions
+    {
+    private:
+      static bool
+      detect(...);
+
+      template <typename U>
+      static decltype(std::declval<U const &>().vmult(
+        std::declval<VectorType &>(),
+        std::declval<const VectorType &>(),
+        std::declval<
+          const std::function<void(const unsigned int, const unsigned int)> &>(),
+        std::declval<
+          const std::function<void(const unsigned int, const unsigned int)> &>()))
+      detect(const U &);
+
+    public:
+      static const bool value =
+        !std::is_same<bool, decltype(detect(std::declval<T>()))>::value;
+    };
+
+
+
+    /**
+     * Return a pointer to the locally owned entries of the diagonal of the
+     * preconditioner, or a null pointer for the identity.
+     */
+    template <typename Number>
+    const Number *
+    preconditioner_diagonal(const PreconditionIdentity &)
+    {
+      return nullptr;
+    }
+
+
+
+    template <typename Number, typename VectorType>
+    const Number *
+    preconditioner_diagonal(const DiagonalMatrix<VectorType> &preconditioner)
+    {
+      return preconditioner.get_vector().begin();
+    }
+
+
+
+    /**
+     * The length of the chunks in which the fused CG iteration computes the
+     * inner product in the operation after the matrix-vector product. This
+     * is the granularity of the ranges MatrixFree::cell_loop() passes to
+     * this operation, so that these ranges cover whole chunks.
+     */
+    constexpr unsigned int fused_dot_chunk_size = 64;
+
+
+
+    /**
+     * Whether the vector updates of the CG iteration can be merged into the
+     * matrix-vector product, see the documentation of the SolverCG class.
+     */
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType>
+    struct supports_fused_iteration
+    {
+      static const bool value = false;
+    };
+
+
+
+    template <typename Number,
+              typename MatrixType,
+              typename PreconditionerType>
+    struct supports_fused_iteration<
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>,
+      MatrixType,
+      PreconditionerType>
+    {
+      using VectorType =
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>;
+
+      static const bool value =
+        has_vmult_with_std_functions<MatrixType, VectorType>::value &&
+        (std::is_same<PreconditionerType, PreconditionIdentity>::value ||
+         std::is_same<PreconditionerType, DiagonalMatrix<VectorType>>::value);
+    };
+
+
+
+    /**
+     * Data shared by the implementations of a CG iteration below: the
+     * vectors, the coefficients of the current iteration and the residual
+     * norm.
+     */
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType>
+    struct IterationWorkerBase
+    {
+      using Number = typename VectorType::value_type;
+
+      const MatrixType &        A;
+      const PreconditionerType &preconditioner;
+      VectorType &              x;
+      VectorType &              r;
+      VectorType &              p;
+      VectorType &              v;
+
+      Number alpha;
+      Number beta;
+      Number r_dot_preconditioner_dot_r;
+      double residual_norm;
+
+      IterationWorkerBase(const MatrixType &        A,
+                          const PreconditionerType &preconditioner,
+                          VectorType &              x,
+                          VectorType &              r,
+                          VectorType &              p,
+                          VectorType &              v)
+        : A(A)
+        , preconditioner(preconditioner)
+        , x(x)
+        , r(r)
+        , p(p)
+        , v(v)
+        , alpha(Number())
+        , beta(Number())
+        , r_dot_preconditioner_dot_r(Number())
+        , residual_norm(0.)
+      {}
+
+      /**
+       * Compute the initial residual r = A x - b and its norm. If x is zero,
+       * short-circuit the matrix-vector product.
+       */
+      void
+      compute_initial_residual(const VectorType &b)
+      {
+        if (!x.all_zero())
+          {
+            A.vmult(r, x);
+            r.add(-1., b);
+          }
+        else
+          r.equ(-1., b);
+      }
+    };
+
+
+
+    /**
+     * The CG iteration built from individual vector operations, which works
+     * for all vector, matrix and preconditioner types. In this class, r is
+     * the residual, p the search direction and v holds the matrix-vector
+     * product and the preconditioned residual.
+     */
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType,
+              bool fused = supports_fused_iteration<VectorType,
+                                                    MatrixType,
+                                                    PreconditionerType>::value>
+    struct IterationWorker
+      : public IterationWorkerBase<VectorType, MatrixType, PreconditionerType>
+    {
+      using Base =
+        IterationWorkerBase<VectorType, MatrixType, PreconditionerType>;
+      using Number = typename Base::Number;
+
+      using Base::A;
+      using Base::alpha;
+      using Base::beta;
+      using Base::p;
+      using Base::preconditioner;
+      using Base::r;
+      using Base::r_dot_preconditioner_dot_r;
+      using Base::residual_norm;
+      using Base::v;
+      using Base::x;
+
+      IterationWorker(const MatrixType &        A,
+                      const PreconditionerType &preconditioner,
+                      VectorType &              x,
+                      VectorType &              r,
+                      VectorType &              p,
+                      VectorType &              v)
+        : Base(A, preconditioner, x, r, p, v)
+      {}
+
+      void
+      startup(const VectorType &b)
+      {
+        this->compute_initial_residual(b);
+        residual_norm = r.l2_norm();
+      }
+
+      void
+      do_iteration(const unsigned int iteration_index)
+      {
+        if (iteration_index > 1)
+          {
+            if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
+                false)
+              {
+                preconditioner.vmult(v, r);
+                beta = r_dot_preconditioner_dot_r;
+                Assert(std::abs(beta) != 0., ExcDivideByZero());
+                r_dot_preconditioner_dot_r = r * v;
+                beta                       = r_dot_preconditioner_dot_r / beta;
+                p.sadd(beta, -1., v);
+              }
+            else
+              {
+                beta                       = r_dot_preconditioner_dot_r;
+                r_dot_preconditioner_dot_r = residual_norm * residual_norm;
+                beta                       = r_dot_preconditioner_dot_r / beta;
+                p.sadd(beta, -1., r);
+              }
+          }
+        else
+          {
+            if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
+                false)
+              {
+                preconditioner.vmult(v, r);
+                p.equ(-1., v);
+                r_dot_preconditioner_dot_r = r * v;
+              }
+            else
+              {
+                p.equ(-1., r);
+                r_dot_preconditioner_dot_r = residual_norm * residual_norm;
+              }
+          }
+
+        A.vmult(v, p);
+
+        alpha = p * v;
+        Assert(std::abs(alpha) != 0., ExcDivideByZero());
+        alpha = r_dot_preconditioner_dot_r / alpha;
+
+        x.add(alpha, p);
+        residual_norm = std::sqrt(std::abs(r.add_and_dot(alpha, v, r)));
+      }
+    };
+
+
+
+    /**
+     * The CG iteration with fused vector operations for
+     * LinearAlgebra::distributed::Vector, see the documentation of the
+     * SolverCG class. The update of the search direction runs in the
+     * operation before the matrix-vector product and the inner product p*v
+     * in the operation after it. The updates of x and r and the two inner
+     * products r*r and r*P*r run in one more sweep, and the latter are summed
+     * over all processes in a single reduction.
+     */
+    template <typename VectorType,
+              typename MatrixType,
+              typename PreconditionerType>
+    struct IterationWorker<VectorType, MatrixType, PreconditionerType, true>
+      : public IterationWorkerBase<VectorType, MatrixType, PreconditionerType>
+    {
+      using Base =
+        IterationWorkerBase<VectorType, MatrixType, PreconditionerType>;
+      using Number = typename Base::Number;
+
+      using Base::A;
+      using Base::alpha;
+      using Base::beta;
+      using Base::p;
+      using Base::preconditioner;
+      using Base::r;
+      using Base::r_dot_preconditioner_dot_r;
+      using Base::residual_norm;
+      using Base::v;
+      using Base::x;
+
+      /**
+       * The value of r*P*r of the previous iteration, needed for beta.
+       */
+      Number previous_r_dot_preconditioner_dot_r;
+
+      /**
+       * Diagonal of the preconditioner, or a null pointer for the identity.
+       */
+      const Number *diagonal;
+
+      /**
+       * The inner product p*v computed in the operation after the
+       * matrix-vector product, split into chunks of
+       * fused_dot_chunk_size entries and summed in the order of the chunks
+       * afterwards.
+       */
+      std::vector<Number> chunk_p_dot_v;
+
+      /**
+       * Whether the entry of chunk_p_dot_v has been computed during the
+       * current matrix-vector product.
+       */
+      std::vector<unsigned char> chunk_is_done;
+
+      /**
+       * Scratch memory for the partial sums of
+       * internal::VectorOperations::parallel_chunked_sum(), kept across
+       * iterations.
+       */
+      std::vector<Number> chunk_sums;
+
+      IterationWorker(const MatrixType &        A,
+                      const PreconditionerType &preconditioner,
+                      VectorType &              x,
+                      VectorType &              r,
+                      VectorType &              p,
+                      VectorType &              v)
+        : Base(A, preconditioner, x, r, p, v)
+        , previous_r_dot_preconditioner_dot_r(Number())
+        , diagonal(preconditioner_diagonal<Number>(preconditioner))
+      {}
+
+      void
+      startup(const VectorType &b)
+      {
+        this->compute_initial_residual(b);
+
+        const unsigned int n_chunks =
+          (r.locally_owned_size() + fused_dot_chunk_size - 1) /
+          fused_dot_chunk_size;
+        chunk_p_dot_v.resize(n_chunks);
+        chunk_is_done.assign(n_chunks, 0);
+
+        Number sums[2];
+        internal::VectorOperations::parallel_chunked_sum(
+          r.locally_owned_size(),
+          2,
+          [&](const unsigned int begin,
+              const unsigned int end,
+              Number *           local_sums) {
+            for (unsigned int j = begin; j < end; ++j)
+              {
+                const Number r_j = r.local_element(j);
+                local_sums[0] += r_j * r_j;
+                local_sums[1] +=
+                  r_j * (diagonal != nullptr ? diagonal[j] * r_j : r_j);
+              }
+          },
+          sums,
+          chunk_sums);
+        Utilities::MPI::sum(sums, r.get_mpi_communicator(), sums);
+
+        residual_norm              = std::sqrt(std::abs(sums[0]));
+        r_dot_preconditioner_dot_r = sums[1];
+      }
+
+      void
+      do_iteration(const unsigned int iteration_index)
+      {
+        if (iteration_index > 1)
+          {
+            Assert(std::abs(previous_r_dot_preconditioner_dot_r) != 0.,
+                   ExcDivideByZero());
+            beta =
+              r_dot_preconditioner_dot_r / previous_r_dot_preconditioner_dot_r;
+          }
+
+        Number *const       p_values = p.begin();
+        const Number *const r_values = r.begin();
+        const Number *const v_values = v.begin();
+
+        const unsigned int local_size = r.locally_owned_size();
+        const auto         chunk_dot  = [&](const unsigned int chunk) {
+          Number             sum = Number();
+          const unsigned int end =
+            std::min(local_size, (chunk + 1) * fused_dot_chunk_size);
+          for (unsigned int j = chunk * fused_dot_chunk_size; j < end; ++j)
+            sum += p_values[j] * v_values[j];
+          return sum;
+        };
+
+        // first sweep: update the search direction before the matrix-vector
+        // product reads it, and compute p*v as soon as the product is final.
+        // The ranges passed to the second function are disjoint, so every
+        // chunk is covered completely by at most one of them.
+        A.vmult(
+          v,
+          p,
+          [&](const unsigned int begin, const unsigned int end) {
+            // p is not initialized in the first iteration, so do not read
+            // from it there
+            if (iteration_index > 1)
+              {
+                if (diagonal != nullptr)
+                  for (unsigned int j = begin; j < end; ++j)
+                    p_values[j] =
+                      beta * p_values[j] - diagonal[j] * r_values[j];
+                else
+                  for (unsigned int j = begin; j < end; ++j)
+                    p_values[j] = beta * p_values[j] - r_values[j];
+              }
+            else
+              {
+                if (diagonal != nullptr)
+                  for (unsigned int j = begin; j < end; ++j)
+                    p_values[j] = -diagonal[j] * r_values[j];
+                else
+                  for (unsigned int j = begin; j < end; ++j)
+                    p_values[j] = -r_values[j];
+              }
+          },
+          [&](const unsigned int begin, const unsigned int end) {
+            const unsigned int first_chunk =
+              (begin + fused_dot_chunk_size - 1) / fused_dot_chunk_size;
+            const unsigned int last_chunk =
+              end == local_size ?
+                static_cast<unsigned int>(chunk_p_dot_v.size()) :
+                end / fused_dot_chunk_size;
+            for (unsigned int c = first_chunk; c < last_chunk; ++c)
+              {
+                chunk_p_dot_v[c] = chunk_dot(c);
+                chunk_is_done[c] = 1;
+              }
+          });
+
+        // add up the chunks in a fixed order, and compute those chunks that
+        // were split between several ranges
+        Number p_dot_v = Number();
+        for (unsigned int c = 0; c < chunk_p_dot_v.size(); ++c)
+          {
+            p_dot_v += chunk_is_done[c] ? chunk_p_dot_v[c] : chunk_dot(c);
+            chunk_is_done[c] = 0;
+          }
+        p_dot_v = Utilities::MPI::sum(p_dot_v, v.get_mpi_communicator());
+
+        Assert(std::abs(p_dot_v) != 0., ExcDivideByZero());
+        alpha = r_dot_preconditioner_dot_r / p_dot_v;
+
+        // second sweep: update solution and residual, and compute the inner
+        // products for the norm and the next search direction
+        Number *const x_values          = x.begin();
+        Number *const r_values_writable = r.begin();
+        Number        sums[2];
+        internal::VectorOperations::parallel_chunked_sum(
+          local_size,
+          2,
+          [&](const unsigned int begin,
+              const unsigned int end,
+              Number *           local_sums) {
+            for (unsigned int j = begin; j < end; ++j)
+              {
+                x_values[j] += alpha * p_values[j];
+                const Number r_j =
+                  r_values_writable[j] + alpha * v_values[j];
+                r_values_writable[j] = r_j;
+                local_sums[0] += r_j * r_j;
+                local_sums[1] +=
+                  r_j * (diagonal != nullptr ? diagonal[j] * r_j : r_j);
+              }
+          },
+          sums,
+          chunk_sums);
+        Utilities::MPI::sum(sums, r.get_mpi_communicator(), sums);
+
+        residual_norm                       = std::sqrt(std::abs(sums[0]));
+        previous_r_dot_preconditioner_dot_r = r_dot_preconditioner_dot_r;
+        r_dot_preconditioner_dot_r          = sums[1];
+      }
+    };
+  } // namespace SolverCG
+} // namespace internal
+
+
+
 template <typename VectorType>
 template <typename MatrixType, typename PreconditionerType>
 void
@@ -353,81 +898,33 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
   d.reinit(x, true);
   h.reinit(x, true);
 
+  // the object that does the vector operations of each iteration, see the
+  // discussion of fused vector operations in the class documentation
+  internal::SolverCG::IterationWorker<VectorType, MatrixType, PreconditionerType>
+    worker(A, preconditioner, x, g, d, h);
+
   int    it        = 0;
-  number gh        = number();
-  number beta      = number();
-  number alpha     = number();
   number old_alpha = number();
 
-  // compute residual. if vector is zero, then short-circuit the full
-  // computation
-  if (!x.all_zero())
-    {
-      A.vmult(g, x);
-      g.add(-1., b);
-    }
-  else
-    g.equ(-1., b);
+  // compute residual
+  worker.startup(b);
 
-  double res = g.l2_norm();
-  conv       = this->iteration_status(0, res, x);
+  conv = this->iteration_status(0, worker.residual_norm, x);
   if (conv != SolverControl::iterate)
     return;
 
   while (conv == SolverControl::iterate)
     {
       it++;
-      old_alpha = alpha;
+      old_alpha = worker.alpha;
 
-      if (it > 1)
-        {
-          if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
-              false)
-            {
-              preconditioner.vmult(h, g);
-              beta = gh;
-              Assert(std::abs(beta) != 0., ExcDivideByZero());
-              gh   = g * h;
-              beta = gh / beta;
-              d.sadd(beta, -1., h);
-            }
-          else
-            {
-              beta = gh;
-              gh   = res * res;
-              beta = gh / beta;
-              d.sadd(beta, -1., g);
-            }
-        }
-      else
-        {
-          if (std::is_same<PreconditionerType, PreconditionIdentity>::value ==
-              false)
-            {
-              preconditioner.vmult(h, g);
-              d.equ(-1., h);
-              gh = g * h;
-            }
-          else
-            {
-              d.equ(-1., g);
-              gh = res * res;
-            }
-        }
-
-      A.vmult(h, d);
-
-      alpha = d * h;
-      Assert(std::abs(alpha) != 0., ExcDivideByZero());
-      alpha = gh / alpha;
-
-      x.add(alpha, d);
-      res = std::sqrt(std::abs(g.add_and_dot(alpha, h, g)));
+      worker.do_iteration(it);
 
       print_vectors(it, x, g, d);
 
       if (it > 1)
         {
+          const number beta = worker.beta;
           this->coefficients_signal(old_alpha, beta);
           // set up the vectors containing the diagonal and the off diagonal of
           // the projected matrix.
@@ -443,7 +940,7 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
                                 all_condition_numbers_signal);
         }
 
-      conv = this->iteration_status(it, res, x);
+      conv = this->iteration_status(it, worker.residual_norm, x);
     }
 
   compute_eigs_and_cond(diagonal,
@@ -453,7 +950,10 @@ SolverCG<VectorType>::solve(const MatrixType &        A,
 
   // in case of failure: throw exception
   if (conv != SolverControl::success)
-    AssertThrow(false, SolverControl::NoConvergence(it, res));
+    {
+      const double res = worker.residual_norm;
+      AssertThrow(false, SolverControl::NoConvergence(it, res));
+    }
   // otherwise exit as normal
 }
 
@@ -21,6 +21,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/subscriptor.h>
 
 #include <deal.II/lac/full_matrix.h>
@@ -29,6 +32,7 @@
 #include <deal.II/lac/solver.h>
 #include <deal.II/lac/solver_control.h>
 #include <deal.II/lac/vector.h>
+#include <deal.II/lac/vector_operations_internal.h>
 
 #include <algorithm>
 #include <cmath>
@@ -37,6 +41,18 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
 /*!@addtogroup Solvers */
 /*@{*/
 
@@ -154,6 +170,28 @@ namespace internal
  * class, see the documentation of the Solver base class.
  *
  *
+ * <h3>Orthogonalization of the Arnoldi basis</h3>
+ *
+ * By default, each new Arnoldi vector is orthogonalized against the
+ * previous basis vectors with the modified Gram-Schmidt algorithm. This
+ * algorithm computes one inner product after the other, since each one
+ * depends on the previous update. In parallel, every basis vector thus costs
+ * one global reduction, and for large numbers of MPI ranks the Arnoldi step
+ * becomes limited by the latency of these reductions.
+ *
+ * With AdditionalData::orthogonalization_strategy set to
+ * AdditionalData::OrthogonalizationStrategy::classical_gram_schmidt, the
+ * solver instead uses classical Gram-Schmidt with one re-orthogonalization
+ * (CGS2). All inner products of one pass are independent of each other.
+ * For LinearAlgebra::distributed::Vector, they are computed in a single
+ * sweep over the basis and summed over all processes in one reduction, and
+ * the update of the new vector runs in one more sweep. An Arnoldi step then
+ * needs three reductions, one of them for the norm, independent of the size
+ * of the basis. The second pass gives the same level of orthogonality as
+ * modified Gram-Schmidt with re-orthogonalization. For other vector types,
+ * the same algorithm is run with the individual vector operations.
+ *
+ *
  * <h3>Observing the progress of linear solver iterations</h3>
  *
  * The solve() function of this class uses the mechanism described in the
@@ -181,16 +219,39 @@ public:
    */
   struct AdditionalData
   {
+    /**
+     * The algorithm used to orthogonalize new vectors against the Arnoldi
+     * basis, see the section on orthogonalization in the class
+     * documentation.
+     */
+    enum class OrthogonalizationStrategy
+    {
+      /**
+       * Modified Gram-Schmidt, with re-orthogonalization if a loss of
+       * orthogonality is detected or if it is forced.
+       */
+      modified_gram_schmidt,
+      /**
+       * Classical Gram-Schmidt with one re-orthogonalization (CGS2), which
+       * combines all inner products of one pass into a single reduction.
+       */
+      classical_gram_schmidt
+    };
+
     /**
      * Constructor. By default, set the number of temporary vectors to 30,
      * i.e. do a restart every 28 iterations. Also set preconditioning from
      * left, the residual of the stopping criterion to the default residual,
-     * and re-orthogonalization only if necessary.
+     * re-orthogonalization only if necessary, and the modified Gram-Schmidt
+     * algorithm.
      */
-    explicit AdditionalData(const unsigned int max_n_tmp_vectors     = 30,
-                            const bool         right_preconditioning = false,
-                            const bool         use_default_residual  = true,
-                            const bool force_re_orthogonalization    = false);
+    explicit AdditionalData(
+      const unsigned int max_n_tmp_vectors          = 30,
+      const bool         right_preconditioning      = false,
+      const bool         use_default_residual       = true,
+      const bool         force_re_orthogonalization = false,
+      const OrthogonalizationStrategy orthogonalization_strategy =
+        OrthogonalizationStrategy::modified_gram_schmidt);
 
     /**
      * Maximum number of temporary vectors. This parameter controls the size
@@ -218,9 +279,15 @@ public:
      * Flag to force re-orthogonalization of orthonormal basis in every step.
      * If set to false, the solver automatically checks for loss of
      * orthogonality every 5 iterations and enables re-orthogonalization only
-     * if necessary.
+     * if necessary. This flag is ignored by the classical Gram-Schmidt
+     * algorithm, which always orthogonalizes twice.
      */
     bool force_re_orthogonalization;
+
+    /**
+     * The orthogonalization algorithm for the Arnoldi basis.
+     */
+    OrthogonalizationStrategy orthogonalization_strategy;
   };
 
   /**
@@ -409,6 +476,27 @@ protected:
     const boost::signals2::signal<void(int)> &re_orthogonalize_signal =
       boost::signals2::signal<void(int)>());
 
+  /**
+   * Orthogonalize the vector @p vv against the @p dim (orthogonal) vectors
+   * given by the first argument using the classical Gram-Schmidt algorithm
+   * with one re-orthogonalization step (CGS2). The factors used for
+   * orthogonalization are stored in @p h, and the norm of @p vv after
+   * orthogonalization is returned. The inner products of each of the two
+   * passes are computed together, see the class documentation. The vectors
+   * @p h_correction, which must have at least @p dim entries, and
+   * @p chunk_sums are scratch memory for the second pass and the inner
+   * products, kept across calls.
+   */
+  static double
+  classical_gram_schmidt(
+    const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+      &                  orthogonal_vectors,
+    const unsigned int   dim,
+    VectorType &         vv,
+    Vector<double> &     h,
+    Vector<double> &     h_correction,
+    std::vector<double> &chunk_sums);
+
   /**
    * Estimates the eigenvalues from the Hessenberg matrix, H_orig, generated
    * during the inner iterations. Uses these estimate to compute the condition
@@ -574,6 +662,158 @@ namespace internal
 
 
 
+    /**
+     * Compute the inner products of @p vv with the first @p dim vectors of
+     * @p orthogonal_vectors and write them into the first @p dim entries of
+     * @p h. The vector @p chunk_sums is scratch memory of the specialization
+     * for LinearAlgebra::distributed::Vector below, kept across calls.
+     */
+    template <typename VectorType>
+    void
+    block_dot(const TmpVectors<VectorType> &orthogonal_vectors,
+              const unsigned int            dim,
+              const VectorType &            vv,
+              dealii::Vector<double> &      h,
+              std::vector<double> &)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        h(i) = vv * orthogonal_vectors[i];
+    }
+
+
+
+    /**
+     * Subtract the linear combination of the first @p dim vectors of
+     * @p orthogonal_vectors with the coefficients @p h from @p vv. If
+     * @p compute_norm is true, return the norm of the result, otherwise
+     * zero.
+     */
+    template <typename VectorType>
+    double
+    block_subtract(const TmpVectors<VectorType> &orthogonal_vectors,
+                   const unsigned int            dim,
+                   const dealii::Vector<double> &h,
+                   VectorType &                  vv,
+                   const bool                    compute_norm,
+                   std::vector<double> &)
+    {
+      for (unsigned int i = 0; i < dim; ++i)
+        vv.add(-h(i), orthogonal_vectors[i]);
+      return compute_norm ? vv.l2_norm() : 0.;
+    }
+
+
+
+    /**
+     * The number of vector entries processed at a time by the blocked
+     * kernels below. While the basis vectors are streamed from memory, the
+     * block of the new vector stays in the level-1 cache.
+     */
+    constexpr unsigned int gram_schmidt_block_size = 512;
+
+
+
+    /**
+     * Same as above, specialized for LinearAlgebra::distributed::Vector.
+     * All inner products are computed in one sweep over the locally owned
+     * entries and summed over all processes in a single reduction. The
+     * partial sums of the threads are added in a fixed order, so the result
+     * does not depend on thread scheduling.
+     */
+    template <typename Number>
+    void
+    block_dot(
+      const TmpVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &                orthogonal_vectors,
+      const unsigned int dim,
+      const LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &vv,
+      dealii::Vector<double> &                                             h,
+      std::vector<double> &chunk_sums)
+    {
+      internal::VectorOperations::parallel_chunked_sum(
+        vv.locally_owned_size(),
+        dim,
+        [&](const unsigned int begin,
+            const unsigned int end,
+            double *           local_sums) {
+          const Number *const vv_values = vv.begin();
+          for (unsigned int b = begin; b < end; b += gram_schmidt_block_size)
+            {
+              const unsigned int e =
+                std::min(end, b + gram_schmidt_block_size);
+              for (unsigned int i = 0; i < dim; ++i)
+                {
+                  const Number *const v_values = orthogonal_vectors[i].begin();
+                  double              sum      = 0.;
+                  for (unsigned int j = b; j < e; ++j)
+                    sum += v_values[j] * vv_values[j];
+                  local_sums[i] += sum;
+                }
+            }
+        },
+        h.begin(),
+        chunk_sums);
+
+      Utilities::MPI::sum(ArrayView<const double>(h.begin(), dim),
+                          vv.get_mpi_communicator(),
+                          ArrayView<double>(h.begin(), dim));
+    }
+
+
+
+    /**
+     * Same as above, specialized for LinearAlgebra::distributed::Vector. The
+     * update of @p vv and the computation of its norm run in one sweep.
+     */
+    template <typename Number>
+    double
+    block_subtract(
+      const TmpVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &                           orthogonal_vectors,
+      const unsigned int            dim,
+      const dealii::Vector<double> &h,
+      LinearAlgebra::distributed::Vector<Number, MemorySpace::Host> &vv,
+      const bool           compute_norm,
+      std::vector<double> &chunk_sums)
+    {
+      double norm_sqr = 0.;
+      internal::VectorOperations::parallel_chunked_sum(
+        vv.locally_owned_size(),
+        1,
+        [&](const unsigned int begin,
+            const unsigned int end,
+            double *           local_norm_sqr) {
+          Number *const vv_values = vv.begin();
+          for (unsigned int b = begin; b < end; b += gram_schmidt_block_size)
+            {
+              const unsigned int e =
+                std::min(end, b + gram_schmidt_block_size);
+              for (unsigned int i = 0; i < dim; ++i)
+                {
+                  const Number *const v_values = orthogonal_vectors[i].begin();
+                  const Number        factor   = h(i);
+                  for (unsigned int j = b; j < e; ++j)
+                    vv_values[j] -= factor * v_values[j];
+                }
+              if (compute_norm)
+                for (unsigned int j = b; j < e; ++j)
+                  *local_norm_sqr += vv_values[j] * vv_values[j];
+            }
+        },
+        &norm_sqr,
+        chunk_sums);
+
+      if (compute_norm)
+        return std::sqrt(
+          Utilities::MPI::sum(norm_sqr, vv.get_mpi_communicator()));
+      else
+        return 0.;
+    }
+
+
+
     // A comparator for better printing eigenvalues
     inline bool
     complex_less_pred(const std::complex<double> &x,
@@ -592,11 +832,13 @@ inline SolverGMRES<VectorType>::AdditionalData::AdditionalData(
   const unsigned int max_n_tmp_vectors,
   const bool         right_preconditioning,
   const bool         use_default_residual,
-  const bool         force_re_orthogonalization)
+  const bool         force_re_orthogonalization,
+  const OrthogonalizationStrategy orthogonalization_strategy)
   : max_n_tmp_vectors(max_n_tmp_vectors)
   , right_preconditioning(right_preconditioning)
   , use_default_residual(use_default_residual)
   , force_re_orthogonalization(force_re_orthogonalization)
+  , orthogonalization_strategy(orthogonalization_strategy)
 {
   Assert(3 <= max_n_tmp_vectors,
          ExcMessage("SolverGMRES needs at least three "
@@ -725,6 +967,42 @@ SolverGMRES<VectorType>::modified_gram_schmidt(
 
 
 
+template <class VectorType>
+inline double
+SolverGMRES<VectorType>::classical_gram_schmidt(
+  const internal::SolverGMRESImplementation::TmpVectors<VectorType>
+    &                  orthogonal_vectors,
+  const unsigned int   dim,
+  VectorType &         vv,
+  Vector<double> &     h,
+  Vector<double> &     h_correction,
+  std::vector<double> &chunk_sums)
+{
+  Assert(dim > 0, ExcInternalError());
+  AssertIndexRange(dim - 1, h_correction.size());
+
+  // first pass: compute all inner products at once and subtract the
+  // projection
+  internal::SolverGMRESImplementation::block_dot(
+    orthogonal_vectors, dim, vv, h, chunk_sums);
+  internal::SolverGMRESImplementation::block_subtract(
+    orthogonal_vectors, dim, h, vv, false, chunk_sums);
+
+  // second pass to recover the orthogonality lost to round-off in the
+  // first pass
+  internal::SolverGMRESImplementation::block_dot(
+    orthogonal_vectors, dim, vv, h_correction, chunk_sums);
+  const double norm_vv = internal::SolverGMRESImplementation::block_subtract(
+    orthogonal_vectors, dim, h_correction, vv, true, chunk_sums);
+
+  for (unsigned int i = 0; i < dim; ++i)
+    h(i) += h_correction(i);
+
+  return norm_vv;
+}
+
+
+
 template <class VectorType>
 inline void
 SolverGMRES<VectorType>::compute_eigs_and_cond(
@@ -822,6 +1100,10 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
   dealii::Vector<double> gamma(n_tmp_vectors), ci(n_tmp_vectors - 1),
     si(n_tmp_vectors - 1), h(n_tmp_vectors - 1);
 
+  // scratch memory for the second pass and the inner products of classical
+  // Gram-Schmidt
+  dealii::Vector<double> h_correction(n_tmp_vectors - 1);
+  std::vector<double>    chunk_sums;
 
   unsigned int dim = 0;
 
@@ -943,13 +1225,18 @@ SolverGMRES<VectorType>::solve(const MatrixType &        A,
 
           dim = inner_iteration + 1;
 
-          const double s         = modified_gram_schmidt(tmp_vectors,
-                                                 dim,
-                                                 accumulated_iterations,
-                                                 vv,
-                                                 h,
-                                                 re_orthogonalize,
-                                                 re_orthogonalize_signal);
+          const double s =
+            (additional_data.orthogonalization_strategy ==
+             AdditionalData::OrthogonalizationStrategy::classical_gram_schmidt) ?
+              classical_gram_schmidt(
+                tmp_vectors, dim, vv, h, h_correction, chunk_sums) :
+              modified_gram_schmidt(tmp_vectors,
+                                    dim,
+                                    accumulated_iterations,
+                                    vv,
+                                    h,
+                                    re_orthogonalize,
+                                    re_orthogonalize_signal);
           h(inner_iteration + 1) = s;
 
           // s=0 is a lucky breakdown, the solver will reach convergence,
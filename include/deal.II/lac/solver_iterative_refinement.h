@@ -0,0 +1,442 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_iterative_refinement_h
+#define dealii_solver_iterative_refinement_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+
+#include <deal.II/lac/solver.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector.h>
+
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup Preconditioners */
+/*@{*/
+
+/**
+ * A preconditioner that applies an (approximate) inverse set up in a lower
+ * precision than the vectors of the outer solver. The typical use case is a
+ * factorization of a SparseMatrix<float> copy of the system matrix, e.g. by
+ * SparseILU<float>, which needs half of the memory and memory bandwidth of
+ * the factorization in double precision. The vector passed to vmult() is
+ * converted to @p LowPrecisionVectorType, the inverse is applied, and the
+ * result is converted back.
+ *
+ * Used within SolverIterativeRefinement, this class gives the classical
+ * mixed-precision iterative refinement. Used as preconditioner of
+ * SolverGMRES, it gives the GMRES-based iterative refinement (GMRES-IR),
+ * which converges also when the low-precision inverse is too inaccurate for
+ * plain refinement:
+ * @code
+ * SparseMatrix<float> system_matrix_float;
+ * system_matrix_float.reinit(sparsity_pattern);
+ * system_matrix_float.copy_from(system_matrix);
+ *
+ * SparseILU<float> ilu;
+ * ilu.initialize(system_matrix_float);
+ *
+ * PreconditionMixedPrecision<SparseILU<float>> preconditioner(ilu);
+ * SolverGMRES<Vector<double>> solver(solver_control);
+ * solver.solve(system_matrix, solution, system_rhs, preconditioner);
+ * @endcode
+ *
+ * @note This class keeps the low-precision vectors as member variables to
+ * avoid memory allocation in each call of vmult(). It can therefore not be
+ * used concurrently from several threads.
+ */
+template <typename InverseType, typename LowPrecisionVectorType = Vector<float>>
+class PreconditionMixedPrecision : public Subscriptor
+{
+public:
+  /**
+   * Constructor. Store a pointer to the low-precision @p inverse.
+   */
+  PreconditionMixedPrecision(const InverseType &inverse);
+
+  /**
+   * Apply the low-precision inverse to @p src and write the result into
+   * @p dst.
+   */
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transpose of the low-precision inverse to @p src and write the
+   * result into @p dst.
+   */
+  template <typename VectorType>
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+private:
+  /**
+   * Pointer to the inverse.
+   */
+  SmartPointer<const InverseType, PreconditionMixedPrecision> inverse;
+
+  /**
+   * Temporary vectors in low precision.
+   */
+  mutable LowPrecisionVectorType src_low, dst_low;
+};
+
+/*@}*/
+
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * Iterative refinement for the linear system $Ax=b$: In each step, the
+ * residual $r_k = b - Ax_k$ is computed in the precision of @p VectorType,
+ * a correction $d_k = P^{-1}r_k$ is computed with an inexact inverse $P^{-1}$,
+ * and the iterate is updated by $x_{k+1} = x_k + d_k$. If $P^{-1}$ is a
+ * factorization of $A$ computed in single precision (see
+ * PreconditionMixedPrecision), the error is reduced by a factor
+ * proportional to the condition number of $A$ times the single-precision
+ * round-off in each step, so that double-precision accuracy is recovered in
+ * a few steps while the factorization only needs half the memory.
+ *
+ * The iteration is equivalent to SolverRichardson without damping, but
+ * additionally monitors the contraction of the residual: If the residual is
+ * reduced by less than AdditionalData::stagnation_factor in
+ * AdditionalData::n_stagnation_steps consecutive steps, the low-precision
+ * inverse is not accurate enough for the given matrix, and the solver stops
+ * with an exception of type ExcRefinementStagnated. In that case, the
+ * inverse should be used as a preconditioner for SolverGMRES instead. The
+ * history of the last solve can be queried by get_convergence_report().
+ *
+ * For the requirements on matrices and vectors in order to work with this
+ * class, see the documentation of the Solver base class.
+ *
+ *
+ * <h3>Observing the progress of linear solver iterations</h3>
+ *
+ * The solve() function of this class uses the mechanism described in the
+ * Solver base class to determine convergence. This mechanism can also be used
+ * to observe the progress of the iteration.
+ */
+template <class VectorType = Vector<double>>
+class SolverIterativeRefinement : public SolverBase<VectorType>
+{
+public:
+  /**
+   * Standardized data struct to pipe additional data to the solver.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor. By default, the refinement is considered stagnating if
+     * the residual is reduced by less than a factor of two in three
+     * consecutive steps.
+     */
+    explicit AdditionalData(const double       stagnation_factor  = 0.5,
+                            const unsigned int n_stagnation_steps = 3);
+
+    /**
+     * Minimal reduction of the residual per step below which a step is
+     * counted as stagnating.
+     */
+    double stagnation_factor;
+
+    /**
+     * Number of consecutive stagnating steps after which the iteration is
+     * stopped.
+     */
+    unsigned int n_stagnation_steps;
+  };
+
+  /**
+   * Summary of the last call to solve().
+   */
+  struct ConvergenceReport
+  {
+    /**
+     * Number of refinement steps.
+     */
+    unsigned int n_steps = 0;
+
+    /**
+     * Norm of the initial residual.
+     */
+    double initial_residual = 0.;
+
+    /**
+     * Norm of the final residual.
+     */
+    double final_residual = 0.;
+
+    /**
+     * Geometric mean of the reduction of the residual per step.
+     */
+    double average_contraction = 0.;
+
+    /**
+     * Reduction of the residual in the last step.
+     */
+    double last_contraction = 0.;
+
+    /**
+     * Whether the iteration was stopped because of stagnation.
+     */
+    bool stagnated = false;
+  };
+
+  /**
+   * Constructor.
+   */
+  SolverIterativeRefinement(SolverControl &           cn,
+                            VectorMemory<VectorType> &mem,
+                            const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverIterativeRefinement(SolverControl &       cn,
+                            const AdditionalData &data = AdditionalData());
+
+  /**
+   * Solve the linear system $Ax=b$ for x, using @p inverse to compute the
+   * corrections.
+   */
+  template <typename MatrixType, typename InverseType>
+  void
+  solve(const MatrixType & A,
+        VectorType &       x,
+        const VectorType & b,
+        const InverseType &inverse);
+
+  /**
+   * Return the summary of the last call to solve().
+   */
+  const ConvergenceReport &
+  get_convergence_report() const;
+
+  /**
+   * Exception thrown when the refinement stagnates.
+   */
+  DeclException3(ExcRefinementStagnated,
+                 unsigned int,
+                 double,
+                 double,
+                 << "Iterative refinement stagnated in step " << arg1
+                 << " with residual " << arg2
+                 << ": the residual was only reduced by a factor of " << arg3
+                 << " per step. The low-precision inverse is not accurate "
+                 << "enough for this matrix; use it as a preconditioner "
+                 << "for SolverGMRES instead.");
+
+protected:
+  /**
+   * Control parameters.
+   */
+  AdditionalData additional_data;
+
+  /**
+   * Summary of the last solve.
+   */
+  ConvergenceReport report;
+};
+
+/*@}*/
+/*----------------------------- Implementation -----------------------------*/
+
+#ifndef DOXYGEN
+
+template <typename InverseType, typename LowPrecisionVectorType>
+inline PreconditionMixedPrecision<InverseType, LowPrecisionVectorType>::
+  PreconditionMixedPrecision(const InverseType &inverse)
+  : inverse(&inverse)
+{}
+
+
+
+template <typename InverseType, typename LowPrecisionVectorType>
+template <typename VectorType>
+inline void
+PreconditionMixedPrecision<InverseType, LowPrecisionVectorType>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  src_low.reinit(src, true);
+  dst_low.reinit(dst, true);
+  src_low = src;
+  inverse->vmult(dst_low, src_low);
+  dst = dst_low;
+}
+
+
+
+template <typename InverseType, typename LowPrecisionVectorType>
+template <typename VectorType>
+inline void
+PreconditionMixedPrecision<InverseType, LowPrecisionVectorType>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  src_low.reinit(src, true);
+  dst_low.reinit(dst, true);
+  src_low = src;
+  inverse->Tvmult(dst_low, src_low);
+  dst = dst_low;
+}
+
+
+
+template <class VectorType>
+inline SolverIterativeRefinement<VectorType>::AdditionalData::AdditionalData(
+  const double       stagnation_factor,
+  const unsigned int n_stagnation_steps)
+  : stagnation_factor(stagnation_factor)
+  , n_stagnation_steps(n_stagnation_steps)
+{}
+
+
+
+template <class VectorType>
+SolverIterativeRefinement<VectorType>::SolverIterativeRefinement(
+  SolverControl &           cn,
+  VectorMemory<VectorType> &mem,
+  const AdditionalData &    data)
+  : SolverBase<VectorType>(cn, mem)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+SolverIterativeRefinement<VectorType>::SolverIterativeRefinement(
+  SolverControl &       cn,
+  const AdditionalData &data)
+  : SolverBase<VectorType>(cn)
+  , additional_data(data)
+{}
+
+
+
+template <class VectorType>
+template <typename MatrixType, typename InverseType>
+void
+SolverIterativeRefinement<VectorType>::solve(const MatrixType & A,
+                                             VectorType &       x,
+                                             const VectorType & b,
+                                             const InverseType &inverse)
+{
+  SolverControl::State conv = SolverControl::iterate;
+
+  report = ConvergenceReport();
+
+  // Memory allocation.
+  // 'Vr' holds the residual, 'Vd' the correction
+  typename VectorMemory<VectorType>::Pointer Vr(this->memory);
+  typename VectorMemory<VectorType>::Pointer Vd(this->memory);
+
+  VectorType &r = *Vr;
+  r.reinit(x);
+
+  VectorType &d = *Vd;
+  d.reinit(x);
+
+  LogStream::Prefix prefix("IterativeRefinement");
+
+  unsigned int iter                = 0;
+  unsigned int n_stagnation_steps  = 0;
+  double       residual            = 0.;
+  double       previous_residual   = 0.;
+  bool         stagnation_detected = false;
+
+  // Main loop
+  while (conv == SolverControl::iterate)
+    {
+      // residual in the precision of the outer vectors
+      A.vmult(r, x);
+      r.sadd(-1., 1., b);
+
+      residual = r.l2_norm();
+      if (iter == 0)
+        report.initial_residual = residual;
+      else
+        {
+          report.last_contraction =
+            previous_residual > 0. ? residual / previous_residual : 0.;
+          if (report.last_contraction > additional_data.stagnation_factor)
+            ++n_stagnation_steps;
+          else
+            n_stagnation_steps = 0;
+        }
+
+      conv = this->iteration_status(iter, residual, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      if (iter > 0 && n_stagnation_steps >= additional_data.n_stagnation_steps)
+        {
+          stagnation_detected = true;
+          break;
+        }
+
+      // correction by the inexact inverse
+      inverse.vmult(d, r);
+      x += d;
+
+      previous_residual = residual;
+      ++iter;
+    }
+
+  report.n_steps        = iter;
+  report.final_residual = residual;
+  report.stagnated      = stagnation_detected;
+  if (iter > 0 && report.initial_residual > 0.)
+    report.average_contraction =
+      std::pow(residual / report.initial_residual, 1. / iter);
+
+  AssertThrow(stagnation_detected == false,
+              ExcRefinementStagnated(iter,
+                                     residual,
+                                     report.last_contraction));
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(iter, residual));
+  // otherwise exit as normal
+}
+
+
+
+template <class VectorType>
+inline const typename SolverIterativeRefinement<VectorType>::ConvergenceReport &
+SolverIterativeRefinement<VectorType>::get_convergence_report() const
+{
+  return report;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
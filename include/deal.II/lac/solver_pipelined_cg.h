@@ -0,0 +1,485 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_solver_pipelined_cg_h
+#define dealii_solver_pipelined_cg_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/memory_space.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
+
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/vector_operations_internal.h>
+
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+// forward declaration
+#ifndef DOXYGEN
+namespace LinearAlgebra
+{
+  namespace distributed
+  {
+    template <typename, typename>
+    class Vector;
+  } // namespace distributed
+} // namespace LinearAlgebra
+#endif
+
+
+/*!@addtogroup Solvers */
+/*@{*/
+
+/**
+ * This class implements the pipelined variant of the preconditioned
+ * Conjugate Gradients method due to P. Ghysels and W. Vanroose, "Hiding
+ * global synchronization latency in the preconditioned Conjugate Gradient
+ * algorithm", Parallel Computing 40 (2014), pp. 224-238.
+ *
+ * In the standard CG method implemented by SolverCG, each iteration contains
+ * two global reductions that depend on each other and on the result of the
+ * matrix-vector product. On large parallel machines, the latency of these
+ * reductions can dominate the run time of an iteration. The pipelined
+ * variant rearranges the recurrences such that all three inner products of
+ * an iteration, $\gamma = (r,u)$ with the preconditioned residual $u=Pr$,
+ * $\delta = (w,u)$ with $w=Au$, and the squared residual norm $(r,r)$, can
+ * be computed at once. They are summed over all processes by a single
+ * non-blocking reduction (see Utilities::MPI::isum()) that runs while the
+ * preconditioner and the matrix-vector product of the iteration are
+ * applied. In exact arithmetic, the iterates are the same as the ones of
+ * SolverCG.
+ *
+ * This comes at a price: the solver needs ten vectors instead of four, and
+ * each iteration does eight vector updates instead of three. Furthermore,
+ * the residual is updated by a longer recurrence, so the residual norm
+ * used for the convergence check can drift further away from the true
+ * residual $b-Ax$ than with SolverCG. Tight tolerances close to machine
+ * accuracy may therefore not be reached. The method pays off if the
+ * global reductions, rather than the operator application or the memory
+ * bandwidth, limit the iteration, i.e., for many processes with little
+ * work per process.
+ *
+ * If @p VectorType is LinearAlgebra::distributed::Vector on the host, all
+ * eight vector updates and the three local inner products are done in a
+ * single sweep over the vectors. For other vector types, the solver uses
+ * the individual vector operations and blocking inner products, so it
+ * works, but does not hide any latency.
+ *
+ * The interface of this class is the same as for SolverCG: convergence is
+ * monitored by a SolverControl object (the residual norm of the step is
+ * only available once the reduction has completed, i.e., after the operator
+ * of the step has been applied), and the CG coefficients, eigenvalue and
+ * condition number estimates can be obtained through the slots
+ * connect_coefficients_slot(), connect_eigenvalues_slot() and
+ * connect_condition_number_slot(). The preconditioner must be symmetric.
+ */
+template <typename VectorType = Vector<double>>
+class SolverPipelinedCG : public SolverCG<VectorType>
+{
+public:
+  /**
+   * Declare type for container size.
+   */
+  using size_type = types::global_dof_index;
+
+  /**
+   * Additional data of the solver. The same as for SolverCG.
+   */
+  using AdditionalData = typename SolverCG<VectorType>::AdditionalData;
+
+  /**
+   * Constructor.
+   */
+  SolverPipelinedCG(SolverControl &           cn,
+                    VectorMemory<VectorType> &mem,
+                    const AdditionalData &    data = AdditionalData());
+
+  /**
+   * Constructor. Use an object of type GrowingVectorMemory as a default to
+   * allocate memory.
+   */
+  SolverPipelinedCG(SolverControl &       cn,
+                    const AdditionalData &data = AdditionalData());
+
+  /**
+   * Virtual destructor.
+   */
+  virtual ~SolverPipelinedCG() override = default;
+
+  /**
+   * Solve the linear system $Ax=b$ for x.
+   */
+  template <typename MatrixType, typename PreconditionerType>
+  void
+  solve(const MatrixType &        A,
+        VectorType &              x,
+        const VectorType &        b,
+        const PreconditionerType &preconditioner);
+};
+
+/*@}*/
+
+/*------------------------- Implementation ----------------------------*/
+
+#ifndef DOXYGEN
+
+namespace internal
+{
+  namespace SolverPipelinedCG
+  {
+    /**
+     * The vectors of the pipelined CG iteration, named as in the paper by
+     * Ghysels and Vanroose: r is the residual, u = P r, w = A u, m = P w,
+     * n = A m, and p, s, q, z are the search direction and its images
+     * under A, P A, and A P A.
+     */
+    template <typename VectorType>
+    struct IterationVectors
+    {
+      VectorType &x;
+      VectorType &r;
+      VectorType &u;
+      VectorType &w;
+      VectorType &m;
+      VectorType &n;
+      VectorType &p;
+      VectorType &s;
+      VectorType &q;
+      VectorType &z;
+    };
+
+
+
+    /**
+     * Unless @p update is false, update the search directions, the solution
+     * and the residual vectors with the coefficients @p alpha and @p beta.
+     * Then start the computation of the inner products (r,u), (w,u), and
+     * (r,r), which are available in @p dots once @p request has completed.
+     * The vector @p chunk_sums is scratch memory kept across iterations.
+     *
+     * This is the generic version that works for all vector types. It uses
+     * blocking inner products, so @p request is always MPI_REQUEST_NULL.
+     */
+    template <typename VectorType>
+    void
+    update_vectors_and_start_reduction(
+      const typename VectorType::value_type alpha,
+      const typename VectorType::value_type beta,
+      const bool                            update,
+      IterationVectors<VectorType> &        vectors,
+      typename VectorType::value_type (&dots)[3],
+      MPI_Request &request,
+      std::vector<typename VectorType::value_type> &)
+    {
+      if (update)
+        {
+          vectors.z.sadd(beta, 1., vectors.n);
+          vectors.q.sadd(beta, 1., vectors.m);
+          vectors.s.sadd(beta, 1., vectors.w);
+          vectors.p.sadd(beta, 1., vectors.u);
+          vectors.x.add(alpha, vectors.p);
+          vectors.r.add(-alpha, vectors.s);
+          vectors.u.add(-alpha, vectors.q);
+          vectors.w.add(-alpha, vectors.z);
+        }
+
+      dots[0] = vectors.r * vectors.u;
+      dots[1] = vectors.w * vectors.u;
+      dots[2] = vectors.r * vectors.r;
+      request = MPI_REQUEST_NULL;
+    }
+
+
+
+    /**
+     * Same as above, but for LinearAlgebra::distributed::Vector on the host,
+     * where all updates and the local inner products are done in a single
+     * sweep, and the global sum runs as a non-blocking reduction. The partial
+     * sums of the threads are added in a fixed order.
+     */
+    template <typename Number>
+    void
+    update_vectors_and_start_reduction(
+      const Number alpha,
+      const Number beta,
+      const bool   update,
+      IterationVectors<
+        LinearAlgebra::distributed::Vector<Number, MemorySpace::Host>>
+        &vectors,
+      Number (&dots)[3],
+      MPI_Request &        request,
+      std::vector<Number> &chunk_sums)
+    {
+      Number *const       x_values = vectors.x.begin();
+      Number *const       r_values = vectors.r.begin();
+      Number *const       u_values = vectors.u.begin();
+      Number *const       w_values = vectors.w.begin();
+      const Number *const m_values = vectors.m.begin();
+      const Number *const n_values = vectors.n.begin();
+      Number *const       p_values = vectors.p.begin();
+      Number *const       s_values = vectors.s.begin();
+      Number *const       q_values = vectors.q.begin();
+      Number *const       z_values = vectors.z.begin();
+
+      internal::VectorOperations::parallel_chunked_sum(
+        vectors.r.locally_owned_size(),
+        3,
+        [&](const unsigned int begin,
+            const unsigned int end,
+            Number *           local_dots) {
+          for (unsigned int j = begin; j < end; ++j)
+            {
+              Number r_j = r_values[j];
+              Number u_j = u_values[j];
+              Number w_j = w_values[j];
+              if (update)
+                {
+                  const Number z_j = n_values[j] + beta * z_values[j];
+                  const Number q_j = m_values[j] + beta * q_values[j];
+                  const Number s_j = w_j + beta * s_values[j];
+                  const Number p_j = u_j + beta * p_values[j];
+                  z_values[j]      = z_j;
+                  q_values[j]      = q_j;
+                  s_values[j]      = s_j;
+                  p_values[j]      = p_j;
+                  x_values[j] += alpha * p_j;
+                  r_j -= alpha * s_j;
+                  u_j -= alpha * q_j;
+                  w_j -= alpha * z_j;
+                  r_values[j] = r_j;
+                  u_values[j] = u_j;
+                  w_values[j] = w_j;
+                }
+              local_dots[0] += r_j * u_j;
+              local_dots[1] += w_j * u_j;
+              local_dots[2] += r_j * r_j;
+            }
+        },
+        dots,
+        chunk_sums);
+
+      Utilities::MPI::isum(ArrayView<const Number>(dots, 3),
+                           vectors.r.get_mpi_communicator(),
+                           ArrayView<Number>(dots, 3),
+                           request);
+    }
+
+
+
+    /**
+     * Wait for the reduction started by
+     * update_vectors_and_start_reduction().
+     */
+    inline void
+    wait_for_reduction(MPI_Request &request)
+    {
+#  ifdef DEAL_II_WITH_MPI
+      if (request != MPI_REQUEST_NULL)
+        {
+          const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#  else
+      (void)request;
+#  endif
+    }
+  } // namespace SolverPipelinedCG
+} // namespace internal
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &cn,
+                                                 VectorMemory<VectorType> &mem,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, mem, data)
+{}
+
+
+
+template <typename VectorType>
+SolverPipelinedCG<VectorType>::SolverPipelinedCG(SolverControl &       cn,
+                                                 const AdditionalData &data)
+  : SolverCG<VectorType>(cn, data)
+{}
+
+
+
+template <typename VectorType>
+template <typename MatrixType, typename PreconditionerType>
+void
+SolverPipelinedCG<VectorType>::solve(const MatrixType &        A,
+                                     VectorType &              x,
+                                     const VectorType &        b,
+                                     const PreconditionerType &preconditioner)
+{
+  using number = typename VectorType::value_type;
+
+  SolverControl::State conv = SolverControl::iterate;
+
+  LogStream::Prefix prefix("pipelined_cg");
+
+  // Memory allocation
+  typename VectorMemory<VectorType>::Pointer r_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer u_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer w_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer m_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer n_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer p_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer s_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer q_pointer(this->memory);
+  typename VectorMemory<VectorType>::Pointer z_pointer(this->memory);
+
+  internal::SolverPipelinedCG::IterationVectors<VectorType> vectors{
+    x,
+    *r_pointer,
+    *u_pointer,
+    *w_pointer,
+    *m_pointer,
+    *n_pointer,
+    *p_pointer,
+    *s_pointer,
+    *q_pointer,
+    *z_pointer};
+
+  // the search directions are multiplied by beta=0 in the first iteration,
+  // so they must not contain garbage
+  vectors.r.reinit(x, true);
+  vectors.u.reinit(x, true);
+  vectors.w.reinit(x, true);
+  vectors.m.reinit(x, true);
+  vectors.n.reinit(x, true);
+  vectors.p.reinit(x);
+  vectors.s.reinit(x);
+  vectors.q.reinit(x);
+  vectors.z.reinit(x);
+
+  // Should we build the matrix for eigenvalue computations?
+  const bool do_eigenvalues = !this->condition_number_signal.empty() ||
+                              !this->all_condition_numbers_signal.empty() ||
+                              !this->eigenvalues_signal.empty() ||
+                              !this->all_eigenvalues_signal.empty();
+
+  // vectors used for eigenvalue computations
+  std::vector<number> diagonal;
+  std::vector<number> offdiagonal;
+
+  number eigen_beta_alpha = 0;
+
+  // compute residual r = b - A x, u = P r, w = A u. If x is zero,
+  // short-circuit the matrix-vector product.
+  if (!x.all_zero())
+    {
+      A.vmult(vectors.r, x);
+      vectors.r.sadd(-1., 1., b);
+    }
+  else
+    vectors.r = b;
+  preconditioner.vmult(vectors.u, vectors.r);
+  A.vmult(vectors.w, vectors.u);
+
+  number              dots[3];
+  MPI_Request         request = MPI_REQUEST_NULL;
+  std::vector<number> chunk_sums;
+  internal::SolverPipelinedCG::update_vectors_and_start_reduction(
+    number(), number(), false, vectors, dots, request, chunk_sums);
+
+  int    it            = 0;
+  number alpha         = number();
+  number previous_dot  = number();
+  double residual_norm = 0.;
+
+  while (true)
+    {
+      // apply the preconditioner and the matrix while the inner products
+      // are summed up
+      preconditioner.vmult(vectors.m, vectors.w);
+      A.vmult(vectors.n, vectors.m);
+
+      internal::SolverPipelinedCG::wait_for_reduction(request);
+
+      const number residual_dot_u = dots[0];
+      const number w_dot_u        = dots[1];
+      residual_norm               = std::sqrt(std::abs(dots[2]));
+
+      conv = this->iteration_status(it, residual_norm, x);
+      if (conv != SolverControl::iterate)
+        break;
+
+      const number old_alpha = alpha;
+      number       beta      = number();
+      if (it > 0)
+        {
+          Assert(std::abs(previous_dot) != 0., ExcDivideByZero());
+          beta = residual_dot_u / previous_dot;
+          const number denominator =
+            w_dot_u - beta * residual_dot_u / old_alpha;
+          Assert(std::abs(denominator) != 0., ExcDivideByZero());
+          alpha = residual_dot_u / denominator;
+        }
+      else
+        {
+          Assert(std::abs(w_dot_u) != 0., ExcDivideByZero());
+          alpha = residual_dot_u / w_dot_u;
+        }
+      previous_dot = residual_dot_u;
+
+      if (it > 0)
+        {
+          this->coefficients_signal(old_alpha, beta);
+          // set up the vectors containing the diagonal and the off diagonal of
+          // the projected matrix.
+          if (do_eigenvalues)
+            {
+              diagonal.push_back(number(1.) / old_alpha + eigen_beta_alpha);
+              eigen_beta_alpha = beta / old_alpha;
+              offdiagonal.push_back(std::sqrt(beta) / old_alpha);
+            }
+          this->compute_eigs_and_cond(diagonal,
+                                      offdiagonal,
+                                      this->all_eigenvalues_signal,
+                                      this->all_condition_numbers_signal);
+        }
+
+      internal::SolverPipelinedCG::update_vectors_and_start_reduction(
+        alpha, beta, true, vectors, dots, request, chunk_sums);
+
+      ++it;
+      this->print_vectors(it, x, vectors.r, vectors.p);
+    }
+
+  this->compute_eigs_and_cond(diagonal,
+                              offdiagonal,
+                              this->eigenvalues_signal,
+                              this->condition_number_signal);
+
+  // in case of failure: throw exception
+  if (conv != SolverControl::success)
+    AssertThrow(false, SolverControl::NoConvergence(it, residual_norm));
+  // otherwise exit as normal
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
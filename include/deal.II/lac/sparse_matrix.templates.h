@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <numeric>
@@ -482,27 +483,56 @@ namespace internal
 {
   namespace SparseMatrixImplementation
   {
+    /**
+     * Return the column index of an entry of a sparsity pattern stored as
+     * global column index.
+     */
+    inline size_type
+    column_index(const size_type /*row*/, const size_type column)
+    {
+      return column;
+    }
+
+
+
+    /**
+     * Return the column index of an entry of a sparsity pattern stored as
+     * offset relative to the row, see
+     * SparsityPattern::compress_column_indices().
+     */
+    inline size_type
+    column_index(const size_type row, const std::int32_t offset)
+    {
+      return static_cast<size_type>(static_cast<std::int64_t>(row) + offset);
+    }
+
+
+
     /**
      * Perform a vmult using the SparseMatrix data structures, but only using
-     * a subinterval for the row indices.
+     * a subinterval for the row indices. The column indices are either given
+     * as global indices or as 32-bit offsets relative to the row.
      *
      * In the sequential case, this function is called on all rows, in the
      * parallel case it may be called on a subrange, at the discretion of the
      * task scheduler.
      */
-    template <typename number, typename InVector, typename OutVector>
+    template <typename number,
+              typename ColumnIndexType,
+              typename InVector,
+              typename OutVector>
     void
-    vmult_on_subrange(const size_type    begin_row,
-                      const size_type    end_row,
-                      const number *     values,
-                      const std::size_t *rowstart,
-                      const size_type *  colnums,
-                      const InVector &   src,
-                      OutVector &        dst,
-                      const bool         add)
+    vmult_on_subrange(const size_type        begin_row,
+                      const size_type        end_row,
+                      const number *         values,
+                      const std::size_t *    rowstart,
+                      const ColumnIndexType *colnums,
+                      const InVector &       src,
+                      OutVector &            dst,
+                      const bool             add)
     {
       const number *               val_ptr    = &values[rowstart[begin_row]];
-      const size_type *            colnum_ptr = &colnums[rowstart[begin_row]];
+      const ColumnIndexType *      colnum_ptr = &colnums[rowstart[begin_row]];
       typename OutVector::iterator dst_ptr    = dst.begin() + begin_row;
 
       if (add == false)
@@ -512,7 +542,8 @@ namespace internal
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
               s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+                   typename OutVector::value_type(
+                     src(column_index(row, *colnum_ptr++)));
             *dst_ptr++ = s;
           }
       else
@@ -522,10 +553,70 @@ namespace internal
             const number *const val_end_of_row = &values[rowstart[row + 1]];
             while (val_ptr != val_end_of_row)
               s += typename OutVector::value_type(*val_ptr++) *
-                   typename OutVector::value_type(src(*colnum_ptr++));
+                   typename OutVector::value_type(
+                     src(column_index(row, *colnum_ptr++)));
             *dst_ptr++ = s;
           }
     }
+
+
+
+    /**
+     * Add the product of the transpose of the matrix given by the
+     * SparseMatrix data structures with @p src to @p dst, with the column
+     * indices given either as global indices or as offsets relative to the
+     * row.
+     */
+    template <typename number,
+              typename ColumnIndexType,
+              typename InVector,
+              typename OutVector>
+    void
+    Tvmult_add(const size_type        n_rows,
+               const number *         values,
+               const std::size_t *    rowstart,
+               const ColumnIndexType *colnums,
+               const InVector &       src,
+               OutVector &            dst)
+    {
+      for (size_type i = 0; i < n_rows; ++i)
+        for (std::size_t j = rowstart[i]; j < rowstart[i + 1]; ++j)
+          {
+            const size_type p = column_index(i, colnums[j]);
+            dst(p) += typename OutVector::value_type(values[j]) *
+                      typename OutVector::value_type(src(i));
+          }
+    }
+
+
+
+    /**
+     * Perform a forward SOR sweep in-place on @p dst using the SparseMatrix
+     * data structures, with the column indices given either as global
+     * indices or as offsets relative to the row.
+     */
+    template <typename number, typename ColumnIndexType, typename somenumber>
+    void
+    SOR(const size_type        n_rows,
+        const number *         values,
+        const std::size_t *    rowstart,
+        const ColumnIndexType *colnums,
+        Vector<somenumber> &   dst,
+        const number           om)
+    {
+      for (size_type row = 0; row < n_rows; ++row)
+        {
+          somenumber s = dst(row);
+          for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+            {
+              const size_type col = column_index(row, colnums[j]);
+              if (col < row)
+                s -= somenumber(values[j]) * dst(col);
+            }
+
+          dst(row) = s * somenumber(om) / somenumber(values[rowstart[row]]);
+        }
+    }
   } // namespace SparseMatrixImplementation
 } // namespace internal
 
@@ -779,15 +870,26 @@ SparseMatrix<number>::vmult(OutVector &dst, const InVector &src) const
     0U,
     m(),
     [this, &src, &dst](const size_type begin_row, const size_type end_row) {
-      internal::SparseMatrixImplementation::vmult_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        src,
-        dst,
-        false);
+      if (cols->column_offsets != nullptr)
+        internal::SparseMatrixImplementation::vmult_on_subrange(
+          begin_row,
+          end_row,
+          val.get(),
+          cols->rowstart.get(),
+          cols->column_offsets.get(),
+          src,
+          dst,
+          false);
+      else
+        internal::SparseMatrixImplementation::vmult_on_subrange(
+          begin_row,
+          end_row,
+          val.get(),
+          cols->rowstart.get(),
+          cols->colnums.get(),
+          src,
+          dst,
+          false);
     },
     internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 }
@@ -808,15 +910,16 @@ SparseMatrix<number>::Tvmult(OutVector &dst, const InVector &src) const
 
   dst = 0;
 
-  for (size_type i = 0; i < m(); ++i)
-    {
-      for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-        {
-          const size_type p = cols->colnums[j];
-          dst(p) += typename OutVector::value_type(val[j]) *
-                    typename OutVector::value_type(src(i));
-        }
-    }
+  if (cols->column_offsets != nullptr)
+    internal::SparseMatrixImplementation::Tvmult_add(m(),
+                                                     val.get(),
+                                                     cols->rowstart.get(),
+                                                     cols->column_offsets.get(),
+                                                     src,
+                                                     dst);
+  else
+    internal::SparseMatrixImplementation::Tvmult_add(
+      m(), val.get(), cols->rowstart.get(), cols->colnums.get(), src, dst);
 }
 
 
@@ -837,15 +940,26 @@ SparseMatrix<number>::vmult_add(OutVector &dst, const InVector &src) const
     0U,
     m(),
     [this, &src, &dst](const size_type begin_row, const size_type end_row) {
-      internal::SparseMatrixImplementation::vmult_on_subrange(
-        begin_row,
-        end_row,
-        val.get(),
-        cols->rowstart.get(),
-        cols->colnums.get(),
-        src,
-        dst,
-        true);
+      if (cols->column_offsets != nullptr)
+        internal::SparseMatrixImplementation::vmult_on_subrange(
+          begin_row,
+          end_row,
+          val.get(),
+          cols->rowstart.get(),
+          cols->column_offsets.get(),
+          src,
+          dst,
+          true);
+      else
+        internal::SparseMatrixImplementation::vmult_on_subrange(
+          begin_row,
+          end_row,
+          val.get(),
+          cols->rowstart.get(),
+          cols->colnums.get(),
+          src,
+          dst,
+          true);
     },
     internal::SparseMatrixImplementation::minimum_parallel_grain_size);
 }
@@ -864,13 +978,16 @@ SparseMatrix<number>::Tvmult_add(OutVector &dst, const InVector &src) const
 
   Assert(!PointerComparison::equal(&src, &dst), ExcSourceEqualsDestination());
 
-  for (size_type i = 0; i < m(); ++i)
-    for (size_type j = cols->rowstart[i]; j < cols->rowstart[i + 1]; ++j)
-      {
-        const size_type p = cols->colnums[j];
-        dst(p) += typename OutVector::value_type(val[j]) *
-                  typename OutVector::value_type(src(i));
-      }
+  if (cols->column_offsets != nullptr)
+    internal::SparseMatrixImplementation::Tvmult_add(m(),
+                                                     val.get(),
+                                                     cols->rowstart.get(),
+                                                     cols->column_offsets.get(),
+                                                     src,
+                                                     dst);
+  else
+    internal::SparseMatrixImplementation::Tvmult_add(
+      m(), val.get(), cols->rowstart.get(), cols->colnums.get(), src, dst);
 }
 
 
@@ -1609,18 +1726,16 @@ SparseMatrix<number>::SOR(Vector<somenumber> &dst, const number om) const
 
   internal::SparseMatrixImplementation::AssertNoZerosOnDiagonal(*this);
 
-  for (size_type row = 0; row < m(); ++row)
-    {
-      somenumber s = dst(row);
-      for (size_type j = cols->rowstart[row]; j < cols->rowstart[row + 1]; ++j)
-        {
-          const size_type col = cols->colnums[j];
-          if (col < row)
-            s -= somenumber(val[j]) * dst(col);
-        }
-
-      dst(row) = s * somenumber(om) / somenumber(val[cols->rowstart[row]]);
-    }
+  if (cols->column_offsets != nullptr)
+    internal::SparseMatrixImplementation::SOR(m(),
+                                              val.get(),
+                                              cols->rowstart.get(),
+                                              cols->column_offsets.get(),
+                                              dst,
+                                              om);
+  else
+    internal::SparseMatrixImplementation::SOR(
+      m(), val.get(), cols->rowstart.get(), cols->colnums.get(), dst, om);
 }
 
 
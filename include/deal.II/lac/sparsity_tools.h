@@ -61,7 +61,18 @@ namespace SparsityTools
     /**
      * Use ZOLTAN partitioner.
      */
-    zoltan
+    zoltan,
+    /**
+     * Use the multilevel graph partitioner built into deal.II, which does
+     * not require any external library. The graph is split by recursive
+     * bisection, where each bisection coarsens the graph by heavy-edge
+     * matching, splits the coarsest graph by growing one of the parts from a
+     * single vertex, and improves the split on the way back to the original
+     * graph by moving single vertices between the two parts as proposed by
+     * Fiduccia and Mattheyses. The weight of each part exceeds its share of
+     * the total weight by at most 3 percent.
+     */
+    multilevel
   };
 
 
@@ -73,9 +84,10 @@ namespace SparsityTools
    * an edge between two nodes in the connection graph. The goal is then to
    * decompose this graph into groups of nodes so that a minimal number of
    * edges are cut by the boundaries between node groups. This partitioning is
-   * done by METIS or ZOLTAN, depending upon which partitioner is chosen
-   * in the fourth argument. The default is METIS. Note that METIS and
-   * ZOLTAN can only partition symmetric sparsity patterns, and that of
+   * done by METIS, ZOLTAN, or the built-in multilevel partitioner,
+   * depending upon which partitioner is chosen in the fourth argument. The
+   * default is METIS. Note that all of these partitioners can only
+   * partition symmetric sparsity patterns, and that of
    * course the sparsity pattern has to be square. We do not check for
    * symmetry of the sparsity pattern, since this is an expensive operation,
    * but rather leave this as the responsibility of caller of this function.
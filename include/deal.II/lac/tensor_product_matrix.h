@@ -20,7 +20,9 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/array_view.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/vectorization.h>
 
 #include <deal.II/lac/lapack_full_matrix.h>
 
@@ -54,10 +56,13 @@ class FullMatrix;
  * matrix (vmult()) and its inverse (apply_inverse()) as described in the
  * main documentation of TensorProductMatrixSymmetricSum.
  *
- * @note This class uses a temporary array for storing intermediate results
- * that is a class member. A mutex is used to protect access to this array and
- * ensure correct results. If several threads run parallel instances of this
- * class, it is recommended that each threads holds its own matrix version.
+ * @note The variants of vmult() and apply_inverse() with two arguments use a
+ * temporary array for storing intermediate results that is a class member. A
+ * mutex is used to protect access to this array and ensure correct results,
+ * which serializes concurrent calls on the same object. If several threads
+ * work with the same matrix, use the variants that take an additional array
+ * for the intermediate results provided by the caller instead, which do not
+ * need a lock.
  *
  * @tparam dim Dimension of the problem. Currently, 1D, 2D, and 3D codes are
  * implemented.
@@ -102,6 +107,12 @@ public:
   unsigned int
   n() const;
 
+  /**
+   * Return the memory consumption of this object in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
   /**
    * Implements a matrix-vector product with the underlying matrix as
    * described in the main documentation of TensorProductMatrixSymmetricSum.
@@ -121,6 +132,30 @@ public:
   apply_inverse(const ArrayView<Number> &      dst,
                 const ArrayView<const Number> &src) const;
 
+  /**
+   * Same as vmult() above, but with the temporary array @p tmp for
+   * intermediate results provided by the caller, which is resized as
+   * necessary. This function does not access any mutable state of this
+   * object, so several threads may call it concurrently on the same object
+   * as long as each one passes its own @p tmp, e.g., from a
+   * Threads::ThreadLocalStorage object.
+   */
+  void
+  vmult(const ArrayView<Number> &      dst,
+        const ArrayView<const Number> &src,
+        AlignedVector<Number> &        tmp) const;
+
+  /**
+   * Same as apply_inverse() above, but with the temporary array @p tmp for
+   * intermediate results provided by the caller, which is resized as
+   * necessary. Like the respective vmult() function, this function can be
+   * called concurrently on the same object with different arrays @p tmp.
+   */
+  void
+  apply_inverse(const ArrayView<Number> &      dst,
+                const ArrayView<const Number> &src,
+                AlignedVector<Number> &        tmp) const;
+
 protected:
   /**
    * Default constructor.
@@ -304,6 +339,27 @@ public:
   reinit(const Table<2, Number> &mass_matrix,
          const Table<2, Number> &derivative_matrix);
 
+  /**
+   * Apply the inverses of all matrices in @p matrices, e.g., the local
+   * solvers of the patches of an additive Schwarz method, to the vectors in
+   * @p src and write the results into @p dst. The vectors are stored one
+   * after the other, i.e., the vector of the matrix with index $i$ occupies
+   * the entries $[i\cdot m, (i+1) \cdot m)$, where $m$ is the size of the
+   * matrices, which must be the same for all matrices.
+   *
+   * The matrices are processed in groups of VectorizedArray<Number>::size(),
+   * with the data of each matrix of a group in one lane of a
+   * VectorizedArray, so that the tensor product kernels run at full SIMD
+   * width even though each matrix is a scalar one. The groups are
+   * distributed among the available threads, each using its own temporary
+   * arrays.
+   */
+  static void
+  apply_inverse_batched(
+    const ArrayView<const TensorProductMatrixSymmetricSum> &matrices,
+    const ArrayView<Number> &                               dst,
+    const ArrayView<const Number> &                         src);
+
 private:
   /**
    * A generic implementation of all reinit() functions based on
@@ -452,6 +508,156 @@ namespace internal
       for (unsigned int i = 0; i < n_rows; ++i, ++eigenvalues)
         *eigenvalues = deriv_copy.eigenvalue(i).real();
     }
+
+
+
+    /**
+     * Compute the product of the tensor product matrix defined by the 1D
+     * matrices @p mass_matrices and @p derivative_matrices of size
+     * @p n_rows with @p src, see the main documentation of
+     * TensorProductMatrixSymmetricSum, and write the result into @p dst. The
+     * array @p t needs to provide space for twice the size of the vectors.
+     */
+    template <int n_rows_1d, std::size_t dim, typename Number>
+    void
+    vmult(const std::array<const Number *, dim> &mass_matrices,
+          const std::array<const Number *, dim> &derivative_matrices,
+          const unsigned int                     n_rows,
+          Number *                               t,
+          const Number *                         src,
+          Number *                               dst)
+    {
+      const unsigned int n           = Utilities::fixed_power<dim>(n_rows);
+      constexpr int      kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+        eval(AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             AlignedVector<Number>{},
+             n_rows,
+             n_rows);
+
+      if (dim == 1)
+        {
+          const Number *A = derivative_matrices[0];
+          eval.template apply<0, false, false>(A, src, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *A0 = derivative_matrices[0];
+          const Number *M0 = mass_matrices[0];
+          const Number *A1 = derivative_matrices[1];
+          const Number *M1 = mass_matrices[1];
+          eval.template apply<0, false, false>(M0, src, t);
+          eval.template apply<1, false, false>(A1, t, dst);
+          eval.template apply<0, false, false>(A0, src, t);
+          eval.template apply<1, false, true>(M1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *A0 = derivative_matrices[0];
+          const Number *M0 = mass_matrices[0];
+          const Number *A1 = derivative_matrices[1];
+          const Number *M1 = mass_matrices[1];
+          const Number *A2 = derivative_matrices[2];
+          const Number *M2 = mass_matrices[2];
+          eval.template apply<0, false, false>(M0, src, t + n);
+          eval.template apply<1, false, false>(M1, t + n, t);
+          eval.template apply<2, false, false>(A2, t, dst);
+          eval.template apply<1, false, false>(A1, t + n, t);
+          eval.template apply<0, false, false>(A0, src, t + n);
+          eval.template apply<1, false, true>(M1, t + n, t);
+          eval.template apply<2, false, true>(M2, t, dst);
+        }
+
+      else
+        AssertThrow(false, ExcNotImplemented());
+    }
+
+
+
+    /**
+     * Apply the inverse of the tensor product matrix defined by the
+     * generalized eigenvectors @p eigenvectors and eigenvalues
+     * @p eigenvalues of the 1D problems of size @p n to @p src, see the main
+     * documentation of TensorProductMatrixSymmetricSum, and write the result
+     * into @p dst. The array @p t needs to provide space for the size of the
+     * vectors.
+     */
+    template <int n_rows_1d, std::size_t dim, typename Number>
+    void
+    apply_inverse(const std::array<const Number *, dim> &eigenvectors,
+                  const std::array<const Number *, dim> &eigenvalues,
+                  const unsigned int                     n,
+                  Number *                               t,
+                  const Number *                         src,
+                  Number *                               dst)
+    {
+      constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
+      internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                       dim,
+                                       kernel_size,
+                                       kernel_size,
+                                       Number>
+        eval(AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             AlignedVector<Number>(),
+             n,
+             n);
+
+      // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
+      //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
+      //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
+      //       while the eigenvectors are stored column-wise in S, i.e.
+      //       rows correspond to dofs whereas columns to eigenvalue indices!
+      if (dim == 1)
+        {
+          const Number *S = eigenvectors[0];
+          eval.template apply<0, true, false>(S, src, t);
+          for (unsigned int i = 0; i < n; ++i)
+            t[i] /= eigenvalues[0][i];
+          eval.template apply<0, false, false>(S, t, dst);
+        }
+
+      else if (dim == 2)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
+            for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+              dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, dst, t);
+          eval.template apply<1, false, false>(S1, t, dst);
+        }
+
+      else if (dim == 3)
+        {
+          const Number *S0 = eigenvectors[0];
+          const Number *S1 = eigenvectors[1];
+          const Number *S2 = eigenvectors[2];
+          eval.template apply<0, true, false>(S0, src, t);
+          eval.template apply<1, true, false>(S1, t, dst);
+          eval.template apply<2, true, false>(S2, dst, t);
+          for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
+            for (unsigned int i1 = 0; i1 < n; ++i1)
+              for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
+                t[c] /= (eigenvalues[2][i2] + eigenvalues[1][i1] +
+                         eigenvalues[0][i0]);
+          eval.template apply<0, false, false>(S0, t, dst);
+          eval.template apply<1, false, false>(S1, dst, t);
+          eval.template apply<2, false, false>(S2, t, dst);
+        }
+
+      else
+        Assert(false, ExcNotImplemented());
+    }
   } // namespace TensorProductMatrix
 } // namespace internal
 
@@ -480,70 +686,70 @@ TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::n() const
 
 
 
+template <int dim, typename Number, int n_rows_1d>
+inline std::size_t
+TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::
+  memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + tmp_array.memory_consumption();
+  for (unsigned int d = 0; d < dim; ++d)
+    memory += mass_matrix[d].memory_consumption() +
+              derivative_matrix[d].memory_consumption() +
+              eigenvalues[d].memory_consumption() +
+              eigenvectors[d].memory_consumption();
+  return memory;
+}
+
+
+
 template <int dim, typename Number, int n_rows_1d>
 inline void
 TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
   const ArrayView<Number> &      dst_view,
   const ArrayView<const Number> &src_view) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  vmult(dst_view, src_view, tmp_array);
+}
+
+
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::vmult(
+  const ArrayView<Number> &      dst_view,
+  const ArrayView<const Number> &src_view,
+  AlignedVector<Number> &        tmp) const
 {
   AssertDimension(dst_view.size(), this->m());
   AssertDimension(src_view.size(), this->n());
-  std::lock_guard<std::mutex> lock(this->mutex);
-  const unsigned int          n = Utilities::fixed_power<dim>(
-    n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size());
-  tmp_array.resize_fast(n * 2);
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         AlignedVector<Number>{},
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.begin();
-  Number *      dst = dst_view.data();
-
-  if (dim == 1)
-    {
-      const Number *A = &derivative_matrix[0](0, 0);
-      eval.template apply<0, false, false>(A, src, dst);
-    }
+  const unsigned int n_rows = mass_matrix[0].n_rows();
+  tmp.resize_fast(Utilities::fixed_power<dim>(n_rows) * 2);
 
-  else if (dim == 2)
+  std::array<const Number *, dim> mass_matrices, derivative_matrices;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      eval.template apply<0, false, false>(M0, src, t);
-      eval.template apply<1, false, false>(A1, t, dst);
-      eval.template apply<0, false, false>(A0, src, t);
-      eval.template apply<1, false, true>(M1, t, dst);
+      mass_matrices[d]       = &mass_matrix[d](0, 0);
+      derivative_matrices[d] = &derivative_matrix[d](0, 0);
     }
+  internal::TensorProductMatrix::vmult<n_rows_1d>(mass_matrices,
+                                                  derivative_matrices,
+                                                  n_rows,
+                                                  tmp.begin(),
+                                                  src_view.data(),
+                                                  dst_view.data());
+}
 
-  else if (dim == 3)
-    {
-      const Number *A0 = &derivative_matrix[0](0, 0);
-      const Number *M0 = &mass_matrix[0](0, 0);
-      const Number *A1 = &derivative_matrix[1](0, 0);
-      const Number *M1 = &mass_matrix[1](0, 0);
-      const Number *A2 = &derivative_matrix[2](0, 0);
-      const Number *M2 = &mass_matrix[2](0, 0);
-      eval.template apply<0, false, false>(M0, src, t + n);
-      eval.template apply<1, false, false>(M1, t + n, t);
-      eval.template apply<2, false, false>(A2, t, dst);
-      eval.template apply<1, false, false>(A1, t + n, t);
-      eval.template apply<0, false, false>(A0, src, t + n);
-      eval.template apply<1, false, true>(M1, t + n, t);
-      eval.template apply<2, false, true>(M2, t, dst);
-    }
 
-  else
-    AssertThrow(false, ExcNotImplemented());
+
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
+  const ArrayView<Number> &      dst_view,
+  const ArrayView<const Number> &src_view) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  apply_inverse(dst_view, src_view, tmp_array);
 }
 
 
@@ -552,75 +758,26 @@ template <int dim, typename Number, int n_rows_1d>
 inline void
 TensorProductMatrixSymmetricSumBase<dim, Number, n_rows_1d>::apply_inverse(
   const ArrayView<Number> &      dst_view,
-  const ArrayView<const Number> &src_view) const
+  const ArrayView<const Number> &src_view,
+  AlignedVector<Number> &        tmp) const
 {
   AssertDimension(dst_view.size(), this->n());
   AssertDimension(src_view.size(), this->m());
-  std::lock_guard<std::mutex> lock(this->mutex);
   const unsigned int n = n_rows_1d > 0 ? n_rows_1d : eigenvalues[0].size();
-  tmp_array.resize_fast(Utilities::fixed_power<dim>(n));
-  constexpr int kernel_size = n_rows_1d > 0 ? n_rows_1d : 0;
-  internal::EvaluatorTensorProduct<internal::evaluate_general,
-                                   dim,
-                                   kernel_size,
-                                   kernel_size,
-                                   Number>
-                eval(AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         AlignedVector<Number>(),
-         mass_matrix[0].n_rows(),
-         mass_matrix[0].n_rows());
-  Number *      t   = tmp_array.begin();
-  const Number *src = src_view.data();
-  Number *      dst = dst_view.data();
-
-  // NOTE: dof_to_quad has to be interpreted as 'dof to eigenvalue index'
-  //       --> apply<.,true,.> (S,src,dst) calculates dst = S^T * src,
-  //       --> apply<.,false,.> (S,src,dst) calculates dst = S * src,
-  //       while the eigenvectors are stored column-wise in S, i.e.
-  //       rows correspond to dofs whereas columns to eigenvalue indices!
-  if (dim == 1)
-    {
-      const Number *S = &eigenvectors[0](0, 0);
-      eval.template apply<0, true, false>(S, src, t);
-      for (unsigned int i = 0; i < n; ++i)
-        t[i] /= eigenvalues[0][i];
-      eval.template apply<0, false, false>(S, t, dst);
-    }
+  tmp.resize_fast(Utilities::fixed_power<dim>(n));
 
-  else if (dim == 2)
+  std::array<const Number *, dim> eigenvector_ptrs, eigenvalue_ptrs;
+  for (unsigned int d = 0; d < dim; ++d)
     {
-      const Number *S0 = &(eigenvectors[0](0, 0));
-      const Number *S1 = &(eigenvectors[1](0, 0));
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      for (unsigned int i1 = 0, c = 0; i1 < n; ++i1)
-        for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-          dst[c] /= (eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, dst, t);
-      eval.template apply<1, false, false>(S1, t, dst);
+      eigenvector_ptrs[d] = &eigenvectors[d](0, 0);
+      eigenvalue_ptrs[d]  = eigenvalues[d].begin();
     }
-
-  else if (dim == 3)
-    {
-      const Number *S0 = &eigenvectors[0](0, 0);
-      const Number *S1 = &eigenvectors[1](0, 0);
-      const Number *S2 = &eigenvectors[2](0, 0);
-      eval.template apply<0, true, false>(S0, src, t);
-      eval.template apply<1, true, false>(S1, t, dst);
-      eval.template apply<2, true, false>(S2, dst, t);
-      for (unsigned int i2 = 0, c = 0; i2 < n; ++i2)
-        for (unsigned int i1 = 0; i1 < n; ++i1)
-          for (unsigned int i0 = 0; i0 < n; ++i0, ++c)
-            t[c] /=
-              (eigenvalues[2][i2] + eigenvalues[1][i1] + eigenvalues[0][i0]);
-      eval.template apply<0, false, false>(S0, t, dst);
-      eval.template apply<1, false, false>(S1, dst, t);
-      eval.template apply<2, false, false>(S2, t, dst);
-    }
-
-  else
-    Assert(false, ExcNotImplemented());
+  internal::TensorProductMatrix::apply_inverse<n_rows_1d>(eigenvector_ptrs,
+                                                          eigenvalue_ptrs,
+                                                          n,
+                                                          tmp.begin(),
+                                                          src_view.data(),
+                                                          dst_view.data());
 }
 
 
@@ -754,6 +911,94 @@ TensorProductMatrixSymmetricSum<dim, Number, n_rows_1d>::reinit(
 
 
 
+template <int dim, typename Number, int n_rows_1d>
+inline void
+TensorProductMatrixSymmetricSum<dim, Number, n_rows_1d>::apply_inverse_batched(
+  const ArrayView<const TensorProductMatrixSymmetricSum> &matrices,
+  const ArrayView<Number> &                               dst,
+  const ArrayView<const Number> &                         src)
+{
+  if (matrices.size() == 0)
+    return;
+
+  const unsigned int n =
+    n_rows_1d > 0 ? n_rows_1d : matrices[0].eigenvalues[0].size();
+  const unsigned int n_entries = Utilities::fixed_power<dim>(n);
+  AssertDimension(dst.size(), matrices.size() * n_entries);
+  AssertDimension(src.size(), matrices.size() * n_entries);
+  for (const auto &matrix : matrices)
+    {
+      (void)matrix;
+      AssertDimension(matrix.m(), n_entries);
+    }
+
+  using VectorizedArrayType         = VectorizedArray<Number>;
+  constexpr unsigned int n_lanes    = VectorizedArrayType::size();
+  const unsigned int     n_matrices = matrices.size();
+  const unsigned int     n_batches  = (n_matrices + n_lanes - 1) / n_lanes;
+  const unsigned int     grain_size = 8;
+
+  parallel::apply_to_subranges(
+    0U,
+    n_batches,
+    [&](const unsigned int begin, const unsigned int end) {
+      std::array<Table<2, VectorizedArrayType>, dim>     eigenvectors;
+      std::array<AlignedVector<VectorizedArrayType>, dim> eigenvalues;
+      std::array<const VectorizedArrayType *, dim> eigenvector_ptrs,
+        eigenvalue_ptrs;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          eigenvectors[d].reinit(n, n);
+          eigenvalues[d].resize(n);
+          eigenvector_ptrs[d] = &eigenvectors[d](0, 0);
+          eigenvalue_ptrs[d]  = eigenvalues[d].begin();
+        }
+      AlignedVector<VectorizedArrayType> src_vectorized(n_entries),
+        dst_vectorized(n_entries), tmp(n_entries);
+
+      for (unsigned int batch = begin; batch < end; ++batch)
+        {
+          const unsigned int first = batch * n_lanes;
+          const unsigned int n_filled_lanes =
+            std::min(n_lanes, n_matrices - first);
+
+          // gather the data of the matrices into the lanes. fill unused
+          // lanes with the last matrix to avoid divisions by zero
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const TensorProductMatrixSymmetricSum &matrix =
+                matrices[first + std::min(v, n_filled_lanes - 1)];
+              for (unsigned int d = 0; d < dim; ++d)
+                for (unsigned int i = 0; i < n; ++i)
+                  {
+                    eigenvalues[d][i][v] = matrix.eigenvalues[d][i];
+                    for (unsigned int j = 0; j < n; ++j)
+                      eigenvectors[d](i, j)[v] = matrix.eigenvectors[d](i, j);
+                  }
+              for (unsigned int i = 0; i < n_entries; ++i)
+                src_vectorized[i][v] =
+                  v < n_filled_lanes ? src[(first + v) * n_entries + i] :
+                                       Number();
+            }
+
+          internal::TensorProductMatrix::apply_inverse<n_rows_1d>(
+            eigenvector_ptrs,
+            eigenvalue_ptrs,
+            n,
+            tmp.begin(),
+            src_vectorized.begin(),
+            dst_vectorized.begin());
+
+          for (unsigned int v = 0; v < n_filled_lanes; ++v)
+            for (unsigned int i = 0; i < n_entries; ++i)
+              dst[(first + v) * n_entries + i] = dst_vectorized[i][v];
+        }
+    },
+    grain_size);
+}
+
+
+
 //------------- vectorized spec.: TensorProductMatrixSymmetricSum -------------
 
 template <int dim, typename Number, int n_rows_1d>
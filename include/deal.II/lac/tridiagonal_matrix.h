@@ -31,6 +31,8 @@ DEAL_II_NAMESPACE_OPEN
 #ifndef DOXYGEN
 template <typename number>
 class Vector;
+template <typename number>
+class FullMatrix;
 #endif
 
 /*! @addtogroup Matrix1
@@ -209,6 +211,17 @@ public:
    */
   void
   compute_eigenvalues();
+  /**
+   * Compute the eigenvalues and the eigenvectors of the symmetric tridiagonal
+   * matrix. The eigenvalues are available through eigenvalue() afterwards,
+   * and column @p i of @p eigenvectors contains the normalized eigenvector
+   * of eigenvalue(i).
+   *
+   * @note This function requires configuration of deal.II with LAPACK
+   * support. Additionally, the matrix must use symmetric storage technique.
+   */
+  void
+  compute_eigenvalues(FullMatrix<number> &eigenvectors);
   /**
    * After calling compute_eigenvalues(), you can access each eigenvalue here.
    */
@@ -30,8 +30,10 @@
 #include <deal.II/lac/cuda_kernels.templates.h>
 #include <deal.II/lac/vector_operation.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -1402,6 +1404,108 @@ namespace internal
     }
 
 
+
+    /**
+     * The number of vector entries of the chunks used by
+     * parallel_chunked_sum().
+     */
+    constexpr unsigned int chunked_sum_chunk_size = 512;
+
+
+
+    /**
+     * Compute @p n_results sums over the index range [0, size) in parallel
+     * and in a fixed order. The range is split into chunks of
+     * chunked_sum_chunk_size entries, and @p kernel is called as
+     * <tt>kernel(begin, end, partial_results)</tt> on each chunk, possibly
+     * on several threads at once. The kernel adds the contributions of the
+     * entries [begin, end) to the @p n_results entries of
+     * <tt>partial_results</tt>, which are initialized to zero and belong to
+     * this chunk alone. Afterwards, the partial results of the chunks are
+     * added by pairwise summation like in parallel_reduce() and written to
+     * @p results.
+     *
+     * The partial results are stored in @p chunk_sums, which is enlarged if
+     * necessary. Callers that run this function repeatedly, like the
+     * iterative solvers, should keep this vector between the calls to avoid
+     * allocating memory every time.
+     *
+     * Like parallel_reduce(), this function does not need locks, and as the
+     * layout of the chunks only depends on @p size, the results are the
+     * same bit by bit in every run, independent of the number of threads.
+     * The kernel may also modify vector entries in its chunk, which allows
+     * to merge vector updates with the inner products that follow them.
+     */
+    template <typename Number, typename Kernel>
+    void
+    parallel_chunked_sum(const size_type      size,
+                         const unsigned int   n_results,
+                         const Kernel &       kernel,
+                         Number *             results,
+                         std::vector<Number> &chunk_sums)
+    {
+      const size_type n_chunks =
+        (size + chunked_sum_chunk_size - 1) / chunked_sum_chunk_size;
+
+      // make sure we have space for an even number of chunks, access to the
+      // new last chunk is needed in the pairwise summation below
+      const size_type n_entries = 2 * ((n_chunks + 1) / 2) * n_results;
+      if (chunk_sums.size() < n_entries)
+        chunk_sums.resize(n_entries);
+
+      const auto sum_chunks = [&](const size_type first_chunk,
+                                  const size_type last_chunk) {
+        for (size_type c = first_chunk; c < last_chunk; ++c)
+          {
+            Number *const partial_results = chunk_sums.data() + c * n_results;
+            std::fill(partial_results, partial_results + n_results, Number());
+            kernel(c * chunked_sum_chunk_size,
+                   std::min(size, (c + 1) * chunked_sum_chunk_size),
+                   partial_results);
+          }
+      };
+
+      // only go to the parallel function in case there are at least 4
+      // parallel items as in parallel_reduce(), and use the same grain size,
+      // expressed in chunks
+      if (size >=
+          4 * internal::VectorImplementation::minimum_parallel_grain_size)
+        ::dealii::parallel::apply_to_subranges(
+          size_type(0),
+          n_chunks,
+          sum_chunks,
+          std::max<size_type>(
+            1,
+            internal::VectorImplementation::minimum_parallel_grain_size /
+              chunked_sum_chunk_size));
+      else
+        sum_chunks(0, n_chunks);
+
+      // pairwise summation of the chunks like in TBBReduceFunctor::do_sum()
+      size_type n_remaining = n_chunks;
+      while (n_remaining > 1)
+        {
+          if (n_remaining % 2 == 1)
+            {
+              std::fill(chunk_sums.begin() + n_remaining * n_results,
+                        chunk_sums.begin() + (n_remaining + 1) * n_results,
+                        Number());
+              ++n_remaining;
+            }
+          for (size_type c = 0; c < n_remaining; c += 2)
+            for (unsigned int i = 0; i < n_results; ++i)
+              chunk_sums[c / 2 * n_results + i] =
+                chunk_sums[c * n_results + i] +
+                chunk_sums[(c + 1) * n_results + i];
+          n_remaining /= 2;
+        }
+
+      for (unsigned int i = 0; i < n_results; ++i)
+        results[i] = (n_chunks > 0 ? chunk_sums[i] : Number());
+    }
+
+
+
     template <typename Number, typename Number2, typename MemorySpace>
     struct functions
     {
@@ -176,6 +176,42 @@ namespace internal
 
 
 
+  /**
+   * Specialization for MatrixFreeFunctions::tensor_collapsed_simplex, which
+   * interpolates the simplex basis into a tensor-product basis in collapsed
+   * coordinates and then applies the sum-factorization kernels.
+   */
+  template <int dim, int fe_degree, int n_q_points_1d, typename Number>
+  struct FEEvaluationImpl<MatrixFreeFunctions::tensor_collapsed_simplex,
+                          dim,
+                          fe_degree,
+                          n_q_points_1d,
+                          Number>
+  {
+    static void
+    evaluate(const unsigned int                            n_components,
+             const EvaluationFlags::EvaluationFlags        evaluation_flag,
+             const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+             const Number *                                values_dofs_actual,
+             Number *                                      values_quad,
+             Number *                                      gradients_quad,
+             Number *                                      hessians_quad,
+             Number *                                      scratch_data);
+
+    static void
+    integrate(const unsigned int                            n_components,
+              const EvaluationFlags::EvaluationFlags        integration_flag,
+              const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+              Number *                                      values_dofs_actual,
+              Number *                                      values_quad,
+              Number *                                      gradients_quad,
+              Number *                                      hessians_quad,
+              Number *                                      scratch_data,
+              const bool add_into_values_array);
+  };
+
+
+
   template <MatrixFreeFunctions::ElementType type,
             int                              dim,
             int                              fe_degree,
@@ -928,6 +964,244 @@ namespace internal
 
 
 
+  template <int dim, int fe_degree, int n_q_points_1d, typename Number>
+  inline void
+  FEEvaluationImpl<
+    MatrixFreeFunctions::tensor_collapsed_simplex,
+    dim,
+    fe_degree,
+    n_q_points_1d,
+    Number>::evaluate(const unsigned int                     n_components,
+                      const EvaluationFlags::EvaluationFlags evaluation_flag,
+                      const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+                      const Number *values_dofs_actual,
+                      Number *      values_quad,
+                      Number *      gradients_quad,
+                      Number *      hessians_quad,
+                      Number *      scratch_data)
+  {
+    (void)hessians_quad;
+    AssertThrow(!(evaluation_flag & EvaluationFlags::hessians),
+                ExcNotImplemented());
+
+    const auto &       shape_data    = shape_info.collapsed_shape_data;
+    const unsigned int n_dofs        = shape_info.dofs_per_component_on_cell;
+    const unsigned int n_q_points    = shape_info.n_q_points;
+    const unsigned int n_dofs_1d     = shape_data.fe_degree + 1;
+    const unsigned int n_tensor_dofs = Utilities::pow(n_dofs_1d, dim);
+
+    // first interpolate into the tensor-product basis in collapsed
+    // coordinates with a dense matrix, then use sum factorization
+    using EvalDense =
+      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>;
+    const EvalDense eval_dense(shape_info.collapsed_transformation.data(),
+                               nullptr,
+                               nullptr,
+                               n_dofs,
+                               n_tensor_dofs);
+    const Eval      eval(shape_data.shape_values.data(),
+                    shape_data.shape_gradients.data(),
+                    nullptr,
+                    n_dofs_1d,
+                    shape_data.n_q_points_1d);
+
+    Number *coefficients = scratch_data;
+    Number *temp1        = coefficients + n_tensor_dofs;
+    Number *temp2        = temp1 + std::max(n_tensor_dofs, n_q_points);
+
+    const bool evaluate_values = evaluation_flag & EvaluationFlags::values;
+    const bool evaluate_gradients =
+      evaluation_flag & EvaluationFlags::gradients;
+    if (evaluate_values == false && evaluate_gradients == false)
+      return;
+
+    const Number *values_dofs = values_dofs_actual;
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        eval_dense.template values<0, true, false>(values_dofs, coefficients);
+
+        if (dim == 2)
+          {
+            eval.template values<0, true, false>(coefficients, temp1);
+            if (evaluate_values)
+              eval.template values<1, true, false>(temp1, values_quad);
+            if (evaluate_gradients)
+              {
+                eval.template gradients<1, true, false>(temp1,
+                                                        gradients_quad +
+                                                          n_q_points);
+                eval.template gradients<0, true, false>(coefficients, temp1);
+                eval.template values<1, true, false>(temp1, gradients_quad);
+              }
+          }
+        else
+          {
+            eval.template values<0, true, false>(coefficients, temp1);
+            eval.template values<1, true, false>(temp1, temp2);
+            if (evaluate_values)
+              eval.template values<2, true, false>(temp2, values_quad);
+            if (evaluate_gradients)
+              {
+                eval.template gradients<2, true, false>(temp2,
+                                                        gradients_quad +
+                                                          2 * n_q_points);
+                eval.template gradients<1, true, false>(temp1, temp2);
+                eval.template values<2, true, false>(temp2,
+                                                     gradients_quad +
+                                                       n_q_points);
+                eval.template gradients<0, true, false>(coefficients, temp1);
+                eval.template values<1, true, false>(temp1, temp2);
+                eval.template values<2, true, false>(temp2, gradients_quad);
+              }
+          }
+
+        if (evaluate_gradients)
+          apply_collapsed_simplex_jacobian<dim, false>(
+            shape_data.quadrature.get_points(), gradients_quad);
+
+        values_dofs += n_dofs;
+        values_quad += n_q_points;
+        gradients_quad += dim * n_q_points;
+      }
+  }
+
+
+
+  template <int dim, int fe_degree, int n_q_points_1d, typename Number>
+  inline void
+  FEEvaluationImpl<
+    MatrixFreeFunctions::tensor_collapsed_simplex,
+    dim,
+    fe_degree,
+    n_q_points_1d,
+    Number>::integrate(const unsigned int                     n_components,
+                       const EvaluationFlags::EvaluationFlags integration_flag,
+                       const MatrixFreeFunctions::ShapeInfo<Number> &shape_info,
+                       Number *   values_dofs_actual,
+                       Number *   values_quad,
+                       Number *   gradients_quad,
+                       Number *   hessians_quad,
+                       Number *   scratch_data,
+                       const bool add_into_values_array)
+  {
+    (void)hessians_quad;
+    AssertThrow(!(integration_flag & EvaluationFlags::hessians),
+                ExcNotImplemented());
+
+    const auto &       shape_data    = shape_info.collapsed_shape_data;
+    const unsigned int n_dofs        = shape_info.dofs_per_component_on_cell;
+    const unsigned int n_q_points    = shape_info.n_q_points;
+    const unsigned int n_dofs_1d     = shape_data.fe_degree + 1;
+    const unsigned int n_tensor_dofs = Utilities::pow(n_dofs_1d, dim);
+
+    using EvalDense =
+      EvaluatorTensorProduct<evaluate_general, 1, 0, 0, Number, Number>;
+    using Eval =
+      EvaluatorTensorProduct<evaluate_general, dim, 0, 0, Number, Number>;
+    const EvalDense eval_dense(shape_info.collapsed_transformation.data(),
+                               nullptr,
+                               nullptr,
+                               n_dofs,
+                               n_tensor_dofs);
+    const Eval      eval(shape_data.shape_values.data(),
+                    shape_data.shape_gradients.data(),
+                    nullptr,
+                    n_dofs_1d,
+                    shape_data.n_q_points_1d);
+
+    Number *coefficients = scratch_data;
+    Number *temp1        = coefficients + n_tensor_dofs;
+    Number *temp2        = temp1 + std::max(n_tensor_dofs, n_q_points);
+
+    const bool integrate_values = integration_flag & EvaluationFlags::values;
+    const bool integrate_gradients =
+      integration_flag & EvaluationFlags::gradients;
+    if (integrate_values == false && integrate_gradients == false)
+      {
+        if (add_into_values_array == false)
+          for (unsigned int i = 0; i < n_components * n_dofs; ++i)
+            values_dofs_actual[i] = Number();
+        return;
+      }
+
+    Number *values_dofs = values_dofs_actual;
+    for (unsigned int c = 0; c < n_components; ++c)
+      {
+        if (integrate_gradients)
+          apply_collapsed_simplex_jacobian<dim, true>(
+            shape_data.quadrature.get_points(), gradients_quad);
+
+        if (dim == 2)
+          {
+            if (integrate_values)
+              eval.template values<1, false, false>(values_quad, temp1);
+            if (integrate_gradients)
+              {
+                if (integrate_values)
+                  eval.template gradients<1, false, true>(gradients_quad +
+                                                            n_q_points,
+                                                          temp1);
+                else
+                  eval.template gradients<1, false, false>(gradients_quad +
+                                                             n_q_points,
+                                                           temp1);
+              }
+            eval.template values<0, false, false>(temp1, coefficients);
+            if (integrate_gradients)
+              {
+                eval.template values<1, false, false>(gradients_quad, temp1);
+                eval.template gradients<0, false, true>(temp1, coefficients);
+              }
+          }
+        else
+          {
+            if (integrate_values)
+              eval.template values<2, false, false>(values_quad, temp1);
+            if (integrate_gradients)
+              {
+                if (integrate_values)
+                  eval.template gradients<2, false, true>(gradients_quad +
+                                                            2 * n_q_points,
+                                                          temp1);
+                else
+                  eval.template gradients<2, false, false>(gradients_quad +
+                                                             2 * n_q_points,
+                                                           temp1);
+              }
+            eval.template values<1, false, false>(temp1, temp2);
+            if (integrate_gradients)
+              {
+                eval.template values<2, false, false>(gradients_quad +
+                                                        n_q_points,
+                                                      temp1);
+                eval.template gradients<1, false, true>(temp1, temp2);
+              }
+            eval.template values<0, false, false>(temp2, coefficients);
+            if (integrate_gradients)
+              {
+                eval.template values<2, false, false>(gradients_quad, temp1);
+                eval.template values<1, false, false>(temp1, temp2);
+                eval.template gradients<0, false, true>(temp2, coefficients);
+              }
+          }
+
+        if (add_into_values_array == false)
+          eval_dense.template values<0, false, false>(coefficients,
+                                                      values_dofs);
+        else
+          eval_dense.template values<0, false, true>(coefficients,
+                                                     values_dofs);
+
+        values_dofs += n_dofs;
+        values_quad += n_q_points;
+        gradients_quad += dim * n_q_points;
+      }
+  }
+
+
+
   /**
    * This struct implements the change between two different bases. This is an
    * ingredient in the FEEvaluationImplTransformToCollocation class where we
@@ -1850,6 +2124,23 @@ namespace internal
                               hessians_quad,
                               scratch_data);
         }
+      else if (shape_info.element_type ==
+               internal::MatrixFreeFunctions::tensor_collapsed_simplex)
+        {
+          internal::FEEvaluationImpl<
+            internal::MatrixFreeFunctions::tensor_collapsed_simplex,
+            dim,
+            fe_degree,
+            n_q_points_1d,
+            Number>::evaluate(n_components,
+                              evaluation_flag,
+                              shape_info,
+                              values_dofs_actual,
+                              values_quad,
+                              gradients_quad,
+                              hessians_quad,
+                              scratch_data);
+        }
       else if (shape_info.element_type ==
                internal::MatrixFreeFunctions::tensor_none)
         {
@@ -2018,6 +2309,24 @@ namespace internal
                                scratch_data,
                                sum_into_values_array);
         }
+      else if (shape_info.element_type ==
+               internal::MatrixFreeFunctions::tensor_collapsed_simplex)
+        {
+          internal::FEEvaluationImpl<
+            internal::MatrixFreeFunctions::tensor_collapsed_simplex,
+            dim,
+            fe_degree,
+            n_q_points_1d,
+            Number>::integrate(n_components,
+                               integration_flag,
+                               shape_info,
+                               values_dofs_actual,
+                               values_quad,
+                               gradients_quad,
+                               hessians_quad,
+                               scratch_data,
+                               sum_into_values_array);
+        }
       else if (shape_info.element_type ==
                internal::MatrixFreeFunctions::tensor_none)
         {
@@ -2966,7 +3275,7 @@ namespace internal
         const unsigned int            face_orientation,
         const Table<2, unsigned int> &orientation_map)
     {
-      if (data.element_type == MatrixFreeFunctions::tensor_none)
+      if (data.element_type >= MatrixFreeFunctions::tensor_none)
         {
           const unsigned int n_dofs     = data.dofs_per_component_on_cell;
           const unsigned int n_q_points = data.n_q_points_faces[face_no];
@@ -3138,7 +3447,7 @@ namespace internal
         const unsigned int            face_orientation,
         const Table<2, unsigned int> &orientation_map)
     {
-      if (data.element_type == MatrixFreeFunctions::tensor_none)
+      if (data.element_type >= MatrixFreeFunctions::tensor_none)
         {
           const unsigned int n_dofs     = data.dofs_per_component_on_cell;
           const unsigned int n_q_points = data.n_q_points_faces[face_no];
@@ -4062,7 +4371,7 @@ namespace internal
       if (src_ptr == nullptr)
         return false;
 
-      if (data.element_type == MatrixFreeFunctions::tensor_none)
+      if (data.element_type >= MatrixFreeFunctions::tensor_none)
         return false;
 
       (void)sm_ptr;
@@ -4333,7 +4642,7 @@ namespace internal
       (void)sm_ptr;
 
       if (dst_ptr == nullptr ||
-          data.element_type == MatrixFreeFunctions::tensor_none)
+          data.element_type >= MatrixFreeFunctions::tensor_none)
         {
           AssertDimension(n_face_orientations, 1);
 
@@ -4850,7 +5159,7 @@ namespace internal
       static const bool do_inplace =
         fe_degree > -1 && (fe_degree + 1 == n_q_points_1d);
 
-      Assert(fe_eval.get_shape_info().element_type !=
+      Assert(fe_eval.get_shape_info().element_type <
                MatrixFreeFunctions::ElementType::tensor_none,
              ExcNotImplemented());
 
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2020 - 2021 by the deal.II authors
+// Copyright (C) 2020 - 2022 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -443,6 +443,31 @@ public:
   reinit(const typename Triangulation<dim, spacedim>::cell_iterator &cell,
          const ArrayView<const Point<dim>> &unit_points);
 
+  /**
+   * Set up the mapping information for a batch of points that are located in
+   * different cells, with the point `unit_points[i]` given in reference
+   * coordinates of the cell `cells[i]`. This is useful when only few points
+   * lie in each cell, e.g., for particles or immersed boundaries, where the
+   * vectorization over the points of a single cell would leave most SIMD
+   * lanes empty. Instead, the subsequent calls to evaluate() and integrate()
+   * process one point from each of several cells in the lanes of a
+   * VectorizedArray, sharing the tensor product kernels among the cells.
+   *
+   * After this call, the `solution_values` arguments of evaluate() and
+   * integrate() contain the unknowns of all cells one after the other, i.e.,
+   * the unknowns of the cell associated with point `i` start at index
+   * `i * fe.n_dofs_per_cell()`. The results are accessed by the index of
+   * the point as usual.
+   *
+   * @note The batched evaluation is only implemented for the fast path with
+   * tensor product finite elements and mappings derived from MappingQ or
+   * MappingCartesian.
+   */
+  void
+  reinit(const ArrayView<const typename Triangulation<dim, spacedim>::
+                           cell_iterator> &  cells,
+         const ArrayView<const Point<dim>> &unit_points);
+
   /**
    * This function interpolates the finite element solution, represented by
    * `solution_values`, on the cell and `unit_points` passed to reinit().
@@ -573,6 +598,22 @@ public:
   unit_point(const unsigned int point_index) const;
 
 private:
+  /**
+   * Evaluation for the points set up by the reinit() function for a batch of
+   * cells.
+   */
+  void
+  evaluate_batched(const ArrayView<const Number> &         solution_values,
+                   const EvaluationFlags::EvaluationFlags &evaluation_flags);
+
+  /**
+   * Integration for the points set up by the reinit() function for a batch
+   * of cells.
+   */
+  void
+  integrate_batched(const ArrayView<Number> &               solution_values,
+                    const EvaluationFlags::EvaluationFlags &integration_flags);
+
   /**
    * Pointer to the Mapping object passed to the constructor.
    */
@@ -691,6 +732,12 @@ private:
    * The reference points specified at reinit().
    */
   std::vector<Point<dim>> unit_points;
+
+  /**
+   * Whether the points passed to the last reinit() call belong to a batch of
+   * cells, with one cell per point.
+   */
+  bool is_batched;
 };
 
 // ----------------------- template and inline function ----------------------
@@ -706,6 +753,7 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::FEPointEvaluation(
   , fe(&fe)
   , update_flags(update_flags)
   , update_flags_mapping(update_default)
+  , is_batched(false)
 {
   AssertIndexRange(first_selected_component + n_components,
                    fe.n_components() + 1);
@@ -817,6 +865,8 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
   const typename Triangulation<dim, spacedim>::cell_iterator &cell,
   const ArrayView<const Point<dim>> &                         unit_points)
 {
+  is_batched = false;
+
   this->unit_points.resize(unit_points.size());
   std::copy(unit_points.begin(), unit_points.end(), this->unit_points.begin());
 
@@ -855,6 +905,55 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
 
 
 
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::reinit(
+  const ArrayView<const typename Triangulation<dim, spacedim>::cell_iterator>
+    &                                cells,
+  const ArrayView<const Point<dim>> &unit_points)
+{
+  AssertDimension(cells.size(), unit_points.size());
+  Assert(!poly.empty(),
+         ExcMessage("The evaluation for a batch of cells is only implemented "
+                    "for tensor product elements and mappings derived from "
+                    "MappingQ or MappingCartesian."));
+
+  is_batched = true;
+
+  this->unit_points.resize(unit_points.size());
+  std::copy(unit_points.begin(), unit_points.end(), this->unit_points.begin());
+
+  // the mapping computes its data one cell at a time, collect the data of
+  // the single point in each cell
+  mapping_data.initialize(unit_points.size(), update_flags_mapping);
+  internal::FEValuesImplementation::MappingRelatedData<dim, spacedim>
+    cell_mapping_data;
+  for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+      fill_mapping_data_for_generic_points(
+        cells[i],
+        ArrayView<const Point<dim>>(unit_points.data() + i, 1),
+        update_flags_mapping,
+        cell_mapping_data);
+      if (update_flags_mapping & update_jacobians)
+        mapping_data.jacobians[i] = cell_mapping_data.jacobians[0];
+      if (update_flags_mapping & update_inverse_jacobians)
+        mapping_data.inverse_jacobians[i] =
+          cell_mapping_data.inverse_jacobians[0];
+      if (update_flags_mapping & update_quadrature_points)
+        mapping_data.quadrature_points[i] =
+          cell_mapping_data.quadrature_points[0];
+    }
+
+  if (update_flags & update_values)
+    values.resize(unit_points.size(), numbers::signaling_nan<value_type>());
+  if (update_flags & update_gradients)
+    gradients.resize(unit_points.size(),
+                     numbers::signaling_nan<gradient_type>());
+}
+
+
+
 template <int n_components, int dim, int spacedim, typename Number>
 void
 FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate(
@@ -864,6 +963,12 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate(
   if (unit_points.empty())
     return;
 
+  if (is_batched)
+    {
+      evaluate_batched(solution_values, evaluation_flag);
+      return;
+    }
+
   AssertDimension(solution_values.size(), fe->dofs_per_cell);
   if (((evaluation_flag & EvaluationFlags::values) ||
        (evaluation_flag & EvaluationFlags::gradients)) &&
@@ -1003,6 +1108,12 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
       return;
     }
 
+  if (is_batched)
+    {
+      integrate_batched(solution_values, integration_flags);
+      return;
+    }
+
   AssertDimension(solution_values.size(), fe->dofs_per_cell);
   if (((integration_flags & EvaluationFlags::values) ||
        (integration_flags & EvaluationFlags::gradients)) &&
@@ -1149,6 +1260,187 @@ FEPointEvaluation<n_components, dim, spacedim, Number>::integrate(
 
 
 
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::evaluate_batched(
+  const ArrayView<const Number> &         solution_values,
+  const EvaluationFlags::EvaluationFlags &evaluation_flag)
+{
+  using VectorizedTraits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, VectorizedArray<Number>>;
+
+  const std::size_t  n_points      = unit_points.size();
+  const std::size_t  n_lanes       = VectorizedArray<Number>::size();
+  const unsigned int dofs_per_cell = fe->dofs_per_cell;
+  AssertDimension(solution_values.size(), n_points * dofs_per_cell);
+
+  if (!(evaluation_flag & EvaluationFlags::values) &&
+      !(evaluation_flag & EvaluationFlags::gradients))
+    return;
+
+  if (solution_renumbered_vectorized.size() != dofs_per_component)
+    solution_renumbered_vectorized.resize(dofs_per_component);
+  unit_gradients.resize(n_points, numbers::signaling_nan<gradient_type>());
+
+  for (unsigned int i = 0; i < n_points; i += n_lanes)
+    {
+      const unsigned int n_filled_lanes =
+        std::min<std::size_t>(n_lanes, n_points - i);
+
+      // convert to vectorized format
+      Point<dim, VectorizedArray<Number>> vectorized_points;
+      for (unsigned int j = 0; j < n_filled_lanes; ++j)
+        for (unsigned int d = 0; d < dim; ++d)
+          vectorized_points[d][j] = unit_points[i + j][d];
+
+      // gather the unknowns of the cells of the points, with lane j holding
+      // the cell of point i + j
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        for (unsigned int k = 0; k < dofs_per_component; ++k)
+          {
+            VectorizedArray<Number> &entry =
+              VectorizedTraits::access(solution_renumbered_vectorized[k], comp);
+            entry = Number();
+            for (unsigned int j = 0; j < n_filled_lanes; ++j)
+              entry[j] =
+                solution_values[(i + j) * dofs_per_cell +
+                                renumber[(component_in_base_element + comp) *
+                                           dofs_per_component +
+                                         k]];
+          }
+
+      // compute
+      const auto val_and_grad =
+        internal::evaluate_tensor_product_value_and_gradient(
+          poly,
+          ArrayView<const typename VectorizedTraits::value_type>(
+            solution_renumbered_vectorized.data(), dofs_per_component),
+          vectorized_points,
+          polynomials_are_hat_functions);
+
+      // convert back to standard format
+      if (evaluation_flag & EvaluationFlags::values)
+        for (unsigned int j = 0; j < n_filled_lanes; ++j)
+          internal::FEPointEvaluation::
+            EvaluatorTypeTraits<dim, n_components, Number>::set_value(
+              val_and_grad.first, j, values[i + j]);
+      if (evaluation_flag & EvaluationFlags::gradients)
+        {
+          Assert(update_flags & update_gradients ||
+                   update_flags & update_inverse_jacobians,
+                 ExcNotInitialized());
+          for (unsigned int j = 0; j < n_filled_lanes; ++j)
+            {
+              internal::FEPointEvaluation::
+                EvaluatorTypeTraits<dim, n_components, Number>::set_gradient(
+                  val_and_grad.second, j, unit_gradients[i + j]);
+              gradients[i + j] = apply_transformation(
+                mapping_data.inverse_jacobians[i + j].transpose(),
+                unit_gradients[i + j]);
+            }
+        }
+    }
+}
+
+
+
+template <int n_components, int dim, int spacedim, typename Number>
+void
+FEPointEvaluation<n_components, dim, spacedim, Number>::integrate_batched(
+  const ArrayView<Number> &               solution_values,
+  const EvaluationFlags::EvaluationFlags &integration_flags)
+{
+  using VectorizedTraits = internal::FEPointEvaluation::
+    EvaluatorTypeTraits<dim, n_components, VectorizedArray<Number>>;
+
+  const std::size_t  n_points      = unit_points.size();
+  const std::size_t  n_lanes       = VectorizedArray<Number>::size();
+  const unsigned int dofs_per_cell = fe->dofs_per_cell;
+  AssertDimension(solution_values.size(), n_points * dofs_per_cell);
+
+  std::fill(solution_values.begin(), solution_values.end(), Number());
+
+  if (!(integration_flags & EvaluationFlags::values) &&
+      !(integration_flags & EvaluationFlags::gradients))
+    return;
+
+  if (integration_flags & EvaluationFlags::values)
+    AssertIndexRange(n_points, values.size() + 1);
+  if (integration_flags & EvaluationFlags::gradients)
+    AssertIndexRange(n_points, gradients.size() + 1);
+
+  if (solution_renumbered_vectorized.size() != dofs_per_component)
+    solution_renumbered_vectorized.resize(dofs_per_component);
+
+  for (unsigned int i = 0; i < n_points; i += n_lanes)
+    {
+      const unsigned int n_filled_lanes =
+        std::min<std::size_t>(n_lanes, n_points - i);
+
+      // convert to vectorized format
+      Point<dim, VectorizedArray<Number>> vectorized_points;
+      for (unsigned int j = 0; j < n_filled_lanes; ++j)
+        for (unsigned int d = 0; d < dim; ++d)
+          vectorized_points[d][j] = unit_points[i + j][d];
+
+      typename internal::ProductTypeNoPoint<value_type,
+                                            VectorizedArray<Number>>::type
+        value = {};
+      Tensor<1,
+             dim,
+             typename internal::ProductTypeNoPoint<
+               value_type,
+               VectorizedArray<Number>>::type>
+        gradient;
+
+      if (integration_flags & EvaluationFlags::values)
+        for (unsigned int j = 0; j < n_filled_lanes; ++j)
+          internal::FEPointEvaluation::
+            EvaluatorTypeTraits<dim, n_components, Number>::get_value(
+              value, j, values[i + j]);
+      if (integration_flags & EvaluationFlags::gradients)
+        for (unsigned int j = 0; j < n_filled_lanes; ++j)
+          {
+            Assert(update_flags_mapping & update_inverse_jacobians,
+                   ExcNotInitialized());
+            gradients[i + j] =
+              apply_transformation(mapping_data.inverse_jacobians[i + j],
+                                   gradients[i + j]);
+            internal::FEPointEvaluation::
+              EvaluatorTypeTraits<dim, n_components, Number>::get_gradient(
+                gradient, j, gradients[i + j]);
+          }
+
+      // compute, with every lane accumulating the contribution of its own
+      // cell
+      solution_renumbered_vectorized.fill(
+        typename VectorizedTraits::value_type());
+      internal::integrate_add_tensor_product_value_and_gradient(
+        poly,
+        value,
+        gradient,
+        vectorized_points,
+        solution_renumbered_vectorized);
+
+      // scatter the lanes into the unknowns of the respective cells
+      for (unsigned int comp = 0; comp < n_components; ++comp)
+        for (unsigned int k = 0; k < dofs_per_component; ++k)
+          {
+            VectorizedArray<Number> result;
+            VectorizedTraits::write_value(result,
+                                          comp,
+                                          solution_renumbered_vectorized[k]);
+            for (unsigned int j = 0; j < n_filled_lanes; ++j)
+              solution_values[(i + j) * dofs_per_cell +
+                              renumber[(component_in_base_element + comp) *
+                                         dofs_per_component +
+                                       k]] = result[j];
+          }
+    }
+}
+
+
+
 template <int n_components, int dim, int spacedim, typename Number>
 inline const typename FEPointEvaluation<n_components, dim, spacedim, Number>::
   value_type &
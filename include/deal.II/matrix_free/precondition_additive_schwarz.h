@@ -0,0 +1,613 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef dealii_matrix_free_precondition_additive_schwarz_h
+#define dealii_matrix_free_precondition_additive_schwarz_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <functional>
+#include <memory>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * An additive Schwarz preconditioner for operators represented by a
+ * MatrixFree object, with the cells of the mesh as subdomains (patches). The
+ * preconditioner computes
+ * @f[
+ *   P^{-1} = \omega \sum_{K} R_K^T A_K^{-1} R_K,
+ * @f]
+ * where $R_K$ restricts a vector to the degrees of freedom of cell $K$,
+ * $A_K$ is the local matrix of the patch and $\omega$ is a relaxation
+ * parameter. The local matrices are never assembled. Instead, they are
+ * represented by a TensorProductMatrixSymmetricSum with one pair of 1D mass
+ * and derivative matrices per direction, whose inverse is applied with the
+ * fast diagonalization method at a cost of $\mathcal O(k^{d+1})$ per cell
+ * for polynomial degree $k$. The cells of a batch of the MatrixFree object
+ * are treated together, using one lane of VectorizedArrayType per cell. The
+ * application is done in a MatrixFree::loop_cell_centric() over the cell
+ * batches, i.e., with the same parallelization in terms of threads and MPI
+ * as the matrix-vector product of the operator.
+ *
+ * For discontinuous elements, the patches do not overlap and the method is a
+ * block-Jacobi method with the cell blocks of the operator. For continuous
+ * elements, adjacent patches overlap in the degrees of freedom on the shared
+ * vertices, lines, and faces. In that case, the contributions are weighted
+ * by the inverse square root of the number of patches a degree of freedom
+ * belongs to before and after the local solves, which keeps the
+ * preconditioner symmetric and avoids the over-correction of a plain sum.
+ *
+ * By default, the 1D matrices are computed for the Laplacian discretized
+ * with the symmetric interior penalty method (with the convention for the
+ * penalty parameter described in AdditionalData::penalty_factor) on
+ * axis-parallel rectangular cells, in which case $A_K$ is the exact cell
+ * block of the operator. On more general meshes, the cells are approximated
+ * by boxes of the same extent in the coordinate directions. Other operators
+ * can be represented by passing a function that fills the 1D matrices via
+ * AdditionalData::compute_1d_matrices, which is required for continuous
+ * elements because their cell Laplacians are singular.
+ *
+ * The class provides the interface of the preconditioners in deal.II, so
+ * that it can be used as a smoother in MGSmootherPrecondition (where
+ * initialize() receives the level operator and extracts the MatrixFree
+ * object via its `get_matrix_free()` function) or as the preconditioner of
+ * PreconditionChebyshev for multigrid hierarchies set up with
+ * MGTransferGlobalCoarsening. The element must be a scalar tensor-product
+ * element such as FE_Q or FE_DGQ.
+ */
+template <int dim,
+          typename Number              = double,
+          typename VectorizedArrayType = VectorizedArray<Number>>
+class PreconditionAdditiveSchwarz : public Subscriptor
+{
+public:
+  /**
+   * The vector type the preconditioner works on.
+   */
+  using VectorType = LinearAlgebra::distributed::Vector<Number>;
+
+  /**
+   * The type of the local solvers, with one solver per cell batch.
+   */
+  using LocalSolverType =
+    TensorProductMatrixSymmetricSum<dim, VectorizedArrayType>;
+
+  /**
+   * Standardized data struct to pipe additional parameters to the
+   * preconditioner.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const double       relaxation        = 1.,
+                   const double       penalty_factor    = 1.,
+                   const unsigned int dof_handler_index = 0);
+
+    /**
+     * Relaxation parameter $\omega$ the sum of the local corrections is
+     * multiplied with.
+     */
+    double relaxation;
+
+    /**
+     * Factor in the penalty parameter of the symmetric interior penalty
+     * method used for the default local matrices of discontinuous elements.
+     * On a face between a cell with extent $h$ and a neighbor with extent
+     * $h^+$ in normal direction, the penalty parameter is
+     * $\sigma = \text{penalty\_factor} \cdot \max(1,k)(k+1) (1/h + 1/h^+)$;
+     * on faces at the boundary, where homogeneous Dirichlet conditions are
+     * imposed weakly, it is $\text{penalty\_factor} \cdot \max(1,k)(k+1) \cdot
+     * 4/h$ and the consistency terms enter with weight one instead of one
+     * half. For $k \geq 1$, this is twice the penalty parameter of step-59,
+     * both on interior and on boundary faces, i.e., a penalty factor of 0.5
+     * gives the discretization of step-59.
+     */
+    double penalty_factor;
+
+    /**
+     * Index of the DoFHandler within the MatrixFree object the
+     * preconditioner acts on.
+     */
+    unsigned int dof_handler_index;
+
+    /**
+     * Optional function to fill the 1D mass and derivative matrices in each
+     * coordinate direction for the cells of the cell batch passed as first
+     * argument, with the data of each cell in the respective lane. The
+     * matrices are passed with the correct size. Unused lanes of the last
+     * batch need not be filled. If empty, the matrices of the Laplacian
+     * described in the class documentation are used.
+     */
+    std::function<void(const unsigned int,
+                       std::array<Table<2, VectorizedArrayType>, dim> &,
+                       std::array<Table<2, VectorizedArrayType>, dim> &)>
+      compute_1d_matrices;
+  };
+
+  /**
+   * Set up the local solvers for all cells of @p matrix_free. A pointer to
+   * @p matrix_free is stored, so the object must live as long as this
+   * preconditioner is used.
+   */
+  void
+  initialize(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Set up the local solvers for the MatrixFree object of the operator
+   * @p op, as returned by its `get_matrix_free()` function either as a
+   * reference or as a shared pointer. This is the interface used by
+   * MGSmootherPrecondition.
+   */
+  template <typename OperatorType>
+  void
+  initialize(const OperatorType &  op,
+             const AdditionalData &additional_data = AdditionalData());
+
+  /**
+   * Release all memory and return to a state just like after having called
+   * the default constructor.
+   */
+  void
+  clear();
+
+  /**
+   * Apply the preconditioner, i.e., compute $dst = P^{-1} src$.
+   */
+  void
+  vmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Apply the transpose of the preconditioner. Since the local matrices are
+   * symmetric, this is the same as vmult().
+   */
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const;
+
+  /**
+   * Return the number of rows of the preconditioner, i.e., the size of the
+   * vectors it works on.
+   */
+  types::global_dof_index
+  m() const;
+
+  /**
+   * Return the number of columns of the preconditioner.
+   */
+  types::global_dof_index
+  n() const;
+
+  /**
+   * Return the local solvers of the cell batches.
+   */
+  const std::vector<LocalSolverType> &
+  get_local_solvers() const;
+
+  /**
+   * Return the memory consumption of this class in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * Fill the 1D matrices of the default local problem for the cells of
+   * batch @p cell_batch.
+   */
+  void
+  compute_laplace_1d_matrices(
+    const unsigned int                              cell_batch,
+    std::array<Table<2, VectorizedArrayType>, dim> &mass_matrices,
+    std::array<Table<2, VectorizedArrayType>, dim> &derivative_matrices) const;
+
+  /**
+   * Apply the local solvers on a range of cell batches.
+   */
+  void
+  local_apply(const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+              VectorType &                                        dst,
+              const VectorType &                                  src,
+              const std::pair<unsigned int, unsigned int> &cell_range) const;
+
+  /**
+   * The MatrixFree object describing the cells and unknowns.
+   */
+  SmartPointer<const MatrixFree<dim, Number, VectorizedArrayType>>
+    matrix_free;
+
+  /**
+   * The parameters passed to initialize().
+   */
+  AdditionalData additional_data;
+
+  /**
+   * The local solvers, one per cell batch.
+   */
+  std::vector<LocalSolverType> local_solvers;
+
+  /**
+   * For continuous elements, the inverse square root of the number of
+   * patches each degree of freedom belongs to, including ghost entries.
+   * Empty for discontinuous elements.
+   */
+  VectorType overlap_weights;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::
+  AdditionalData::AdditionalData(const double       relaxation,
+                                 const double       penalty_factor,
+                                 const unsigned int dof_handler_index)
+  : relaxation(relaxation)
+  , penalty_factor(penalty_factor)
+  , dof_handler_index(dof_handler_index)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::initialize(
+  const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+  const AdditionalData &                              additional_data)
+{
+  this->matrix_free     = &matrix_free;
+  this->additional_data = additional_data;
+
+  const unsigned int        dof_index = additional_data.dof_handler_index;
+  const FiniteElement<dim> &fe =
+    matrix_free.get_dof_handler(dof_index).get_fe();
+  AssertThrow(fe.n_components() == 1,
+              ExcMessage("Only scalar elements are supported."));
+
+  const auto &       shape_info = matrix_free.get_shape_info(dof_index);
+  const unsigned int n          = shape_info.data[0].fe_degree + 1;
+  AssertThrow(
+    shape_info.element_type <=
+        internal::MatrixFreeFunctions::tensor_general &&
+      shape_info.dofs_per_component_on_cell == Utilities::pow(n, dim),
+    ExcMessage("The local solvers need a tensor-product element with "
+               "(k+1)^dim unknowns per cell."));
+
+  const bool is_continuous = fe.n_dofs_per_vertex() > 0;
+  AssertThrow(!is_continuous || additional_data.compute_1d_matrices,
+              ExcMessage("The cell Laplacian of continuous elements is "
+                         "singular, provide the local matrices via "
+                         "AdditionalData::compute_1d_matrices."));
+
+  local_solvers.resize(matrix_free.n_cell_batches());
+  std::array<Table<2, VectorizedArrayType>, dim> mass_matrices;
+  std::array<Table<2, VectorizedArrayType>, dim> derivative_matrices;
+  for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+    {
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          mass_matrices[d].reinit(n, n);
+          derivative_matrices[d].reinit(n, n);
+        }
+      if (additional_data.compute_1d_matrices)
+        additional_data.compute_1d_matrices(cell,
+                                            mass_matrices,
+                                            derivative_matrices);
+      else
+        compute_laplace_1d_matrices(cell, mass_matrices, derivative_matrices);
+
+      // fill unused lanes of the last batch with the data of the first cell
+      // to keep the eigenvalue problems in those lanes well-posed
+      const unsigned int n_filled =
+        matrix_free.n_active_entries_per_cell_batch(cell);
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int i = 0; i < n; ++i)
+          for (unsigned int j = 0; j < n; ++j)
+            for (unsigned int v = n_filled; v < VectorizedArrayType::size();
+                 ++v)
+              {
+                mass_matrices[d](i, j)[v] = mass_matrices[d](i, j)[0];
+                derivative_matrices[d](i, j)[v] =
+                  derivative_matrices[d](i, j)[0];
+              }
+
+      local_solvers[cell].reinit(mass_matrices, derivative_matrices);
+    }
+
+  overlap_weights.reinit(0);
+  if (is_continuous)
+    {
+      matrix_free.initialize_dof_vector(overlap_weights, dof_index);
+      FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi(matrix_free,
+                                                                   dof_index);
+      for (unsigned int cell = 0; cell < matrix_free.n_cell_batches(); ++cell)
+        {
+          phi.reinit(cell);
+          for (unsigned int i = 0; i < phi.dofs_per_cell; ++i)
+            phi.begin_dof_values()[i] = Number(1.);
+          phi.distribute_local_to_global(overlap_weights);
+        }
+      overlap_weights.compress(VectorOperation::add);
+      for (Number &weight : overlap_weights)
+        weight = weight > Number(0.) ? Number(1.) / std::sqrt(weight) :
+                                       Number(0.);
+      overlap_weights.update_ghost_values();
+    }
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename OperatorType>
+inline void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::initialize(
+  const OperatorType &  op,
+  const AdditionalData &additional_data)
+{
+  initialize(Utilities::get_underlying_value(op.get_matrix_free()),
+             additional_data);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::clear()
+{
+  matrix_free = nullptr;
+  local_solvers.clear();
+  overlap_weights.reinit(0);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::
+  compute_laplace_1d_matrices(
+    const unsigned int                              cell_batch,
+    std::array<Table<2, VectorizedArrayType>, dim> &mass_matrices,
+    std::array<Table<2, VectorizedArrayType>, dim> &derivative_matrices) const
+{
+  const unsigned int dof_index = additional_data.dof_handler_index;
+
+  const auto &shape_data = matrix_free->get_shape_info(dof_index).data[0];
+
+  const unsigned int   n          = shape_data.fe_degree + 1;
+  const unsigned int   n_q_points = shape_data.n_q_points_1d;
+  const Quadrature<1> &quadrature = shape_data.quadrature;
+
+  // 1D matrices on the unit interval
+  Table<2, Number> mass_unit(n, n), laplace_unit(n, n);
+  for (unsigned int i = 0; i < n; ++i)
+    for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int q = 0; q < n_q_points; ++q)
+        {
+          mass_unit(i, j) += shape_data.shape_values[i * n_q_points + q][0] *
+                             shape_data.shape_values[j * n_q_points + q][0] *
+                             quadrature.weight(q);
+          laplace_unit(i, j) +=
+            shape_data.shape_gradients[i * n_q_points + q][0] *
+            shape_data.shape_gradients[j * n_q_points + q][0] *
+            quadrature.weight(q);
+        }
+
+  const bool is_discontinuous =
+    matrix_free->get_dof_handler(dof_index).get_fe().n_dofs_per_vertex() == 0;
+  const unsigned int degree = shape_data.fe_degree;
+  const Number       penalty =
+    additional_data.penalty_factor * std::max(1U, degree) * (degree + 1);
+
+  for (unsigned int v = 0;
+       v < matrix_free->n_active_entries_per_cell_batch(cell_batch);
+       ++v)
+    {
+      const auto cell =
+        matrix_free->get_cell_iterator(cell_batch, v, dof_index);
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const Number h = cell->extent_in_direction(d);
+          for (unsigned int i = 0; i < n; ++i)
+            for (unsigned int j = 0; j < n; ++j)
+              {
+                mass_matrices[d](i, j)[v]       = mass_unit(i, j) * h;
+                derivative_matrices[d](i, j)[v] = laplace_unit(i, j) / h;
+              }
+
+          if (is_discontinuous == false)
+            continue;
+
+          // interior penalty terms on the two faces in direction d, with the
+          // values and derivatives of the 1D shape functions at 0 and 1
+          for (unsigned int side = 0; side < 2; ++side)
+            {
+              const unsigned int face   = 2 * d + side;
+              const Number       normal = side == 0 ? -1. : 1.;
+              const bool         at_boundary =
+                cell->at_boundary(face) && !cell->has_periodic_neighbor(face);
+              const Number h_neighbor =
+                at_boundary ? h :
+                              cell->neighbor_or_periodic_neighbor(face)
+                                ->extent_in_direction(d);
+              const Number sigma = penalty * (1. / h + 1. / h_neighbor);
+              const Number consistency_weight = at_boundary ? 1. : 0.5;
+              const Number penalty_weight     = at_boundary ? 2. : 1.;
+
+              const VectorizedArrayType *values =
+                shape_data.shape_data_on_face[side].begin();
+              const VectorizedArrayType *derivatives = values + n;
+              for (unsigned int i = 0; i < n; ++i)
+                for (unsigned int j = 0; j < n; ++j)
+                  derivative_matrices[d](i, j)[v] +=
+                    -consistency_weight * normal / h *
+                      (derivatives[i][0] * values[j][0] +
+                       values[i][0] * derivatives[j][0]) +
+                    penalty_weight * sigma * values[i][0] * values[j][0];
+            }
+        }
+    }
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::local_apply(
+  const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+  VectorType &                                        dst,
+  const VectorType &                                  src,
+  const std::pair<unsigned int, unsigned int> &       cell_range) const
+{
+  FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi(
+    matrix_free, cell_range, additional_data.dof_handler_index);
+  FEEvaluation<dim, -1, 0, 1, Number, VectorizedArrayType> phi_weights(
+    matrix_free, cell_range, additional_data.dof_handler_index);
+
+  const unsigned int                 dofs_per_cell = phi.dofs_per_cell;
+  AlignedVector<VectorizedArrayType> local_src(dofs_per_cell), tmp;
+  const ArrayView<VectorizedArrayType> local_dst(phi.begin_dof_values(),
+                                                 dofs_per_cell);
+
+  for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(src);
+      if (overlap_weights.size() > 0)
+        {
+          phi_weights.reinit(cell);
+          phi_weights.read_dof_values_plain(overlap_weights);
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            phi.begin_dof_values()[i] *= phi_weights.begin_dof_values()[i];
+        }
+
+      std::copy(local_dst.begin(), local_dst.end(), local_src.begin());
+      local_solvers[cell].apply_inverse(
+        local_dst,
+        ArrayView<const VectorizedArrayType>(local_src.begin(), dofs_per_cell),
+        tmp);
+
+      const Number relaxation = additional_data.relaxation;
+      if (overlap_weights.size() > 0)
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          local_dst[i] *= phi_weights.begin_dof_values()[i] * relaxation;
+      else if (relaxation != Number(1.))
+        for (unsigned int i = 0; i < dofs_per_cell; ++i)
+          local_dst[i] *= relaxation;
+
+      phi.distribute_local_to_global(dst);
+    }
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::vmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  Assert(matrix_free != nullptr, ExcNotInitialized());
+  matrix_free->loop_cell_centric(&PreconditionAdditiveSchwarz::local_apply,
+                                 this,
+                                 dst,
+                                 src,
+                                 true,
+                                 MatrixFree<dim, Number, VectorizedArrayType>::
+                                   DataAccessOnFaces::none);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline void
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::Tvmult(
+  VectorType &      dst,
+  const VectorType &src) const
+{
+  vmult(dst, src);
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline types::global_dof_index
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::m() const
+{
+  Assert(matrix_free != nullptr, ExcNotInitialized());
+  return matrix_free->get_vector_partitioner(additional_data.dof_handler_index)
+    ->size();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline types::global_dof_index
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::n() const
+{
+  return m();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+inline const std::vector<
+  typename PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::
+    LocalSolverType> &
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::
+  get_local_solvers() const
+{
+  return local_solvers;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::size_t
+PreconditionAdditiveSchwarz<dim, Number, VectorizedArrayType>::
+  memory_consumption() const
+{
+  std::size_t memory = sizeof(*this) + overlap_weights.memory_consumption();
+  for (const LocalSolverType &solver : local_solvers)
+    memory += solver.memory_consumption();
+  return memory;
+}
+
+#endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
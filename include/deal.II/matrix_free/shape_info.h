@@ -46,6 +46,10 @@ namespace internal
      * ElementType::tensor_general. As a consequence, we support `<=`
      * operations between the types with this sorting, but not against the
      * even higher indexed types such as ElementType::truncated_tensor.
+     * Similarly, ElementType::tensor_collapsed_simplex is a special case of
+     * ElementType::tensor_none that only differs in the evaluation of cell
+     * integrals, so that `>= tensor_none` identifies all elements without a
+     * tensor product structure in the reference coordinates.
      *
      * @ingroup matrixfree
      */
@@ -96,7 +100,18 @@ namespace internal
       /**
        * Shape functions without an tensor product properties.
        */
-      tensor_none = 6
+      tensor_none = 6,
+
+      /**
+       * Polynomials of complete degree on simplices (FE_SimplexP,
+       * FE_SimplexDGP) combined with a QCollapsedSimplex quadrature formula.
+       * Cell integrals first interpolate the nodal values into a tensor
+       * product basis in collapsed (Duffy) coordinates, see
+       * ShapeInfo::collapsed_transformation, and then use sum factorization
+       * along the collapsed coordinates followed by the chain rule of the
+       * collapsed map. Face integrals are handled as for tensor_none.
+       */
+      tensor_collapsed_simplex = 7
     };
 
 
@@ -522,6 +537,28 @@ namespace internal
        */
       dealii::Table<2, unsigned int> face_orientations;
 
+      /**
+       * For element type tensor_collapsed_simplex, this matrix interpolates
+       * the (nodal) simplex basis into a tensor-product Lagrange basis
+       * defined in the collapsed coordinates of the simplex, which is exact
+       * because a polynomial of complete degree $k$ is of degree at most $k$
+       * in each collapsed coordinate. The entry at position
+       * <code>i * Utilities::pow(fe_degree + 1, dim) + j</code> contains the
+       * value of the simplex shape function @p i at the image of the tensor
+       * product node @p j. The layout matches the @p shape_values field of
+       * UnivariateShapeData for element type tensor_none.
+       */
+      AlignedVector<Number> collapsed_transformation;
+
+      /**
+       * For element type tensor_collapsed_simplex, the values and gradients
+       * of the one-dimensional Lagrange basis used in collapsed coordinates,
+       * evaluated in the one-dimensional Gauss points of the
+       * QCollapsedSimplex formula, which are stored in the @p quadrature
+       * field.
+       */
+      UnivariateShapeData<Number> collapsed_shape_data;
+
     private:
       /**
        * Check whether we have symmetries in the shape values. In that case,
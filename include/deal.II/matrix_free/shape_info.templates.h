@@ -456,6 +456,76 @@ namespace internal
           // TODO: setup face_to_cell_index_nodal, face_to_cell_index_hermite,
           //  face_orientations
 
+          // polynomials of complete degree on simplices can be evaluated by
+          // sum factorization in collapsed coordinates if the quadrature
+          // formula is a tensor product in these coordinates
+          if ((dim == 2 || dim == 3) &&
+              (dynamic_cast<const FE_SimplexP<dim> *>(&fe) != nullptr ||
+               dynamic_cast<const FE_SimplexDGP<dim> *>(&fe) != nullptr))
+            {
+              const unsigned int n_q_points_1d =
+                static_cast<unsigned int>(std::round(
+                  std::pow(static_cast<double>(n_q_points), 1. / dim)));
+              if (Utilities::pow(n_q_points_1d, dim) == n_q_points &&
+                  quad == QCollapsedSimplex<dim>(n_q_points_1d))
+                {
+                  element_type = tensor_collapsed_simplex;
+
+                  const unsigned int n_dofs_1d = fe.degree + 1;
+                  const QGauss<1>    nodes_1d(n_dofs_1d);
+                  const QGauss<1>    quad_1d(n_q_points_1d);
+                  const std::vector<Polynomials::Polynomial<double>> lagrange =
+                    Polynomials::generate_complete_Lagrange_basis(
+                      nodes_1d.get_points());
+
+                  collapsed_shape_data.element_type  = tensor_general;
+                  collapsed_shape_data.quadrature    = quad_1d;
+                  collapsed_shape_data.fe_degree     = fe.degree;
+                  collapsed_shape_data.n_q_points_1d = n_q_points_1d;
+
+                  auto &values_1d    = collapsed_shape_data.shape_values;
+                  auto &gradients_1d = collapsed_shape_data.shape_gradients;
+                  values_1d.resize_fast(n_dofs_1d * n_q_points_1d);
+                  gradients_1d.resize_fast(n_dofs_1d * n_q_points_1d);
+                  for (unsigned int i = 0; i < n_dofs_1d; ++i)
+                    for (unsigned int q = 0; q < n_q_points_1d; ++q)
+                      {
+                        std::array<double, 2> values;
+                        lagrange[i].value(quad_1d.point(q)[0],
+                                          1,
+                                          values.data());
+                        values_1d[i * n_q_points_1d + q]    = values[0];
+                        gradients_1d[i * n_q_points_1d + q] = values[1];
+                      }
+
+                  // interpolate the simplex basis into the tensor-product
+                  // nodes mapped by x = a(1-b)(1-c), y = b(1-c), z = c
+                  const unsigned int n_tensor_dofs =
+                    Utilities::pow(n_dofs_1d, dim);
+                  collapsed_transformation.resize_fast(n_dofs * n_tensor_dofs);
+                  for (unsigned int j = 0; j < n_tensor_dofs; ++j)
+                    {
+                      const double a = nodes_1d.point(j % n_dofs_1d)[0];
+                      const double b =
+                        nodes_1d.point((j / n_dofs_1d) % n_dofs_1d)[0];
+                      const double c =
+                        dim > 2 ?
+                          nodes_1d.point(j / (n_dofs_1d * n_dofs_1d))[0] :
+                          0.;
+
+                      Point<dim> point;
+                      point[0] = a * (1. - b) * (1. - c);
+                      point[1] = b * (1. - c);
+                      if (dim > 2)
+                        point[2] = c;
+
+                      for (unsigned int i = 0; i < n_dofs; ++i)
+                        collapsed_transformation[i * n_tensor_dofs + j] =
+                          fe.shape_value(i, point);
+                    }
+                }
+            }
+
           return;
         }
 
@@ -1126,6 +1196,8 @@ namespace internal
       std::size_t memory = sizeof(*this);
       for (const auto &univariate_shape_data : data)
         memory += univariate_shape_data.memory_consumption();
+      memory += MemoryConsumption::memory_consumption(collapsed_transformation);
+      memory += collapsed_shape_data.memory_consumption();
       return memory;
     }
 
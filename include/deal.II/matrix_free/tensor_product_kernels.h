@@ -20,6 +20,8 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/point.h>
 #include <deal.II/base/polynomial.h>
 #include <deal.II/base/utilities.h>
 
@@ -2328,6 +2330,81 @@ namespace internal
 
 
 
+  /**
+   * Transform the gradients of a function with respect to the collapsed
+   * (Duffy) coordinates $(a,b,c)$ of a simplex into gradients with respect
+   * to the reference coordinates $(x,y,z)$, given the collapsed map
+   * $x = a(1-b)(1-c)$, $y = b(1-c)$, $z = c$ (and its restriction to 2D).
+   * The gradients are given in a tensor product of the one-dimensional
+   * points @p points_1d numbered lexicographically, and the derivative in
+   * direction @p d at point @p q is stored at position
+   * <code>d * n_points + q</code> of the array @p gradients, which is
+   * overwritten with the result.
+   *
+   * If @p transpose is set to true, the transposed operation is applied
+   * instead, as needed when testing by gradients of the shape functions in
+   * integration: It takes the reference-coordinate gradients of the test
+   * functions and returns the contributions to the collapsed-coordinate
+   * derivatives.
+   *
+   * Since the points must be located in the interior of the unit interval,
+   * the map is never evaluated at the collapsed vertex.
+   */
+  template <int dim, bool transpose, typename Number>
+  inline void
+  apply_collapsed_simplex_jacobian(const std::vector<Point<1>> &points_1d,
+                                   Number *                     gradients)
+  {
+    Assert(dim == 2 || dim == 3, ExcNotImplemented());
+    const unsigned int n_points_1d = points_1d.size();
+    const unsigned int n_points    = Utilities::pow(n_points_1d, dim);
+
+    Number *DEAL_II_RESTRICT grad_0 = gradients;
+    Number *DEAL_II_RESTRICT grad_1 = gradients + n_points;
+    Number *DEAL_II_RESTRICT grad_2 = gradients + (dim - 1) * n_points;
+
+    for (unsigned int k = 0, q = 0; k < (dim > 2 ? n_points_1d : 1); ++k)
+      {
+        const double c       = dim > 2 ? points_1d[k][0] : 0.;
+        const double inv_1mc = 1. / (1. - c);
+        for (unsigned int j = 0; j < n_points_1d; ++j)
+          {
+            const double b         = points_1d[j][0];
+            const double inv_1mb_c = inv_1mc / (1. - b);
+            for (unsigned int i = 0; i < n_points_1d; ++i, ++q)
+              {
+                const double a = points_1d[i][0];
+                if (dim == 2 && transpose == false)
+                  {
+                    const Number d_x = grad_0[q] * inv_1mb_c;
+                    grad_0[q]        = d_x;
+                    grad_1[q]        = d_x * a + grad_1[q];
+                  }
+                else if (dim == 2)
+                  {
+                    grad_0[q] = (grad_0[q] + grad_1[q] * a) * inv_1mb_c;
+                  }
+                else if (transpose == false)
+                  {
+                    const Number d_x  = grad_0[q] * inv_1mb_c;
+                    const Number d_by = grad_1[q] * inv_1mc;
+                    grad_0[q]         = d_x;
+                    grad_1[q]         = d_x * a + d_by;
+                    grad_2[q]         = d_x * a + d_by * b + grad_2[q];
+                  }
+                else
+                  {
+                    const Number d_yz = grad_1[q] + grad_2[q];
+                    grad_0[q]         = (grad_0[q] + d_yz * a) * inv_1mb_c;
+                    grad_1[q]         = (grad_1[q] + grad_2[q] * b) * inv_1mc;
+                  }
+              }
+          }
+      }
+  }
+
+
+
   /**
    * Struct to avoid using Tensor<1, dim, Point<dim2>> in
    * evaluate_tensor_product_value_and_gradient because a Point cannot be used
@@ -2388,7 +2465,7 @@ namespace internal
     Tensor<1, dim, typename ProductTypeNoPoint<Number, Number2>::type>>
   evaluate_tensor_product_value_and_gradient(
     const std::vector<Polynomials::Polynomial<double>> &poly,
-    const std::vector<Number> &                         values,
+    const ArrayView<const Number> &                     values,
     const Point<dim, Number2> &                         p,
     const bool                                          d_linear = false,
     const std::vector<unsigned int> &                   renumber = {})
@@ -2523,6 +2600,26 @@ namespace internal
 
 
 
+  /**
+   * Same as above, with the coefficients given as an `std::vector`.
+   */
+  template <int dim, typename Number, typename Number2>
+  inline std::pair<
+    typename ProductTypeNoPoint<Number, Number2>::type,
+    Tensor<1, dim, typename ProductTypeNoPoint<Number, Number2>::type>>
+  evaluate_tensor_product_value_and_gradient(
+    const std::vector<Polynomials::Polynomial<double>> &poly,
+    const std::vector<Number> &                         values,
+    const Point<dim, Number2> &                         p,
+    const bool                                          d_linear = false,
+    const std::vector<unsigned int> &                   renumber = {})
+  {
+    return evaluate_tensor_product_value_and_gradient(
+      poly, make_array_view(values), p, d_linear, renumber);
+  }
+
+
+
   /**
    * Same as evaluate_tensor_product_value_and_gradient() but for integration.
    */
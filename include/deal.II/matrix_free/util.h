@@ -57,6 +57,12 @@ namespace internal
               return {ReferenceCells::get_simplex<dim>(),
                       dealii::hp::QCollection<dim - 1>(
                         QWitherdenVincentSimplex<dim - 1>(i))};
+
+          for (unsigned int i = 1; i <= 5; ++i)
+            if (quad == QCollapsedSimplex<dim>(i))
+              return {ReferenceCells::get_simplex<dim>(),
+                      dealii::hp::QCollection<dim - 1>(
+                        QCollapsedSimplex<dim - 1>(i))};
         }
 
       if (dim == 3)
@@ -132,6 +138,16 @@ namespace internal
                   return {Quadrature<dim - 1>(),
                           QWitherdenVincentSimplex<dim - 1>(i)};
               }
+
+          for (unsigned int i = 1; i <= 5; ++i)
+            if (quad == QCollapsedSimplex<dim>(i))
+              {
+                if (dim == 2)
+                  return {QCollapsedSimplex<dim - 1>(i), // line!
+                          Quadrature<dim - 1>()};
+                else
+                  return {Quadrature<dim - 1>(), QCollapsedSimplex<dim - 1>(i)};
+              }
         }
 
       if (dim == 3)
@@ -0,0 +1,1088 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_mg_matrix_free_level_cache_h
+#define dealii_mg_matrix_free_level_cache_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mg */
+/*@{*/
+
+/**
+ * A cache for the MatrixFree objects of the levels of a multigrid hierarchy,
+ * e.g., one set up for MGTransferGlobalCoarsening with one DoFHandler per
+ * level, that is meant to be kept alive across the linear solves of a
+ * nonlinear iteration.
+ *
+ * In a Newton method, the mesh, the degrees of freedom, and the constraints
+ * of the linearized problems usually stay the same, and only the
+ * linearization point, i.e., some coefficient evaluated in the quadrature
+ * points, changes from one step to the next. Setting up the MatrixFree
+ * object of every level again, including the mapping data
+ * (internal::MatrixFreeFunctions::MappingInfo) and the index data
+ * (internal::MatrixFreeFunctions::DoFInfo), is then a large fixed cost per
+ * Newton step. This class keeps these objects and offers three operations:
+ * <ul>
+ * <li> reinit() returns the MatrixFree object of a level. It only sets up a
+ * new object if there is none for this level yet, if the cache for the
+ * level has been invalidated, or if a cheap consistency check on the
+ * arguments fails. If only the mapping has changed, e.g., for a
+ * MappingQEulerian with moving vertices, update_mapping() recomputes the
+ * mapping data alone.
+ * <li> update_coefficient() fills a table with one coefficient value per
+ * cell batch and quadrature point. The table is allocated once per level and
+ * the same object is filled in place by later calls, so operators that hold
+ * a pointer to it, like MatrixFreeOperators::LaplaceOperator via
+ * MatrixFreeOperators::LaplaceOperator::set_coefficient(), see the new
+ * values without any further setup.
+ * <li> initialize_chebyshev() initializes a PreconditionChebyshev object, but
+ * reuses the estimate of the largest eigenvalue from an earlier call on the
+ * same level instead of running the eigenvalue estimation again, as long as
+ * AdditionalData::max_n_eigenvalue_reuses is not exceeded.
+ * </ul>
+ *
+ * The cache of all levels is invalidated automatically whenever the
+ * triangulation of a level changes. Apart from that, reinit() sets up a new
+ * object if the mapping or the DoFHandler, the number of degrees of freedom,
+ * the constraints, the number of quadrature points, or the
+ * MatrixFree::AdditionalData differ from the arguments of the cached
+ * object. The mapping is identified through its Subscriptor base class, so
+ * that a new mapping created at the address of a destroyed one is not
+ * mistaken for it. If the constraints are a different object than the ones
+ * of the cached object, they are compared by a hash of all constraint lines,
+ * so that constraints that are rebuilt in every nonlinear iteration do not
+ * prevent the reuse. The hash is not computed if the same object is passed
+ * again with the same number of constraints.
+ *
+ * If the degrees of freedom are changed without changing the mesh or their
+ * number, e.g., by renumbering, or if the constraints are changed in place
+ * without changing their number, invalidate() must be called explicitly.
+ *
+ * Objects of this class cannot be copied, since they are connected to
+ * signals of the triangulations.
+ *
+ * The numbers of objects that have been set up anew and that have been
+ * reused are collected in a Statistics object, see get_statistics().
+ *
+ * A typical Newton step then looks like this:
+ * @code
+ * for (unsigned int l = min_level; l <= max_level; ++l)
+ *   {
+ *     const auto matrix_free = cache.reinit(l, mapping, dof_handlers[l],
+ *                                           constraints[l], quadrature);
+ *     cache.update_coefficient(l, [&](const auto &matrix_free, auto &table) {
+ *       // evaluate the linearization point on level l into table
+ *     });
+ *     operators[l].initialize(matrix_free);
+ *     operators[l].set_coefficient(cache.get_coefficient(l));
+ *     operators[l].compute_diagonal();
+ *     cache.initialize_chebyshev(l, smoothers[l], operators[l],
+ *                                smoother_data[l], dummy_vector);
+ *   }
+ * @endcode
+ */
+template <int dim,
+          typename Number,
+          typename VectorizedArrayType = VectorizedArray<Number>>
+class MGLevelMatrixFreeCache : public Subscriptor
+{
+public:
+  /**
+   * The type of the cached MatrixFree objects.
+   */
+  using MatrixFreeType = MatrixFree<dim, Number, VectorizedArrayType>;
+
+  /**
+   * The type of the coefficient tables, indexed by cell batch and
+   * quadrature point.
+   */
+  using CoefficientTable = Table<2, VectorizedArrayType>;
+
+  /**
+   * Parameters of the cache.
+   */
+  struct AdditionalData
+  {
+    /**
+     * Constructor.
+     */
+    AdditionalData(const bool         reuse_eigenvalue_estimates = true,
+                   const unsigned int max_n_eigenvalue_reuses    = 10,
+                   const double       eigenvalue_safety_factor   = 1.);
+
+    /**
+     * Whether initialize_chebyshev() may reuse eigenvalue estimates.
+     */
+    bool reuse_eigenvalue_estimates;
+
+    /**
+     * The number of calls to initialize_chebyshev() on a level that reuse an
+     * estimate before the eigenvalues are estimated again. Since the operator
+     * changes with the coefficient, the estimate of the first Newton step
+     * becomes less accurate over time; a fresh estimate every few steps
+     * keeps the Chebyshev smoother on the safe side.
+     */
+    unsigned int max_n_eigenvalue_reuses;
+
+    /**
+     * A factor by which a reused estimate of the largest eigenvalue is
+     * multiplied. Note that the estimate stored by PreconditionChebyshev
+     * already contains a safety factor of 1.2 with respect to the largest
+     * Ritz value.
+     */
+    double eigenvalue_safety_factor;
+  };
+
+  /**
+   * Numbers of objects that have been set up anew and that have been reused,
+   * summed over all levels, and the time spent on the setup.
+   */
+  struct Statistics
+  {
+    /**
+     * Constructor, initializing all counters to zero.
+     */
+    Statistics();
+
+    /**
+     * Number of MatrixFree objects set up by reinit().
+     */
+    unsigned int n_matrix_free_setups;
+
+    /**
+     * Number of calls to reinit() that returned a cached MatrixFree object.
+     */
+    unsigned int n_matrix_free_reuses;
+
+    /**
+     * Number of calls to update_mapping().
+     */
+    unsigned int n_mapping_updates;
+
+    /**
+     * Number of hashes computed over all constraint lines by reinit() to
+     * compare the constraints with the ones of the cached objects.
+     */
+    unsigned int n_constraints_hashes;
+
+    /**
+     * Number of coefficient tables that needed to be allocated.
+     */
+    unsigned int n_coefficient_allocations;
+
+    /**
+     * Number of calls to update_coefficient().
+     */
+    unsigned int n_coefficient_updates;
+
+    /**
+     * Number of eigenvalue estimations run by initialize_chebyshev().
+     */
+    unsigned int n_eigenvalue_estimates;
+
+    /**
+     * Number of calls to initialize_chebyshev() that reused an estimate.
+     */
+    unsigned int n_eigenvalue_reuses;
+
+    /**
+     * Total number of CG iterations of the eigenvalue estimations.
+     */
+    unsigned int n_eigenvalue_cg_iterations;
+
+    /**
+     * Wall time in seconds spent in setting up MatrixFree objects and mapping
+     * data.
+     */
+    double matrix_free_setup_time;
+
+    /**
+     * Wall time in seconds spent in the eigenvalue estimation.
+     */
+    double eigenvalue_estimation_time;
+
+    /**
+     * Print the statistics to the given stream.
+     */
+    void
+    print(std::ostream &out) const;
+  };
+
+  /**
+   * Constructor.
+   */
+  MGLevelMatrixFreeCache(const AdditionalData &data = AdditionalData());
+
+  /**
+   * Copy constructor, deleted because the listeners to the triangulations
+   * refer to this object.
+   */
+  MGLevelMatrixFreeCache(const MGLevelMatrixFreeCache &) = delete;
+
+  /**
+   * Destructor.
+   */
+  ~MGLevelMatrixFreeCache() override;
+
+  /**
+   * Copy assignment, deleted for the same reason as the copy constructor.
+   */
+  MGLevelMatrixFreeCache &
+  operator=(const MGLevelMatrixFreeCache &) = delete;
+
+  /**
+   * Return the MatrixFree object of level @p level, set up with the given
+   * arguments, which are the same as for MatrixFree::reinit(). A cached
+   * object is returned if it exists, the cache of this level has not been
+   * invalidated, and the object was set up with the same arguments as
+   * described in the class documentation.
+   */
+  template <typename QuadratureType, typename MappingType>
+  std::shared_ptr<const MatrixFreeType>
+  reinit(const unsigned int                               level,
+         const MappingType &                              mapping,
+         const DoFHandler<dim> &                          dof_handler,
+         const AffineConstraints<Number> &                constraints,
+         const QuadratureType &                           quadrature,
+         const typename MatrixFreeType::AdditionalData &additional_data =
+           typename MatrixFreeType::AdditionalData());
+
+  /**
+   * Recompute the mapping data of the MatrixFree object of level @p level,
+   * keeping all other data, see MatrixFree::update_mapping(). Any
+   * eigenvalue estimate of the level is discarded.
+   */
+  template <typename MappingType>
+  void
+  update_mapping(const unsigned int level, const MappingType &mapping);
+
+  /**
+   * Return the MatrixFree object of level @p level, which must have been set
+   * up by reinit() before.
+   */
+  std::shared_ptr<const MatrixFreeType>
+  get_matrix_free(const unsigned int level) const;
+
+  /**
+   * Fill the coefficient table of level @p level by calling @p fill with the
+   * MatrixFree object of the level and the table. The table has one row per
+   * cell batch and one column per quadrature point of the quadrature formula
+   * with index @p quad_no. It is only allocated if it does not exist yet or
+   * if its size does not match any more.
+   */
+  void
+  update_coefficient(
+    const unsigned int level,
+    const std::function<void(const MatrixFreeType &, CoefficientTable &)>
+      &                fill,
+    const unsigned int quad_no = 0);
+
+  /**
+   * Return the coefficient table of level @p level. The returned object stays
+   * the same across calls to update_coefficient() as long as its size does
+   * not change.
+   */
+  std::shared_ptr<CoefficientTable>
+  get_coefficient(const unsigned int level) const;
+
+  /**
+   * Initialize the Chebyshev preconditioner @p preconditioner of level @p
+   * level for the operator @p matrix with the parameters @p data. If an
+   * estimate of the largest eigenvalue of this level is available and may
+   * be reused, the estimation in PreconditionChebyshev is switched off by
+   * setting PreconditionChebyshev::AdditionalData::eig_cg_n_iterations to
+   * zero and passing the estimate as
+   * PreconditionChebyshev::AdditionalData::max_eigenvalue. Otherwise, the
+   * eigenvalues are estimated as usual and the estimate is stored for later
+   * calls. The vector @p src only provides the layout for the estimation.
+   *
+   * Estimates are only reused if
+   * PreconditionChebyshev::AdditionalData::smoothing_range is larger than
+   * one, since the smallest eigenvalue is not stored.
+   *
+   * If the eigenvalues need to be estimated and @p similar_level names a
+   * level whose operator has a similar spectrum, e.g., a level of the same
+   * polynomial degree in a geometric hierarchy with Jacobi preconditioning,
+   * the estimate of that level is passed as
+   * PreconditionChebyshev::AdditionalData::max_eigenvalue_guess, which
+   * allows the eigenvalue iteration to stop earlier if
+   * PreconditionChebyshev::AdditionalData::eig_cg_relative_tolerance is set.
+   */
+  template <typename MatrixType, typename VectorType, typename PreconditionerType>
+  void
+  initialize_chebyshev(
+    const unsigned int level,
+    PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>
+      &               preconditioner,
+    const MatrixType &matrix,
+    const typename PreconditionChebyshev<MatrixType,
+                                         VectorType,
+                                         PreconditionerType>::AdditionalData
+      &                data,
+    const VectorType & src,
+    const unsigned int similar_level = numbers::invalid_unsigned_int);
+
+  /**
+   * Invalidate the cached MatrixFree object, coefficient table, and
+   * eigenvalue estimate of level @p level, or of all levels if @p level is
+   * numbers::invalid_unsigned_int.
+   */
+  void
+  invalidate(const unsigned int level = numbers::invalid_unsigned_int);
+
+  /**
+   * Invalidate only the eigenvalue estimate of level @p level, or of all
+   * levels if @p level is numbers::invalid_unsigned_int, e.g., because the
+   * coefficient has changed much.
+   */
+  void
+  invalidate_eigenvalue_estimates(
+    const unsigned int level = numbers::invalid_unsigned_int);
+
+  /**
+   * Return the statistics collected since the construction of this object
+   * or the last call to reset_statistics().
+   */
+  const Statistics &
+  get_statistics() const;
+
+  /**
+   * Reset all counters of the statistics to zero.
+   */
+  void
+  reset_statistics();
+
+  /**
+   * Return the memory consumption of the cached objects in bytes.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The identity of an object derived from Subscriptor. Unlike a plain
+   * pointer, it does not refer to a new object that is created at the
+   * address of a destroyed one, since the destructor of the Subscriptor
+   * clears the flag this class subscribes with.
+   */
+  class SubscriptorToken
+  {
+  public:
+    /**
+     * Constructor. Do not refer to any object.
+     */
+    SubscriptorToken();
+
+    /**
+     * Move constructor.
+     */
+    SubscriptorToken(SubscriptorToken &&other) noexcept;
+
+    /**
+     * Destructor. Unsubscribe from the object, if it is still alive.
+     */
+    ~SubscriptorToken();
+
+    /**
+     * Move assignment.
+     */
+    SubscriptorToken &
+    operator=(SubscriptorToken &&other) noexcept;
+
+    /**
+     * Refer to @p object from now on.
+     */
+    void
+    reset(const Subscriptor &object);
+
+    /**
+     * Return whether this token refers to @p object, which implies that
+     * the object has not been destroyed since reset() was called with it.
+     */
+    bool
+    refers_to(const Subscriptor &object) const;
+
+  private:
+    /**
+     * Unsubscribe from the object, if it is still alive.
+     */
+    void
+    clear();
+
+    const Subscriptor *object;
+
+    /**
+     * The flag cleared by the object when it is destroyed. It is allocated
+     * on the heap, since the object keeps its address.
+     */
+    std::unique_ptr<std::atomic<bool>> object_is_alive;
+  };
+
+  /**
+   * The cached data of one level.
+   */
+  struct LevelData
+  {
+    LevelData();
+
+    std::shared_ptr<MatrixFreeType> matrix_free;
+
+    /**
+     * Data for the consistency check in reinit().
+     */
+    SubscriptorToken                        mapping;
+    SubscriptorToken                        constraints;
+    const DoFHandler<dim> *                 dof_handler;
+    types::global_dof_index                 n_dofs;
+    std::size_t                             n_constraints;
+    std::uint64_t                           constraints_hash;
+    unsigned int                            n_quadrature_points;
+    typename MatrixFreeType::AdditionalData matrix_free_data;
+
+    std::shared_ptr<CoefficientTable> coefficient;
+
+    /**
+     * The reusable estimate of the largest eigenvalue, or a negative number
+     * if there is none.
+     */
+    double       max_eigenvalue_estimate;
+    unsigned int n_eigenvalue_reuses;
+  };
+
+  /**
+   * Return the data of level @p level, creating it if necessary.
+   */
+  LevelData &
+  get_level_data(const unsigned int level);
+
+  /**
+   * Return a hash of all constraint lines of @p constraints, i.e., of the
+   * constrained indices, the entries, and the inhomogeneities.
+   */
+  static std::uint64_t
+  compute_constraints_hash(const AffineConstraints<Number> &constraints);
+
+  /**
+   * Return whether the two sets of parameters @p data_1 and @p data_2 lead
+   * to the same MatrixFree object.
+   */
+  static bool
+  matrix_free_data_matches(
+    const typename MatrixFreeType::AdditionalData &data_1,
+    const typename MatrixFreeType::AdditionalData &data_2);
+
+  AdditionalData additional_data;
+
+  std::vector<LevelData> level_data;
+
+  /**
+   * Connections to the Triangulation::Signals::any_change signals of the
+   * triangulations seen so far.
+   */
+  std::vector<std::pair<const Triangulation<dim> *, boost::signals2::connection>>
+    tria_listeners;
+
+  Statistics statistics;
+};
+
+/*@}*/
+
+/* ------------------------- inline and template functions ----------------- */
+
+#ifndef DOXYGEN
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::AdditionalData::
+  AdditionalData(const bool         reuse_eigenvalue_estimates,
+                 const unsigned int max_n_eigenvalue_reuses,
+                 const double       eigenvalue_safety_factor)
+  : reuse_eigenvalue_estimates(reuse_eigenvalue_estimates)
+  , max_n_eigenvalue_reuses(max_n_eigenvalue_reuses)
+  , eigenvalue_safety_factor(eigenvalue_safety_factor)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::Statistics::
+  Statistics()
+  : n_matrix_free_setups(0)
+  , n_matrix_free_reuses(0)
+  , n_mapping_updates(0)
+  , n_constraints_hashes(0)
+  , n_coefficient_allocations(0)
+  , n_coefficient_updates(0)
+  , n_eigenvalue_estimates(0)
+  , n_eigenvalue_reuses(0)
+  , n_eigenvalue_cg_iterations(0)
+  , matrix_free_setup_time(0.)
+  , eigenvalue_estimation_time(0.)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::Statistics::print(
+  std::ostream &out) const
+{
+  out << "MatrixFree objects:   " << n_matrix_free_setups << " set up, "
+      << n_matrix_free_reuses << " reused, " << n_mapping_updates
+      << " mapping updates" << std::endl;
+  out << "Coefficient tables:   " << n_coefficient_allocations
+      << " allocated, " << n_coefficient_updates << " updated" << std::endl;
+  out << "Eigenvalue estimates: " << n_eigenvalue_estimates << " computed with "
+      << n_eigenvalue_cg_iterations << " CG iterations, "
+      << n_eigenvalue_reuses << " reused" << std::endl;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  SubscriptorToken()
+  : object(nullptr)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  SubscriptorToken(SubscriptorToken &&other) noexcept
+  : object(other.object)
+  , object_is_alive(std::move(other.object_is_alive))
+{
+  other.object = nullptr;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  ~SubscriptorToken()
+{
+  clear();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  SubscriptorToken &
+  MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  operator=(SubscriptorToken &&other) noexcept
+{
+  if (this != &other)
+    {
+      clear();
+      object          = other.object;
+      object_is_alive = std::move(other.object_is_alive);
+      other.object    = nullptr;
+    }
+  return *this;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  reset(const Subscriptor &new_object)
+{
+  if (refers_to(new_object))
+    return;
+
+  clear();
+  object          = &new_object;
+  object_is_alive = std::make_unique<std::atomic<bool>>(false);
+  object->subscribe(object_is_alive.get(), "MGLevelMatrixFreeCache");
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+bool
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  refers_to(const Subscriptor &other_object) const
+{
+  return object == &other_object && object_is_alive != nullptr &&
+         *object_is_alive;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::SubscriptorToken::
+  clear()
+{
+  if (object != nullptr && object_is_alive != nullptr && *object_is_alive)
+    object->unsubscribe(object_is_alive.get(), "MGLevelMatrixFreeCache");
+  object = nullptr;
+  object_is_alive.reset();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::LevelData::
+  LevelData()
+  : dof_handler(nullptr)
+  , n_dofs(0)
+  , n_constraints(0)
+  , constraints_hash(0)
+  , n_quadrature_points(0)
+  , max_eigenvalue_estimate(-1.)
+  , n_eigenvalue_reuses(0)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  MGLevelMatrixFreeCache(const AdditionalData &data)
+  : additional_data(data)
+{}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  ~MGLevelMatrixFreeCache()
+{
+  for (auto &listener : tria_listeners)
+    listener.second.disconnect();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::LevelData &
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::get_level_data(
+  const unsigned int level)
+{
+  if (level >= level_data.size())
+    level_data.resize(level + 1);
+  return level_data[level];
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::uint64_t
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  compute_constraints_hash(const AffineConstraints<Number> &constraints)
+{
+  // 64-bit FNV-1a hash over the bytes of all constraint lines
+  std::uint64_t hash = 14695981039346656037ULL;
+  const auto    add  = [&hash](const auto &value) {
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (unsigned int i = 0; i < sizeof(value); ++i)
+      {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+      }
+  };
+
+  for (const auto &line : constraints.get_lines())
+    {
+      add(line.index);
+      for (const auto &entry : line.entries)
+        {
+          add(entry.first);
+          add(entry.second);
+        }
+      add(line.inhomogeneity);
+    }
+  return hash;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+bool
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  matrix_free_data_matches(
+    const typename MatrixFreeType::AdditionalData &data_1,
+    const typename MatrixFreeType::AdditionalData &data_2)
+{
+  return data_1.tasks_parallel_scheme == data_2.tasks_parallel_scheme &&
+         data_1.tasks_block_size == data_2.tasks_block_size &&
+         data_1.mapping_update_flags == data_2.mapping_update_flags &&
+         data_1.mapping_update_flags_boundary_faces ==
+           data_2.mapping_update_flags_boundary_faces &&
+         data_1.mapping_update_flags_inner_faces ==
+           data_2.mapping_update_flags_inner_faces &&
+         data_1.mapping_update_flags_faces_by_cells ==
+           data_2.mapping_update_flags_faces_by_cells &&
+         data_1.mg_level == data_2.mg_level &&
+         data_1.store_plain_indices == data_2.store_plain_indices &&
+         data_1.initialize_indices == data_2.initialize_indices &&
+         data_1.initialize_mapping == data_2.initialize_mapping &&
+         data_1.overlap_communication_computation ==
+           data_2.overlap_communication_computation &&
+         data_1.hold_all_faces_to_owned_cells ==
+           data_2.hold_all_faces_to_owned_cells &&
+         data_1.cell_vectorization_category ==
+           data_2.cell_vectorization_category &&
+         data_1.cell_vectorization_categories_strict ==
+           data_2.cell_vectorization_categories_strict &&
+         data_1.allow_ghosted_vectors_in_loops ==
+           data_2.allow_ghosted_vectors_in_loops &&
+         data_1.use_fast_hanging_node_algorithm ==
+           data_2.use_fast_hanging_node_algorithm &&
+         data_1.communicator_sm == data_2.communicator_sm;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename QuadratureType, typename MappingType>
+std::shared_ptr<
+  const typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+    MatrixFreeType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::reinit(
+  const unsigned int                               level,
+  const MappingType &                              mapping,
+  const DoFHandler<dim> &                          dof_handler,
+  const AffineConstraints<Number> &                constraints,
+  const QuadratureType &                           quadrature,
+  const typename MatrixFreeType::AdditionalData &matrix_free_data)
+{
+  LevelData &data = get_level_data(level);
+
+  const types::global_dof_index n_dofs =
+    matrix_free_data.mg_level == numbers::invalid_unsigned_int ?
+      dof_handler.n_dofs() :
+      dof_handler.n_dofs(matrix_free_data.mg_level);
+
+  // the constraints only need to be hashed if they are a different object
+  // than the ones of the cached object and all cheaper checks pass
+  const bool cheap_checks_pass =
+    data.matrix_free.get() != nullptr && data.mapping.refers_to(mapping) &&
+    data.dof_handler == &dof_handler && data.n_dofs == n_dofs &&
+    data.n_constraints == constraints.n_constraints() &&
+    data.n_quadrature_points == quadrature.size() &&
+    matrix_free_data_matches(data.matrix_free_data, matrix_free_data);
+
+  if (cheap_checks_pass && data.constraints.refers_to(constraints))
+    {
+      ++statistics.n_matrix_free_reuses;
+      return data.matrix_free;
+    }
+
+  const std::uint64_t constraints_hash =
+    compute_constraints_hash(constraints);
+  ++statistics.n_constraints_hashes;
+
+  if (cheap_checks_pass && data.constraints_hash == constraints_hash)
+    {
+      data.constraints.reset(constraints);
+      ++statistics.n_matrix_free_reuses;
+      return data.matrix_free;
+    }
+
+  // listen to changes of the mesh, which invalidate all levels
+  const Triangulation<dim> *tria = &dof_handler.get_triangulation();
+  if (std::find_if(tria_listeners.begin(),
+                   tria_listeners.end(),
+                   [&](const auto &listener) {
+                     return listener.first == tria;
+                   }) == tria_listeners.end())
+    tria_listeners.emplace_back(tria, tria->signals.any_change.connect([this]() {
+      this->invalidate();
+    }));
+
+  Timer timer;
+
+  // the index and mapping data might be shared with operators that are
+  // still alive, so do not reinit the old object in place
+  data.matrix_free = std::make_shared<MatrixFreeType>();
+  data.matrix_free->reinit(
+    mapping, dof_handler, constraints, quadrature, matrix_free_data);
+
+  data.mapping.reset(mapping);
+  data.constraints.reset(constraints);
+  data.dof_handler             = &dof_handler;
+  data.n_dofs                  = n_dofs;
+  data.n_constraints           = constraints.n_constraints();
+  data.constraints_hash        = constraints_hash;
+  data.n_quadrature_points     = quadrature.size();
+  data.matrix_free_data        = matrix_free_data;
+  data.max_eigenvalue_estimate = -1.;
+  data.n_eigenvalue_reuses     = 0;
+
+  ++statistics.n_matrix_free_setups;
+  statistics.matrix_free_setup_time += timer.wall_time();
+
+  return data.matrix_free;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename MappingType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::update_mapping(
+  const unsigned int level,
+  const MappingType &mapping)
+{
+  AssertIndexRange(level, level_data.size());
+  LevelData &data = level_data[level];
+  Assert(data.matrix_free.get() != nullptr,
+         ExcMessage("The MatrixFree object of this level has not been set up "
+                    "by reinit()."));
+
+  Timer timer;
+  data.matrix_free->update_mapping(mapping);
+  data.mapping.reset(mapping);
+  data.max_eigenvalue_estimate = -1.;
+  data.n_eigenvalue_reuses     = 0;
+
+  ++statistics.n_mapping_updates;
+  statistics.matrix_free_setup_time += timer.wall_time();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::shared_ptr<
+  const typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+    MatrixFreeType>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::get_matrix_free(
+  const unsigned int level) const
+{
+  AssertIndexRange(level, level_data.size());
+  Assert(level_data[level].matrix_free.get() != nullptr,
+         ExcMessage("The MatrixFree object of this level has not been set up "
+                    "by reinit()."));
+  return level_data[level].matrix_free;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::update_coefficient(
+  const unsigned int level,
+  const std::function<void(const MatrixFreeType &, CoefficientTable &)> &fill,
+  const unsigned int quad_no)
+{
+  AssertIndexRange(level, level_data.size());
+  LevelData &data = level_data[level];
+  Assert(data.matrix_free.get() != nullptr,
+         ExcMessage("The MatrixFree object of this level has not been set up "
+                    "by reinit()."));
+
+  const unsigned int n_cell_batches = data.matrix_free->n_cell_batches();
+  const unsigned int n_q_points     = data.matrix_free->get_n_q_points(quad_no);
+
+  if (data.coefficient.get() == nullptr ||
+      data.coefficient->size(0) != n_cell_batches ||
+      data.coefficient->size(1) != n_q_points)
+    {
+      // keep the object of the table alive if it exists, so that pointers
+      // held by operators stay valid
+      if (data.coefficient.get() == nullptr)
+        data.coefficient = std::make_shared<CoefficientTable>();
+      data.coefficient->reinit(n_cell_batches, n_q_points);
+      ++statistics.n_coefficient_allocations;
+    }
+
+  fill(*data.matrix_free, *data.coefficient);
+  ++statistics.n_coefficient_updates;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::shared_ptr<
+  typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+    CoefficientTable>
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::get_coefficient(
+  const unsigned int level) const
+{
+  AssertIndexRange(level, level_data.size());
+  Assert(level_data[level].coefficient.get() != nullptr,
+         ExcMessage("The coefficient of this level has not been set by "
+                    "update_coefficient()."));
+  return level_data[level].coefficient;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+template <typename MatrixType, typename VectorType, typename PreconditionerType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::initialize_chebyshev(
+  const unsigned int level,
+  PreconditionChebyshev<MatrixType, VectorType, PreconditionerType>
+    &               preconditioner,
+  const MatrixType &matrix,
+  const typename PreconditionChebyshev<MatrixType,
+                                       VectorType,
+                                       PreconditionerType>::AdditionalData
+    &                data,
+  const VectorType & src,
+  const unsigned int similar_level)
+{
+  LevelData &level_info = get_level_data(level);
+
+  const bool reuse = additional_data.reuse_eigenvalue_estimates &&
+                     level_info.max_eigenvalue_estimate > 0. &&
+                     level_info.n_eigenvalue_reuses <
+                       additional_data.max_n_eigenvalue_reuses &&
+                     data.smoothing_range > 1.;
+
+  if (reuse)
+    {
+      auto data_with_estimate                = data;
+      data_with_estimate.eig_cg_n_iterations = 0;
+      data_with_estimate.max_eigenvalue =
+        additional_data.eigenvalue_safety_factor *
+        level_info.max_eigenvalue_estimate;
+      preconditioner.initialize(matrix, data_with_estimate);
+      preconditioner.estimate_eigenvalues(src);
+
+      ++level_info.n_eigenvalue_reuses;
+      ++statistics.n_eigenvalue_reuses;
+    }
+  else
+    {
+      Timer timer;
+
+      auto data_with_guess = data;
+      if (similar_level < level_data.size() && similar_level != level &&
+          level_data[similar_level].max_eigenvalue_estimate > 0.)
+        data_with_guess.max_eigenvalue_guess =
+          level_data[similar_level].max_eigenvalue_estimate;
+
+      preconditioner.initialize(matrix, data_with_guess);
+      const auto info = preconditioner.estimate_eigenvalues(src);
+
+      if (data.eig_cg_n_iterations > 0)
+        {
+          level_info.max_eigenvalue_estimate = info.max_eigenvalue_estimate;
+          level_info.n_eigenvalue_reuses     = 0;
+          ++statistics.n_eigenvalue_estimates;
+          statistics.n_eigenvalue_cg_iterations += info.cg_iterations;
+          statistics.eigenvalue_estimation_time += timer.wall_time();
+        }
+    }
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::invalidate(
+  const unsigned int level)
+{
+  if (level == numbers::invalid_unsigned_int)
+    {
+      for (auto &data : level_data)
+        data = LevelData();
+    }
+  else if (level < level_data.size())
+    level_data[level] = LevelData();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  invalidate_eigenvalue_estimates(const unsigned int level)
+{
+  for (unsigned int l = 0; l < level_data.size(); ++l)
+    if (level == numbers::invalid_unsigned_int || l == level)
+      {
+        level_data[l].max_eigenvalue_estimate = -1.;
+        level_data[l].n_eigenvalue_reuses     = 0;
+      }
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+const typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+  Statistics &
+  MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::get_statistics()
+    const
+{
+  return statistics;
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+void
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::reset_statistics()
+{
+  statistics = Statistics();
+}
+
+
+
+template <int dim, typename Number, typename VectorizedArrayType>
+std::size_t
+MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::memory_consumption()
+  const
+{
+  std::size_t size = sizeof(*this);
+  for (const auto &data : level_data)
+    {
+      if (data.matrix_free.get() != nullptr)
+        size += data.matrix_free->memory_consumption();
+      if (data.coefficient.get() != nullptr)
+        size += data.coefficient->memory_consumption();
+    }
+  return size;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -20,6 +20,8 @@
 
 #include <deal.II/dofs/dof_handler.h>
 
+#include <deal.II/grid/reference_cell.h>
+
 #include <deal.II/lac/affine_constraints.h>
 #include <deal.II/lac/la_parallel_vector.h>
 
@@ -215,6 +217,12 @@ public:
    *
    * @note The function polynomial_transfer_supported() can be used to
    *   check if the given polynomial coarsening strategy is supported.
+   *
+   * @note Besides tensor-product elements, the polynomial transfer supports
+   *   FE_SimplexP, FE_SimplexDGP, FE_WedgeP, and FE_PyramidP, also on mixed
+   *   meshes, where the elements of the different cell types are combined
+   *   in an hp::FECollection. Each cell type gets its own cell-wise
+   *   transfer matrix, see fast_polynomial_transfer_supported().
    */
   void
   reinit_polynomial_transfer(
@@ -248,15 +256,23 @@ public:
 
   /**
    * Check if a fast templated version of the polynomial transfer between
-   * @p fe_degree_fine and @p fe_degree_coarse is available.
+   * @p fe_degree_fine and @p fe_degree_coarse is available for elements on
+   * the given @p reference_cell.
    *
    * @note Currently, the polynomial coarsening strategies: 1) go-to-one,
    *   2) bisect, and 3) decrease-by-one are precompiled with templates for
-   *   degrees up to 9.
+   *   degrees up to 9 for tensor-product elements. For simplex, wedge, and
+   *   pyramid elements, the cell-wise transfer is a product with a dense
+   *   matrix, whose sizes are precompiled for the transfer between
+   *   FE_SimplexP elements up to degree 3 and FE_WedgeP elements up to
+   *   degree 2. Other combinations use the same matrix-vector product with
+   *   sizes only known at run time.
    */
   static bool
-  fast_polynomial_transfer_supported(const unsigned int fe_degree_fine,
-                                     const unsigned int fe_degree_coarse);
+  fast_polynomial_transfer_supported(
+    const unsigned int   fe_degree_fine,
+    const unsigned int   fe_degree_coarse,
+    const ReferenceCell &reference_cell = ReferenceCells::get_hypercube<dim>());
 
   /**
    * Perform prolongation.
@@ -440,9 +456,10 @@ private:
  * transfer operators of type MGTwoLevelTransfer between each level.
  *
  * This class currently only works for the tensor-product finite elements
- * FE_Q and FE_DGQ and simplex elements FE_SimplexP and FE_SimplexDGP as well as
- * for systems involving multiple components of one of these elements. Other
- * elements are currently not implemented.
+ * FE_Q and FE_DGQ, the simplex elements FE_SimplexP and FE_SimplexDGP, and the
+ * elements FE_WedgeP and FE_PyramidP on mixed meshes, as well as for systems
+ * involving multiple components of one of these elements. Other elements are
+ * currently not implemented.
  */
 template <int dim, typename VectorType>
 class MGTransferGlobalCoarsening : public dealii::MGTransferBase<VectorType>
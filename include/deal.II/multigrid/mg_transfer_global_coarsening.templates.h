@@ -94,6 +94,88 @@ namespace
     const unsigned int degree_coarse;
   };
 
+  /**
+   * Helper class to select the right templated implementation for elements
+   * without tensor-product structure, i.e., simplex, wedge, and pyramid
+   * elements. The cell-wise transfer of these elements is a product with a
+   * dense matrix, whose sizes are the number of degrees of freedom of the
+   * fine and the coarse element. The pairs precompiled here are the ones of
+   * the polynomial coarsening sequences of FE_SimplexP (up to degree 3) and
+   * FE_WedgeP (up to degree 2).
+   */
+  class CellTransferFactoryFull
+  {
+  public:
+    CellTransferFactoryFull(const unsigned int n_dofs_fine,
+                            const unsigned int n_dofs_coarse)
+      : n_dofs_fine(n_dofs_fine)
+      , n_dofs_coarse(n_dofs_coarse)
+    {}
+
+    template <typename Fu>
+    bool
+    run(Fu &fu)
+    {
+      if ((n_dofs_fine == 6) && (n_dofs_coarse == 3))
+        fu.template run_full<6, 3>(); // triangle: P2 -> P1
+      else if ((n_dofs_fine == 10) && (n_dofs_coarse == 3))
+        fu.template run_full<10, 3>(); // triangle: P3 -> P1
+      else if ((n_dofs_fine == 10) && (n_dofs_coarse == 6))
+        fu.template run_full<10, 6>(); // triangle: P3 -> P2
+      else if ((n_dofs_fine == 10) && (n_dofs_coarse == 4))
+        fu.template run_full<10, 4>(); // tetrahedron: P2 -> P1
+      else if ((n_dofs_fine == 20) && (n_dofs_coarse == 4))
+        fu.template run_full<20, 4>(); // tetrahedron: P3 -> P1
+      else if ((n_dofs_fine == 20) && (n_dofs_coarse == 10))
+        fu.template run_full<20, 10>(); // tetrahedron: P3 -> P2
+      else if ((n_dofs_fine == 18) && (n_dofs_coarse == 6))
+        fu.template run_full<18, 6>(); // wedge: P2 -> P1
+      else
+        {
+          // no match -> slow path
+          fu.run_full(n_dofs_fine, n_dofs_coarse);
+          return false; // indicate that slow path has been taken
+        }
+
+      return true; // indicate that fast path has been taken
+    }
+
+  private:
+    const unsigned int n_dofs_fine;
+    const unsigned int n_dofs_coarse;
+  };
+
+
+
+  /**
+   * Return the number of degrees of freedom of a scalar polynomial space of
+   * complete degree @p degree on a simplex, wedge, or pyramid, as used by
+   * FE_SimplexP, FE_WedgeP, and FE_PyramidP, or numbers::invalid_unsigned_int
+   * if there is no such element.
+   */
+  template <int dim>
+  unsigned int
+  n_dofs_non_tensor_product_element(const ReferenceCell &reference_cell,
+                                    const unsigned int   degree)
+  {
+    if (reference_cell.is_simplex())
+      {
+        // binomial coefficient (degree + dim) over dim
+        unsigned int n_dofs = 1;
+        for (unsigned int d = 1; d <= dim; ++d)
+          n_dofs = n_dofs * (degree + d) / d;
+        return n_dofs;
+      }
+    else if (reference_cell == ReferenceCells::Wedge)
+      return (degree + 1) * (degree + 1) * (degree + 2) / 2;
+    else if (reference_cell == ReferenceCells::Pyramid && degree == 1)
+      return 5;
+
+    return numbers::invalid_unsigned_int;
+  }
+
+
+
   /**
    * Helper class containing the cell-wise prolongation operation.
    */
@@ -133,6 +215,25 @@ namespace
                             degree_fine_ + 1);
     }
 
+    template <int n_dofs_fine, int n_dofs_coarse>
+    void
+    run_full()
+    {
+      AssertDimension(prolongation_matrix.size(), n_dofs_coarse * n_dofs_fine);
+
+      internal::FEEvaluationImplBasisChange<
+        internal::evaluate_general,
+        internal::EvaluatorQuantity::value,
+        1,
+        n_dofs_coarse,
+        n_dofs_fine,
+        Number,
+        Number>::do_forward(1,
+                            prolongation_matrix,
+                            evaluation_data_coarse,
+                            evaluation_data_fine);
+    }
+
     void
     run_full(const unsigned int n_dofs_fine, const unsigned int n_dofs_coarse)
     {
@@ -200,6 +301,26 @@ namespace
                              degree_fine_ + 1);
     }
 
+    template <int n_dofs_fine, int n_dofs_coarse>
+    void
+    run_full()
+    {
+      AssertDimension(prolongation_matrix.size(), n_dofs_coarse * n_dofs_fine);
+
+      internal::FEEvaluationImplBasisChange<
+        internal::evaluate_general,
+        internal::EvaluatorQuantity::value,
+        1,
+        n_dofs_coarse,
+        n_dofs_fine,
+        Number,
+        Number>::do_backward(1,
+                             prolongation_matrix,
+                             false,
+                             evaluation_data_fine,
+                             evaluation_data_coarse);
+    }
+
     void
     run_full(const unsigned int n_dofs_fine, const unsigned int n_dofs_coarse)
     {
@@ -236,6 +357,15 @@ namespace
     run(const unsigned int = numbers::invalid_unsigned_int,
         const unsigned int = numbers::invalid_unsigned_int)
     {}
+
+    template <int n_dofs_fine, int n_dofs_coarse>
+    void
+    run_full()
+    {}
+
+    void
+    run_full(const unsigned int, const unsigned int)
+    {}
   };
 
 } // namespace
@@ -1752,7 +1882,7 @@ namespace internal
                 .reference_cell();
 
             Assert(reference_cell ==
-                     dof_handler_coarse.get_fe(fe_index_pair.first.second)
+                     dof_handler_coarse.get_fe(fe_index_pair.first.first)
                        .reference_cell(),
                    ExcNotImplemented());
 
@@ -1894,7 +2024,7 @@ namespace internal
               .reference_cell();
 
           Assert(reference_cell ==
-                   dof_handler_coarse.get_fe(fe_index_pair_.first.second)
+                   dof_handler_coarse.get_fe(fe_index_pair_.first.first)
                      .reference_cell(),
                  ExcNotImplemented());
 
@@ -2351,6 +2481,9 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
       const unsigned int n_scalar_dofs_coarse =
         scheme.dofs_per_cell_coarse / n_components;
 
+      CellTransferFactoryFull cell_transfer_full(n_scalar_dofs_fine,
+                                                 n_scalar_dofs_coarse);
+
       for (unsigned int cell = 0; cell < scheme.n_coarse_cells; cell += n_lanes)
         {
           const unsigned int n_lanes_filled =
@@ -2379,8 +2512,7 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
               if (scheme.prolongation_matrix_1d.size() > 0)
                 cell_transfer.run(cell_prolongator);
               else
-                cell_prolongator.run_full(n_scalar_dofs_fine,
-                                          n_scalar_dofs_coarse);
+                cell_transfer_full.run(cell_prolongator);
             }
           // ------------------------------ fine -------------------------------
 
@@ -2506,6 +2638,9 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
       const unsigned int n_scalar_dofs_coarse =
         scheme.dofs_per_cell_coarse / n_components;
 
+      CellTransferFactoryFull cell_transfer_full(n_scalar_dofs_fine,
+                                                 n_scalar_dofs_coarse);
+
       for (unsigned int cell = 0; cell < scheme.n_coarse_cells; cell += n_lanes)
         {
           const unsigned int n_lanes_filled =
@@ -2543,8 +2678,7 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
               if (scheme.prolongation_matrix_1d.size() > 0)
                 cell_transfer.run(cell_restrictor);
               else
-                cell_restrictor.run_full(n_scalar_dofs_fine,
-                                         n_scalar_dofs_coarse);
+                cell_transfer_full.run(cell_restrictor);
             }
           // ----------------------------- coarse ------------------------------
 
@@ -2630,6 +2764,9 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
       const unsigned int n_scalar_dofs_coarse =
         scheme.dofs_per_cell_coarse / n_components;
 
+      CellTransferFactoryFull cell_transfer_full(n_scalar_dofs_fine,
+                                                 n_scalar_dofs_coarse);
+
       for (unsigned int cell = 0; cell < scheme.n_coarse_cells; cell += n_lanes)
         {
           const unsigned int n_lanes_filled =
@@ -2659,8 +2796,7 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
               if (scheme.restriction_matrix_1d.size() > 0)
                 cell_transfer.run(cell_restrictor);
               else
-                cell_restrictor.run_full(n_scalar_dofs_fine,
-                                         n_scalar_dofs_coarse);
+                cell_transfer_full.run(cell_restrictor);
             }
           // ----------------------------- coarse ------------------------------
 
@@ -2825,12 +2961,31 @@ MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::reinit(
 template <int dim, typename Number>
 bool
 MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<Number>>::
-  fast_polynomial_transfer_supported(const unsigned int fe_degree_fine,
-                                     const unsigned int fe_degree_coarse)
+  fast_polynomial_transfer_supported(const unsigned int   fe_degree_fine,
+                                     const unsigned int   fe_degree_coarse,
+                                     const ReferenceCell &reference_cell)
 {
-  CellTransferFactory cell_transfer(fe_degree_fine, fe_degree_coarse);
   CellProlongatorTest cell_transfer_test;
 
+  if (reference_cell == ReferenceCells::get_hypercube<dim>())
+    {
+      CellTransferFactory cell_transfer(fe_degree_fine, fe_degree_coarse);
+      return cell_transfer.run(cell_transfer_test);
+    }
+
+  // the identity does not need any cell-wise transfer
+  if (fe_degree_fine == fe_degree_coarse)
+    return true;
+
+  const unsigned int n_dofs_fine =
+    n_dofs_non_tensor_product_element<dim>(reference_cell, fe_degree_fine);
+  const unsigned int n_dofs_coarse =
+    n_dofs_non_tensor_product_element<dim>(reference_cell, fe_degree_coarse);
+  if (n_dofs_fine == numbers::invalid_unsigned_int ||
+      n_dofs_coarse == numbers::invalid_unsigned_int)
+    return false;
+
+  CellTransferFactoryFull cell_transfer(n_dofs_fine, n_dofs_coarse);
   return cell_transfer.run(cell_transfer_test);
 }
 
@@ -143,6 +143,18 @@ namespace Particles
     Handle
     register_particle();
 
+    /**
+     * Register @p n_particles new particles at once and return the handle
+     * of the first one. In contrast to calling register_particle()
+     * repeatedly, the memory for the new particles is appended to the pool
+     * in one step, so that the new handles are contiguous, i.e., they are
+     * given by the range `[first, first + n_particles)`, and the data of
+     * the new slots is initialized in parallel. Slots that have been freed
+     * by deregister_particle() are not reused by this function.
+     */
+    Handle
+    register_particles(const unsigned int n_particles);
+
     /**
      * Return a handle obtained by register_particle() and mark the memory
      * allocated for storing the particle's data as free for re-use.
@@ -230,7 +242,8 @@ namespace Particles
      * container. This makes sure memory access is contiguous with actual
      * memory location. Because the ordering is given in the input argument
      * the complexity of this function is $O(N)$ where $N$ is the number of
-     * elements in the input argument.
+     * elements in the input argument. The data is copied in parallel if
+     * several threads are available.
      */
     void
     sort_memory_slots(const std::vector<Handle> &handles_to_sort);
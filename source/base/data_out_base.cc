@@ -34,6 +34,7 @@
 #include <deal.II/base/data_out_base.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -107,6 +108,13 @@ namespace
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then written to the given stream.
+   *
+   * The data is split into blocks of at most 64 KiB that are compressed
+   * independently of each other (and in parallel, if several threads are
+   * available) and written with the multi-block header also used by VTK's
+   * own zlib compressor. Since the history window of zlib only spans 32 KiB,
+   * the splitting does not noticeably deteriorate the compression ratio. Data
+   * that fits into a single block is written exactly as before.
    */
   template <typename T>
   void
@@ -116,36 +124,74 @@ namespace
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(data.size() * sizeof(T));
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err =
-          compress2(&compressed_data[0],
-                    &compressed_data_length,
-                    reinterpret_cast<const Bytef *>(data.data()),
-                    data.size() * sizeof(T),
-                    get_zlib_compression_level(flags.compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
-
-        // now encode the compression header
-        const uint32_t compression_header[4] = {
-          1,                                              /* number of blocks */
-          static_cast<uint32_t>(data.size() * sizeof(T)), /* size of block */
-          static_cast<uint32_t>(data.size() *
-                                sizeof(T)), /* size of last block */
-          static_cast<uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        const std::size_t uncompressed_size = data.size() * sizeof(T);
+        const std::size_t block_size        = 1 << 16;
+        const std::size_t n_blocks =
+          (uncompressed_size + block_size - 1) / block_size;
+        const std::size_t last_block_size =
+          uncompressed_size - (n_blocks - 1) * block_size;
+
+        // compress the blocks independently into separate buffers
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        const auto raw_data = reinterpret_cast<const Bytef *>(data.data());
+        const int  level = get_zlib_compression_level(flags.compression_level);
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          n_blocks,
+          [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b)
+              {
+                const uLong size =
+                  (b == n_blocks - 1) ? last_block_size : block_size;
+                auto compressed_length = compressBound(size);
+                compressed_blocks[b].resize(compressed_length);
+
+                int err = compress2(compressed_blocks[b].data(),
+                                    &compressed_length,
+                                    raw_data + b * block_size,
+                                    size,
+                                    level);
+                (void)err;
+                Assert(err == Z_OK, ExcInternalError());
+
+                // Discard the unnecessary bytes
+                compressed_blocks[b].resize(compressed_length);
+              }
+          },
+          1);
+
+        // now encode the compression header, consisting of the number of
+        // blocks, the size of a block, the size of the last block, and the
+        // list of compressed sizes of the blocks
+        std::vector<uint32_t> compression_header(3 + n_blocks);
+        compression_header[0] = static_cast<uint32_t>(n_blocks);
+        compression_header[1] =
+          static_cast<uint32_t>(n_blocks == 1 ? uncompressed_size : block_size);
+        compression_header[2] = static_cast<uint32_t>(last_block_size);
+
+        std::size_t total_compressed_size = 0;
+        for (std::size_t b = 0; b < n_blocks; ++b)
+          {
+            compression_header[3 + b] =
+              static_cast<uint32_t>(compressed_blocks[b].size());
+            total_compressed_size += compressed_blocks[b].size();
+          }
+
+        // the compressed blocks are stored contiguously after the header
+        std::vector<unsigned char> compressed_data;
+        compressed_data.reserve(total_compressed_size);
+        for (const auto &block : compressed_blocks)
+          compressed_data.insert(compressed_data.end(),
+                                 block.begin(),
+                                 block.end());
 
         const auto header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
+          reinterpret_cast<const unsigned char *>(compression_header.data());
 
         output_stream << Utilities::encode_base64(
-                           {header_start, header_start + 4 * sizeof(uint32_t)})
+                           {header_start,
+                            header_start +
+                              compression_header.size() * sizeof(uint32_t)})
                       << Utilities::encode_base64(compressed_data);
       }
   }
@@ -7212,6 +7258,22 @@ DataOutInterface<dim, spacedim>::DataOutInterface()
 
 
 
+template <int dim, int spacedim>
+DataOutInterface<dim, spacedim>::~DataOutInterface()
+{
+  // exceptions must not leave the destructor, so errors of writes nobody
+  // has waited for are lost at this point
+  for (const auto &task : background_writes)
+    try
+      {
+        task.join();
+      }
+    catch (...)
+      {}
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_dx(std::ostream &out) const
@@ -7325,6 +7387,56 @@ DataOutInterface<dim, spacedim>::write_vtu(std::ostream &out) const
                          out);
 }
 
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::write_vtu_in_background(
+  const std::string &filename,
+  const unsigned int max_pending_writes) const
+{
+  Assert(max_pending_writes > 0,
+         ExcMessage("At least one write must be allowed to be pending."));
+
+  // bound the number of snapshots, and thus the memory, held at a time
+  while (background_writes.size() >= max_pending_writes)
+    {
+      const Threads::Task<void> oldest = background_writes.front();
+      background_writes.pop_front();
+      oldest.join();
+    }
+
+  // the patches are going to be overwritten by the next call to
+  // build_patches(), so the task must work on a copy of all data
+  background_writes.push_back(
+    Threads::new_task([patches       = get_patches(),
+                       dataset_names = get_dataset_names(),
+                       nonscalar_data_ranges = get_nonscalar_data_ranges(),
+                       flags                 = vtk_flags,
+                       filename]() {
+      std::ofstream out(filename);
+      AssertThrow(out, ExcFileNotOpen(filename));
+      DataOutBase::write_vtu(
+        patches, dataset_names, nonscalar_data_ranges, flags, out);
+    }));
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutInterface<dim, spacedim>::wait_for_background_writes() const
+{
+  while (!background_writes.empty())
+    {
+      const Threads::Task<void> oldest = background_writes.front();
+      background_writes.pop_front();
+      oldest.join();
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_svg(std::ostream &out) const
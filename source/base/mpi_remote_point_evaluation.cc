@@ -28,6 +28,8 @@
 #include <deal.II/grid/grid_tools_cache.h>
 #include <deal.II/grid/tria.h>
 
+#include <numeric>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -79,6 +81,14 @@ namespace Utilities
       this->tria    = &tria;
       this->mapping = &mapping;
 
+      // the cache marks its data structures for update itself when the
+      // triangulation changes, so it only needs to be recreated for a
+      // different triangulation or mapping
+      if (cache == nullptr || &cache->get_triangulation() != &tria ||
+          &cache->get_mapping() != &mapping)
+        cache =
+          std::make_unique<GridTools::Cache<dim, spacedim>>(tria, mapping);
+
       std::vector<BoundingBox<spacedim>> local_boxes;
       for (const auto &cell : tria.active_cell_iterators())
         if (cell->is_locally_owned())
@@ -95,11 +105,9 @@ namespace Utilities
       const auto global_bboxes =
         Utilities::MPI::all_gather(tria.get_communicator(), local_reduced_box);
 
-      const GridTools::Cache<dim, spacedim> cache(tria, mapping);
-
       const auto data =
         GridTools::internal::distributed_compute_point_locations(
-          cache,
+          *cache,
           points,
           global_bboxes,
           tolerance,
@@ -163,6 +171,145 @@ namespace Utilities
     }
 
 
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::reinit_incremental(
+      const std::vector<Point<spacedim>> &points)
+    {
+#ifndef DEAL_II_WITH_MPI
+      Assert(false, ExcNeedsMPI());
+      (void)points;
+      return false;
+#else
+      Assert(tria != nullptr && mapping != nullptr,
+             ExcMessage("The function reinit() needs to be called before "
+                        "the data structures can be updated."));
+
+      const MPI_Comm comm = tria->get_communicator();
+
+      // the previous communication pattern can only be reused if every
+      // point has been assigned to exactly one cell; the local search below
+      // is only implemented for hypercube cells
+      const bool pattern_is_reusable =
+        Utilities::MPI::min(static_cast<unsigned int>(
+                              is_ready() && unique_mapping &&
+                              points.size() + 1 == point_ptrs.size() &&
+                              tria->all_reference_cells_are_hyper_cube()),
+                            comm) == 1;
+      if (pattern_is_reusable == false)
+        {
+          reinit(points, *tria, *mapping);
+          return false;
+        }
+
+      // send the new positions to the owners of the previous cells, which
+      // check whether the points are still inside and otherwise search the
+      // locally owned cells around them, using the cache set up during
+      // reinit()
+
+      std::vector<std::pair<int, int>> new_cells(
+        cell_data.reference_point_values.size());
+      std::vector<Point<dim>> new_reference_points(
+        cell_data.reference_point_values.size());
+      bool all_points_found = true;
+
+      std::vector<Point<spacedim>> buffer;
+      process_and_evaluate<Point<spacedim>>(
+        points,
+        buffer,
+        [&](const ArrayView<const Point<spacedim>> &new_points,
+            const CellData &                        cell_data) {
+          for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+            {
+              const typename Triangulation<dim, spacedim>::active_cell_iterator
+                cell(&*tria,
+                     cell_data.cells[c].first,
+                     cell_data.cells[c].second);
+
+              for (unsigned int q = cell_data.reference_point_ptrs[c];
+                   q < cell_data.reference_point_ptrs[c + 1];
+                   ++q)
+                {
+                  new_cells[q] = cell_data.cells[c];
+
+                  try
+                    {
+                      const Point<dim> p_unit =
+                        mapping->transform_real_to_unit_cell(cell,
+                                                             new_points[q]);
+                      if (GeometryInfo<dim>::is_inside_unit_cell(p_unit,
+                                                                 tolerance))
+                        {
+                          new_reference_points[q] = p_unit;
+                          continue;
+                        }
+                    }
+                  catch (typename Mapping<dim>::ExcTransformationFailed &)
+                    {}
+
+                  // the search might return the closest cell for points
+                  // outside the domain, so check the reference point again
+                  const auto cell_and_reference_point =
+                    GridTools::find_active_cell_around_point(
+                      *cache, new_points[q], cell, {}, tolerance);
+
+                  if (cell_and_reference_point.first.state() ==
+                        IteratorState::valid &&
+                      cell_and_reference_point.first->is_locally_owned() &&
+                      GeometryInfo<dim>::is_inside_unit_cell(
+                        cell_and_reference_point.second, tolerance))
+                    {
+                      new_cells[q] = {cell_and_reference_point.first->level(),
+                                      cell_and_reference_point.first->index()};
+                      new_reference_points[q] = cell_and_reference_point.second;
+                    }
+                  else
+                    all_points_found = false;
+                }
+            }
+        });
+
+      if (Utilities::MPI::min(static_cast<unsigned int>(all_points_found),
+                              comm) == 0)
+        {
+          reinit(points, *tria, *mapping);
+          return false;
+        }
+
+      // the points stay on the same processes, so only the cell data and the
+      // permutation into the send buffer need to be regrouped by cell
+      std::vector<unsigned int> entries(new_cells.size());
+      std::iota(entries.begin(), entries.end(), 0);
+      std::stable_sort(entries.begin(),
+                       entries.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return new_cells[a] < new_cells[b];
+                       });
+
+      const std::vector<unsigned int> old_send_permutation = send_permutation;
+
+      cell_data = {};
+      for (unsigned int i = 0; i < entries.size(); ++i)
+        {
+          const unsigned int q = entries[i];
+          if (cell_data.cells.empty() || cell_data.cells.back() != new_cells[q])
+            {
+              cell_data.cells.emplace_back(new_cells[q]);
+              cell_data.reference_point_ptrs.emplace_back(i);
+            }
+          cell_data.reference_point_values.emplace_back(
+            new_reference_points[q]);
+          send_permutation[i] = old_send_permutation[q];
+        }
+      cell_data.reference_point_ptrs.emplace_back(
+        cell_data.reference_point_values.size());
+
+      return true;
+#endif
+    }
+
+
+
     template <int dim, int spacedim>
     const std::vector<unsigned int> &
     RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
@@ -199,6 +346,18 @@ namespace Utilities
 
 
 
+    template <int dim, int spacedim>
+    const GridTools::Cache<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_cache() const
+    {
+      Assert(cache != nullptr,
+             ExcMessage("The function reinit() needs to be called before "
+                        "the cache can be accessed."));
+      return *cache;
+    }
+
+
+
     template <int dim, int spacedim>
     bool
     RemotePointEvaluation<dim, spacedim>::is_ready() const
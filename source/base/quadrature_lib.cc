@@ -2020,6 +2020,51 @@ namespace
 
 
 
+template <int dim>
+QCollapsedSimplex<dim>::QCollapsedSimplex(const unsigned int n_points_1D)
+  : QSimplex<dim>(Quadrature<dim>())
+{
+  Assert(n_points_1D > 0, ExcMessage("Need at least one point per direction"));
+
+  if (dim == 0 || dim == 1)
+    {
+      const dealii::QGauss<dim> quad(n_points_1D);
+
+      this->quadrature_points = quad.get_points();
+      this->weights           = quad.get_weights();
+      return;
+    }
+
+  // tensor product of Gauss points in the collapsed coordinates (a,b,c),
+  // mapped by x = a(1-b)(1-c), y = b(1-c), z = c with the determinant of
+  // the map (1-b)(1-c)^2 absorbed into the weights
+  const dealii::QGauss<1> quad_1d(n_points_1D);
+  const unsigned int      n_z = dim > 2 ? n_points_1D : 1;
+  for (unsigned int k = 0; k < n_z; ++k)
+    for (unsigned int j = 0; j < n_points_1D; ++j)
+      for (unsigned int i = 0; i < n_points_1D; ++i)
+        {
+          const double a = quad_1d.point(i)[0];
+          const double b = quad_1d.point(j)[0];
+          const double c = dim > 2 ? quad_1d.point(k)[0] : 0.;
+
+          Point<dim> p;
+          p[0] = a * (1. - b) * (1. - c);
+          p[1] = b * (1. - c);
+          if (dim > 2)
+            p[2] = c;
+
+          double weight = quad_1d.weight(i) * quad_1d.weight(j) * (1. - b);
+          if (dim > 2)
+            weight *= quad_1d.weight(k) * (1. - c) * (1. - c);
+
+          this->quadrature_points.push_back(p);
+          this->weights.push_back(weight);
+        }
+}
+
+
+
 template <int dim>
 QIteratedSimplex<dim>::QIteratedSimplex(const Quadrature<dim> &base_quad,
                                         const unsigned int     n_copies)
@@ -2207,4 +2252,9 @@ template class QWitherdenVincentSimplex<1>;
 template class QWitherdenVincentSimplex<2>;
 template class QWitherdenVincentSimplex<3>;
 
+template class QCollapsedSimplex<0>;
+template class QCollapsedSimplex<1>;
+template class QCollapsedSimplex<2>;
+template class QCollapsedSimplex<3>;
+
 DEAL_II_NAMESPACE_CLOSE
@@ -426,9 +426,6 @@ namespace parallel
     Triangulation<dim, spacedim>::save(const std::string &filename) const
     {
 #ifdef DEAL_II_WITH_MPI
-      AssertThrow(this->cell_attached_data.pack_callbacks_variable.size() == 0,
-                  ExcNotImplemented());
-
       Assert(
         this->cell_attached_data.n_attached_deserialize == 0,
         ExcMessage(
@@ -454,9 +451,6 @@ namespace parallel
                             this->mpi_communicator);
       AssertThrowMPI(ierr);
 
-      global_first_cell *= sizeof(unsigned int);
-
-
       if (myrank == 0)
         {
           std::string   fname = std::string(filename) + ".info";
@@ -480,6 +474,10 @@ namespace parallel
         MPI_Info info;
         int      ierr = MPI_Info_create(&info);
         AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_write"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
 
         const std::string fname_tria = filename + "_triangulation.data";
 
@@ -526,22 +524,22 @@ namespace parallel
         AssertThrowMPI(ierr);
 
         // Write offsets to file.
-        ierr = MPI_File_write_at(fh,
-                                 myrank * sizeof(unsigned int),
-                                 DEAL_II_MPI_CONST_CAST(&buffer_size),
-                                 1,
-                                 MPI_UNSIGNED,
-                                 MPI_STATUS_IGNORE);
+        ierr = MPI_File_write_at_all(fh,
+                                     myrank * sizeof(unsigned int),
+                                     DEAL_II_MPI_CONST_CAST(&buffer_size),
+                                     1,
+                                     MPI_UNSIGNED,
+                                     MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         // Write buffers to file.
-        ierr = MPI_File_write_at(fh,
-                                 mpisize * sizeof(unsigned int) +
-                                   offset, // global position in file
-                                 DEAL_II_MPI_CONST_CAST(buffer.data()),
-                                 buffer.size(), // local buffer
-                                 MPI_CHAR,
-                                 MPI_STATUS_IGNORE);
+        ierr = MPI_File_write_at_all(fh,
+                                     mpisize * sizeof(unsigned int) +
+                                       offset, // global position in file
+                                     DEAL_II_MPI_CONST_CAST(buffer.data()),
+                                     buffer.size(), // local buffer
+                                     MPI_CHAR,
+                                     MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         ierr = MPI_File_close(&fh);
@@ -564,22 +562,6 @@ namespace parallel
       Assert(this->n_cells() == 0,
              ExcMessage("load() only works if the Triangulation is empty!"));
 
-      // Compute global offset for each rank.
-      unsigned int n_locally_owned_cells = this->n_locally_owned_active_cells();
-
-      unsigned int global_first_cell = 0;
-
-      int ierr = MPI_Exscan(&n_locally_owned_cells,
-                            &global_first_cell,
-                            1,
-                            MPI_UNSIGNED,
-                            MPI_SUM,
-                            this->mpi_communicator);
-      AssertThrowMPI(ierr);
-
-      global_first_cell *= sizeof(unsigned int);
-
-
       unsigned int version, numcpus, attached_count_fixed,
         attached_count_variable, n_global_active_cells;
       {
@@ -594,8 +576,6 @@ namespace parallel
 
       AssertThrow(version == 4,
                   ExcMessage("Incompatible version found in .info file."));
-      Assert(this->n_global_active_cells() == n_global_active_cells,
-             ExcMessage("Number of global active cells differ!"));
 
       // Load description and construct the triangulation.
       {
@@ -610,6 +590,10 @@ namespace parallel
         MPI_Info info;
         int      ierr = MPI_Info_create(&info);
         AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_read"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
 
         const std::string fname_tria = filename + "_triangulation.data";
 
@@ -627,12 +611,12 @@ namespace parallel
         // Read offsets from file.
         unsigned int buffer_size;
 
-        ierr = MPI_File_read_at(fh,
-                                myrank * sizeof(unsigned int),
-                                DEAL_II_MPI_CONST_CAST(&buffer_size),
-                                1,
-                                MPI_UNSIGNED,
-                                MPI_STATUS_IGNORE);
+        ierr = MPI_File_read_at_all(fh,
+                                    myrank * sizeof(unsigned int),
+                                    DEAL_II_MPI_CONST_CAST(&buffer_size),
+                                    1,
+                                    MPI_UNSIGNED,
+                                    MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         unsigned int offset = 0;
@@ -647,13 +631,13 @@ namespace parallel
 
         // Read buffers from file.
         std::vector<char> buffer(buffer_size);
-        ierr = MPI_File_read_at(fh,
-                                mpisize * sizeof(unsigned int) +
-                                  offset, // global position in file
-                                DEAL_II_MPI_CONST_CAST(buffer.data()),
-                                buffer.size(), // local buffer
-                                MPI_CHAR,
-                                MPI_STATUS_IGNORE);
+        ierr = MPI_File_read_at_all(fh,
+                                    mpisize * sizeof(unsigned int) +
+                                      offset, // global position in file
+                                    DEAL_II_MPI_CONST_CAST(buffer.data()),
+                                    buffer.size(), // local buffer
+                                    MPI_CHAR,
+                                    MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         ierr = MPI_File_close(&fh);
@@ -669,6 +653,23 @@ namespace parallel
         this->create_triangulation(construction_data);
       }
 
+      Assert(this->n_global_active_cells() == n_global_active_cells,
+             ExcMessage("Number of global active cells differ!"));
+
+      // Compute global offset for each rank, which is only possible once the
+      // triangulation has been created.
+      unsigned int n_locally_owned_cells = this->n_locally_owned_active_cells();
+
+      unsigned int global_first_cell = 0;
+
+      int ierr = MPI_Exscan(&n_locally_owned_cells,
+                            &global_first_cell,
+                            1,
+                            MPI_UNSIGNED,
+                            MPI_SUM,
+                            this->mpi_communicator);
+      AssertThrowMPI(ierr);
+
       // clear all of the callback data, as explained in the documentation of
       // register_data_attach()
       this->cell_attached_data.n_attached_data_sets = 0;
@@ -21,6 +21,13 @@
 #include <deal.II/distributed/tria_base.h>
 
 #include <deal.II/grid/cell_id_translator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+
+#include <queue>
+#include <set>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -337,6 +344,282 @@ namespace RepartitioningPolicyTools
   }
 
 
+
+  template <int dim, int spacedim>
+  GraphPartitioningPolicy<dim, spacedim>::GraphPartitioningPolicy(
+    const SparsityTools::Partitioner partitioner,
+    const unsigned int               max_cells_per_graph_vertex)
+    : partitioner(partitioner)
+    , max_cells_per_graph_vertex(max_cells_per_graph_vertex)
+  {
+    AssertThrow(max_cells_per_graph_vertex > 0,
+                ExcMessage("A vertex of the graph needs to contain at least "
+                           "one cell."));
+  }
+
+
+
+  template <int dim, int spacedim>
+  GraphPartitioningPolicy<dim, spacedim>::GraphPartitioningPolicy(
+    const std::function<
+      unsigned int(const typename Triangulation<dim, spacedim>::cell_iterator &,
+                   const typename Triangulation<dim, spacedim>::CellStatus)>
+      &                              weighting_function,
+    const SparsityTools::Partitioner partitioner,
+    const unsigned int               max_cells_per_graph_vertex)
+    : partitioner(partitioner)
+    , max_cells_per_graph_vertex(max_cells_per_graph_vertex)
+    , weighting_function(weighting_function)
+  {
+    AssertThrow(max_cells_per_graph_vertex > 0,
+                ExcMessage("A vertex of the graph needs to contain at least "
+                           "one cell."));
+  }
+
+
+
+  template <int dim, int spacedim>
+  LinearAlgebra::distributed::Vector<double>
+  GraphPartitioningPolicy<dim, spacedim>::partition(
+    const Triangulation<dim, spacedim> &tria_in) const
+  {
+#ifndef DEAL_II_WITH_MPI
+    (void)tria_in;
+    return {};
+#else
+
+    const auto tria =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &tria_in);
+
+    Assert(tria, ExcNotImplemented());
+
+    const auto partitioner_cells =
+      tria->global_active_cell_index_partitioner().lock();
+
+    const auto mpi_communicator = tria_in.get_communicator();
+    const auto n_subdomains = Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    const unsigned int n_locally_owned_cells =
+      partitioner_cells->locally_owned_size();
+
+    // step 1) determine the neighbors of the locally owned cells and, if
+    // requested, their weights. as in
+    // GridTools::get_face_connectivity_of_cells(), we only consider neighbors
+    // without children, so that the connection between cells on different
+    // levels is determined by the finer one
+    std::vector<std::vector<types::global_cell_index>> neighbors(
+      n_locally_owned_cells);
+    std::vector<unsigned int> weights(n_locally_owned_cells, 1);
+
+    for (const auto &cell : tria->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const unsigned int index = partitioner_cells->global_to_local(
+            cell->global_active_cell_index());
+          if (weighting_function)
+            weights[index] = weighting_function(
+              cell, Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST);
+
+          for (const auto f : cell->face_indices())
+            if ((cell->at_boundary(f) == false) &&
+                (cell->neighbor(f)->has_children() == false))
+              neighbors[index].push_back(
+                cell->neighbor(f)->global_active_cell_index());
+        }
+
+    // step 2) combine up to max_cells_per_graph_vertex connected locally
+    // owned cells into a vertex of the graph by a breadth-first search, and
+    // number the vertices consecutively in the order of the ranks
+    std::vector<unsigned int> vertex_of_cell(n_locally_owned_cells,
+                                             numbers::invalid_unsigned_int);
+    std::vector<unsigned int> vertex_weights;
+    for (unsigned int seed = 0; seed < n_locally_owned_cells; ++seed)
+      if (vertex_of_cell[seed] == numbers::invalid_unsigned_int)
+        {
+          const unsigned int vertex = vertex_weights.size();
+          vertex_of_cell[seed]      = vertex;
+          vertex_weights.push_back(weights[seed]);
+
+          unsigned int             n_cells = 1;
+          std::queue<unsigned int> queue;
+          queue.push(seed);
+          while (!queue.empty() && n_cells < max_cells_per_graph_vertex)
+            {
+              const unsigned int index = queue.front();
+              queue.pop();
+              for (const auto neighbor : neighbors[index])
+                if (partitioner_cells->in_local_range(neighbor))
+                  {
+                    const unsigned int neighbor_index =
+                      partitioner_cells->global_to_local(neighbor);
+                    if (vertex_of_cell[neighbor_index] ==
+                          numbers::invalid_unsigned_int &&
+                        n_cells < max_cells_per_graph_vertex)
+                      {
+                        vertex_of_cell[neighbor_index] = vertex;
+                        vertex_weights.back() += weights[neighbor_index];
+                        ++n_cells;
+                        queue.push(neighbor_index);
+                      }
+                  }
+            }
+        }
+
+    types::global_cell_index n_local_vertices = vertex_weights.size();
+    types::global_cell_index vertex_offset    = 0;
+    int                      ierr =
+      MPI_Exscan(&n_local_vertices,
+                 &vertex_offset,
+                 1,
+                 Utilities::MPI::internal::mpi_type_id(&n_local_vertices),
+                 MPI_SUM,
+                 mpi_communicator);
+    AssertThrowMPI(ierr);
+
+    // the vertices of the neighbors on other processes are taken from the
+    // ghost cells
+    LinearAlgebra::distributed::Vector<double> global_vertex_of_cell(
+      partitioner_cells);
+    for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
+      global_vertex_of_cell.local_element(i) =
+        static_cast<double>(vertex_offset + vertex_of_cell[i]);
+    global_vertex_of_cell.update_ghost_values();
+
+    std::vector<std::pair<types::global_cell_index, types::global_cell_index>>
+      edges;
+    for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
+      for (const auto neighbor : neighbors[i])
+        {
+          const auto vertex          = vertex_offset + vertex_of_cell[i];
+          const auto neighbor_vertex = static_cast<types::global_cell_index>(
+            global_vertex_of_cell[neighbor]);
+          if (vertex != neighbor_vertex)
+            edges.emplace_back(vertex, neighbor_vertex);
+        }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // step 3) collect the graph on the first process and partition it there
+    const auto all_edges = Utilities::MPI::gather(mpi_communicator, edges, 0);
+    const auto all_weights =
+      Utilities::MPI::gather(mpi_communicator, vertex_weights, 0);
+
+    std::map<unsigned int, std::vector<unsigned int>> partitions_to_send;
+
+    if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+      {
+        std::vector<unsigned int>             graph_weights;
+        std::vector<types::global_cell_index> vertex_ranges(1, 0);
+        for (const auto &process_weights : all_weights)
+          {
+            graph_weights.insert(graph_weights.end(),
+                                 process_weights.begin(),
+                                 process_weights.end());
+            vertex_ranges.push_back(graph_weights.size());
+          }
+
+        DynamicSparsityPattern graph(graph_weights.size());
+        for (const auto &process_edges : all_edges)
+          for (const auto &edge : process_edges)
+            {
+              graph.add(edge.first, edge.second);
+              graph.add(edge.second, edge.first);
+            }
+
+        SparsityPattern sparsity_pattern;
+        sparsity_pattern.copy_from(graph);
+
+        // all vertices have the same weight if they consist of single cells
+        // without weights
+        if (!weighting_function && max_cells_per_graph_vertex == 1)
+          graph_weights.clear();
+
+        std::vector<unsigned int> partition_indices(sparsity_pattern.n_rows());
+        SparsityTools::partition(sparsity_pattern,
+                                 graph_weights,
+                                 n_subdomains,
+                                 partition_indices,
+                                 partitioner);
+
+        for (unsigned int p = 0; p < n_subdomains; ++p)
+          partitions_to_send[p].assign(partition_indices.begin() +
+                                         vertex_ranges[p],
+                                       partition_indices.begin() +
+                                         vertex_ranges[p + 1]);
+      }
+
+    // step 4) send the new owners of the vertices back to the processes,
+    // which assign them to the cells of the vertices
+    const auto received_partitions =
+      Utilities::MPI::some_to_some(mpi_communicator, partitions_to_send);
+
+    LinearAlgebra::distributed::Vector<double> partition(partitioner_cells);
+
+    const auto &local_partition = received_partitions.at(0);
+    AssertDimension(local_partition.size(), vertex_weights.size());
+    for (unsigned int i = 0; i < n_locally_owned_cells; ++i)
+      partition.local_element(i) = local_partition[vertex_of_cell[i]];
+
+    return partition;
+#endif
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<unsigned int>
+  compute_n_ghost_cells(
+    const Triangulation<dim, spacedim> &              tria_in,
+    const LinearAlgebra::distributed::Vector<double> &partition)
+  {
+    const auto tria =
+      dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+        &tria_in);
+
+    Assert(tria, ExcNotImplemented());
+
+    const auto mpi_communicator = tria->get_communicator();
+
+    // determine the new owners of the ghost cells
+    if (partition.size() > 0)
+      partition.update_ghost_values();
+
+    const auto new_owner = [&](const auto &cell) -> unsigned int {
+      return (partition.size() == 0) ?
+               cell->subdomain_id() :
+               static_cast<unsigned int>(
+                 partition[cell->global_active_cell_index()]);
+    };
+
+    // each locally owned cell is a ghost cell of all other processes that
+    // own a cell sharing a vertex with it
+    std::vector<unsigned int> n_ghost_cells(
+      Utilities::MPI::n_mpi_processes(mpi_communicator));
+
+    const auto vertex_to_cell = GridTools::vertex_to_cell_map(tria_in);
+
+    std::set<unsigned int> neighbor_owners;
+    for (const auto &cell : tria_in.active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          neighbor_owners.clear();
+          for (const auto v : cell->vertex_indices())
+            for (const auto &neighbor : vertex_to_cell[cell->vertex_index(v)])
+              if (neighbor->is_artificial() == false)
+                neighbor_owners.insert(new_owner(neighbor));
+          neighbor_owners.erase(new_owner(cell));
+
+          for (const auto owner : neighbor_owners)
+            ++n_ghost_cells[owner];
+        }
+
+    Utilities::MPI::sum(n_ghost_cells, mpi_communicator, n_ghost_cells);
+
+    return n_ghost_cells;
+  }
+
+
 } // namespace RepartitioningPolicyTools
 
 
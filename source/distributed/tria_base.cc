@@ -32,6 +32,9 @@
 #include <deal.II/lac/vector_memory.h>
 
 #include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <numeric>
@@ -39,6 +42,138 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+namespace
+{
+  /**
+   * The number of entries per process in the table of a differential
+   * checkpoint, see DataTransfer::save().
+   */
+  constexpr unsigned int delta_table_entry_size = 6;
+
+
+
+  /**
+   * Compute the 64-bit FNV-1a hash of @p size bytes starting at @p data.
+   * This hash is used to detect the chunks of cell-attached data that
+   * changed between two checkpoints.
+   */
+  std::uint64_t
+  compute_chunk_hash(const char *data, const std::size_t size)
+  {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < size; ++i)
+      {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ull;
+      }
+    return hash;
+  }
+
+
+
+  /**
+   * Compute the hashes of all chunks of @p chunk_size bytes of @p data and
+   * combine them into a single hash. This hash identifies the fixed size
+   * data of one process in a base checkpoint.
+   */
+  std::uint64_t
+  compute_checkpoint_hash(const std::vector<char> &data,
+                          const unsigned int       chunk_size)
+  {
+    std::vector<std::uint64_t> hashes((data.size() + chunk_size - 1) /
+                                      chunk_size);
+    for (unsigned int c = 0; c < hashes.size(); ++c)
+      hashes[c] = compute_chunk_hash(
+        data.data() + c * chunk_size,
+        std::min<std::size_t>(chunk_size, data.size() - c * chunk_size));
+    return compute_chunk_hash(reinterpret_cast<const char *>(hashes.data()),
+                              hashes.size() * sizeof(std::uint64_t));
+  }
+
+
+
+  /**
+   * Split the file name @p path into its components. Empty and "."
+   * components are dropped, and a ".." component removes the preceding
+   * component unless that one is a ".." itself.
+   */
+  std::vector<std::string>
+  split_path(const std::string &path)
+  {
+    std::vector<std::string> components;
+    std::size_t              begin = 0;
+    while (begin <= path.size())
+      {
+        const std::size_t end = std::min(path.find('/', begin), path.size());
+        const std::string component = path.substr(begin, end - begin);
+        if (component == ".." && !components.empty() &&
+            components.back() != "..")
+          components.pop_back();
+        else if (!component.empty() && component != ".")
+          components.push_back(component);
+        begin = end + 1;
+      }
+    return components;
+  }
+
+
+
+  /**
+   * Return the file name @p target relative to the directory that contains
+   * the file @p origin, so that the pair of files can be moved to another
+   * directory together. If this is not possible from the two names alone,
+   * i.e., if only one of them is an absolute path or if the directory of
+   * @p origin is only known relative to a parent of the working directory,
+   * return an empty string.
+   */
+  std::string
+  relative_path(const std::string &target, const std::string &origin)
+  {
+    const bool target_is_absolute = (!target.empty() && target[0] == '/');
+    const bool origin_is_absolute = (!origin.empty() && origin[0] == '/');
+    if (target_is_absolute != origin_is_absolute)
+      return "";
+
+    const std::vector<std::string> target_components = split_path(target);
+    std::vector<std::string>       origin_directory  = split_path(origin);
+    if (target_components.empty() || origin_directory.empty())
+      return "";
+    origin_directory.pop_back();
+
+    std::size_t n_common = 0;
+    while (n_common < origin_directory.size() &&
+           n_common + 1 < target_components.size() &&
+           origin_directory[n_common] == target_components[n_common])
+      ++n_common;
+
+    std::string result;
+    for (std::size_t i = n_common; i < origin_directory.size(); ++i)
+      if (origin_directory[i] == "..")
+        return "";
+      else
+        result += "../";
+    for (std::size_t i = n_common; i < target_components.size(); ++i)
+      result += (i > n_common ? "/" : "") + target_components[i];
+    return result;
+  }
+
+
+
+  /**
+   * Return the directory part of the file name @p path including the
+   * trailing slash, or an empty string if @p path has no directory part.
+   */
+  std::string
+  directory_of(const std::string &path)
+  {
+    const std::size_t last_slash = path.rfind('/');
+    return (last_slash == std::string::npos) ? "" :
+                                               path.substr(0, last_slash + 1);
+  }
+} // namespace
+
+
+
 namespace parallel
 {
   template <int dim, int spacedim>
@@ -755,6 +890,20 @@ namespace parallel
       }
   }
 
+  template <int dim, int spacedim>
+  void
+  DistributedTriangulationBase<dim, spacedim>::set_differential_checkpoints(
+    const bool         enable,
+    const unsigned int chunk_size)
+  {
+    Assert(!enable || chunk_size > 0,
+           ExcMessage("The chunk size must be positive."));
+
+    data_transfer.set_checkpoint_chunk_size(enable ? chunk_size : 0);
+  }
+
+
+
   template <int dim, int spacedim>
   unsigned int
   DistributedTriangulationBase<dim, spacedim>::register_data_attach(
@@ -836,6 +985,7 @@ namespace parallel
     const MPI_Comm &mpi_communicator)
     : variable_size_data_stored(false)
     , mpi_communicator(mpi_communicator)
+    , checkpoint_chunk_size(0)
   {}
 
 
@@ -1381,7 +1531,7 @@ namespace parallel
   DistributedTriangulationBase<dim, spacedim>::DataTransfer::save(
     const unsigned int global_first_cell,
     const unsigned int global_num_cells,
-    const std::string &filename) const
+    const std::string &filename)
   {
 #ifdef DEAL_II_WITH_MPI
     // Large fractions of this function have been copied from
@@ -1392,71 +1542,277 @@ namespace parallel
            ExcMessage("No data has been packed!"));
 
     const int myrank = Utilities::MPI::this_mpi_process(mpi_communicator);
+    const int mpisize = Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    //
+    // ---------- Differential checkpoint of fixed size data ----------
+    //
+    // Compare the hashes of all chunks of the local fixed size data with the
+    // ones of the base checkpoint. Only if the layout of the data matches
+    // the one of the base checkpoint on all processes, we can write the
+    // changed chunks alone. Otherwise, the current data becomes the new base
+    // checkpoint.
+    bool write_differential = false;
+    if (checkpoint_chunk_size > 0)
+      {
+        std::vector<unsigned int> layout = {global_first_cell,
+                                            static_cast<unsigned int>(
+                                              src_data_fixed.size())};
+        layout.insert(layout.end(),
+                      sizes_fixed_cumulative.begin(),
+                      sizes_fixed_cumulative.end());
+
+        std::vector<std::uint64_t> hashes(
+          (src_data_fixed.size() + checkpoint_chunk_size - 1) /
+          checkpoint_chunk_size);
+        for (unsigned int c = 0; c < hashes.size(); ++c)
+          hashes[c] = compute_chunk_hash(
+            src_data_fixed.data() + c * checkpoint_chunk_size,
+            std::min<std::size_t>(checkpoint_chunk_size,
+                                  src_data_fixed.size() -
+                                    c * checkpoint_chunk_size));
+
+        // The name of the base checkpoint is stored relative to the
+        // directory of the differential checkpoint, so that a directory of
+        // checkpoints can be moved as a whole. If the relative name cannot
+        // be determined, we write a new base checkpoint instead.
+        const std::string base_filename =
+          base_checkpoint_filename.empty() ?
+            std::string() :
+            relative_path(base_checkpoint_filename, filename);
+
+        const unsigned int layout_matches =
+          (!base_filename.empty() && layout == base_checkpoint_layout) ?
+            1 :
+            0;
+        write_differential =
+          (Utilities::MPI::min(layout_matches, mpi_communicator) == 1);
+
+        if (write_differential)
+          {
+            // Collect the indices of the changed chunks, followed by their
+            // contents, in a single buffer.
+            std::vector<unsigned int> changed_chunks;
+            for (unsigned int c = 0; c < hashes.size(); ++c)
+              if (hashes[c] != base_checkpoint_hashes[c])
+                changed_chunks.push_back(c);
+
+            std::vector<char> buffer(changed_chunks.size() *
+                                     sizeof(unsigned int));
+            if (changed_chunks.size() > 0)
+              std::memcpy(buffer.data(),
+                          changed_chunks.data(),
+                          buffer.size());
+            for (const unsigned int c : changed_chunks)
+              {
+                const auto begin =
+                  src_data_fixed.begin() + c * checkpoint_chunk_size;
+                buffer.insert(buffer.end(),
+                              begin,
+                              begin + std::min<std::size_t>(
+                                        checkpoint_chunk_size,
+                                        src_data_fixed.end() - begin));
+              }
+
+            // The file starts with a header of the number of processes, the
+            // chunk size, sizes_fixed_cumulative and the name of the base
+            // checkpoint relative to the directory of this file, followed by
+            // a table with the position and size of the local fixed size
+            // data, the number of changed chunks, the size of the buffer,
+            // and the two halves of the hash of the local data in the base
+            // checkpoint of each process, and finally the buffers of all
+            // processes. The hash allows load() to detect a base checkpoint
+            // that has been overwritten since.
+            std::vector<unsigned int> header = {
+              static_cast<unsigned int>(mpisize),
+              checkpoint_chunk_size,
+              static_cast<unsigned int>(sizes_fixed_cumulative.size()),
+              static_cast<unsigned int>(base_filename.size())};
+            header.insert(header.end(),
+                          sizes_fixed_cumulative.begin(),
+                          sizes_fixed_cumulative.end());
+            const unsigned int offset_table =
+              header.size() * sizeof(unsigned int) + base_filename.size();
+            const unsigned int offset_buffers =
+              offset_table +
+              mpisize * delta_table_entry_size * sizeof(unsigned int);
+
+            const unsigned int buffer_size = buffer.size();
+            unsigned int       prefix_sum  = 0;
+
+            int ierr = MPI_Exscan(&buffer_size,
+                                  &prefix_sum,
+                                  1,
+                                  MPI_UNSIGNED,
+                                  MPI_SUM,
+                                  mpi_communicator);
+            AssertThrowMPI(ierr);
+
+            const std::uint64_t base_hash = compute_chunk_hash(
+              reinterpret_cast<const char *>(base_checkpoint_hashes.data()),
+              base_checkpoint_hashes.size() * sizeof(std::uint64_t));
+
+            const std::array<unsigned int, delta_table_entry_size>
+              table_entry = {
+                {global_first_cell * sizes_fixed_cumulative.back(),
+                 static_cast<unsigned int>(src_data_fixed.size()),
+                 static_cast<unsigned int>(changed_chunks.size()),
+                 buffer_size,
+                 static_cast<unsigned int>(base_hash & 0xffffffffu),
+                 static_cast<unsigned int>(base_hash >> 32)}};
+
+            const std::string fname_delta =
+              std::string(filename) + "_fixed.delta";
+
+            MPI_Info info;
+            ierr = MPI_Info_create(&info);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Info_set(info,
+                                DEAL_II_MPI_CONST_CAST("romio_cb_write"),
+                                DEAL_II_MPI_CONST_CAST("enable"));
+            AssertThrowMPI(ierr);
+
+            MPI_File fh;
+            ierr = MPI_File_open(mpi_communicator,
+                                 DEAL_II_MPI_CONST_CAST(fname_delta.c_str()),
+                                 MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                                 info,
+                                 &fh);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_set_size(fh, 0); // delete the file contents
+            AssertThrowMPI(ierr);
+            // this barrier is necessary, because otherwise others might
+            // already write while one core is still setting the size to zero.
+            ierr = MPI_Barrier(mpi_communicator);
+            AssertThrowMPI(ierr);
+            ierr = MPI_Info_free(&info);
+            AssertThrowMPI(ierr);
+
+            // The header is written by the first processor only, all others
+            // take part in the collective calls with empty buffers.
+            ierr = MPI_File_write_at_all(fh,
+                                         0,
+                                         DEAL_II_MPI_CONST_CAST(header.data()),
+                                         (myrank == 0) ? header.size() : 0,
+                                         MPI_UNSIGNED,
+                                         MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+            ierr = MPI_File_write_at_all(
+              fh,
+              header.size() * sizeof(unsigned int),
+              DEAL_II_MPI_CONST_CAST(base_filename.data()),
+              (myrank == 0) ? base_filename.size() : 0,
+              MPI_CHAR,
+              MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_write_at_all(
+              fh,
+              offset_table +
+                myrank * delta_table_entry_size * sizeof(unsigned int),
+              DEAL_II_MPI_CONST_CAST(table_entry.data()),
+              table_entry.size(),
+              MPI_UNSIGNED,
+              MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_write_at_all(fh,
+                                         offset_buffers + prefix_sum,
+                                         DEAL_II_MPI_CONST_CAST(buffer.data()),
+                                         buffer.size(),
+                                         MPI_CHAR,
+                                         MPI_STATUS_IGNORE);
+            AssertThrowMPI(ierr);
+
+            ierr = MPI_File_close(&fh);
+            AssertThrowMPI(ierr);
+          }
+        else
+          {
+            base_checkpoint_filename = filename;
+            base_checkpoint_layout   = std::move(layout);
+            base_checkpoint_hashes   = std::move(hashes);
+          }
+      }
 
     //
     // ---------- Fixed size data ----------
     //
-    {
-      const std::string fname_fixed = std::string(filename) + "_fixed.data";
+    if (!write_differential)
+      {
+        const std::string fname_fixed = std::string(filename) + "_fixed.data";
 
-      MPI_Info info;
-      int      ierr = MPI_Info_create(&info);
-      AssertThrowMPI(ierr);
+        // Remove a differential checkpoint that might have been written under
+        // the same name before, as load() would otherwise prefer it.
+        if (myrank == 0)
+          std::remove((std::string(filename) + "_fixed.delta").c_str());
 
-      MPI_File fh;
-      ierr = MPI_File_open(mpi_communicator,
-                           DEAL_II_MPI_CONST_CAST(fname_fixed.c_str()),
-                           MPI_MODE_CREATE | MPI_MODE_WRONLY,
-                           info,
-                           &fh);
-      AssertThrowMPI(ierr);
+        MPI_Info info;
+        int      ierr = MPI_Info_create(&info);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_write"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
 
-      ierr = MPI_File_set_size(fh, 0); // delete the file contents
-      AssertThrowMPI(ierr);
-      // this barrier is necessary, because otherwise others might already
-      // write while one core is still setting the size to zero.
-      ierr = MPI_Barrier(mpi_communicator);
-      AssertThrowMPI(ierr);
-      ierr = MPI_Info_free(&info);
-      AssertThrowMPI(ierr);
-      // ------------------
+        MPI_File fh;
+        ierr = MPI_File_open(mpi_communicator,
+                             DEAL_II_MPI_CONST_CAST(fname_fixed.c_str()),
+                             MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                             info,
+                             &fh);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_File_set_size(fh, 0); // delete the file contents
+        AssertThrowMPI(ierr);
+        // this barrier is necessary, because otherwise others might already
+        // write while one core is still setting the size to zero.
+        ierr = MPI_Barrier(mpi_communicator);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Info_free(&info);
+        AssertThrowMPI(ierr);
+        // ------------------
 
-      // Write cumulative sizes to file.
-      // Since each processor owns the same information about the data sizes,
-      // it is sufficient to let only the first processor perform this task.
-      if (myrank == 0)
+        // Write cumulative sizes to file.
+        // Since each processor owns the same information about the data sizes,
+        // it is sufficient to let only the first processor perform this task.
+        // All other processors take part in the collective call with an empty
+        // buffer.
         {
           const unsigned int *data = sizes_fixed_cumulative.data();
 
-          ierr = MPI_File_write_at(fh,
-                                   0,
-                                   DEAL_II_MPI_CONST_CAST(data),
-                                   sizes_fixed_cumulative.size(),
-                                   MPI_UNSIGNED,
-                                   MPI_STATUS_IGNORE);
+          ierr = MPI_File_write_at_all(fh,
+                                       0,
+                                       DEAL_II_MPI_CONST_CAST(data),
+                                       (myrank == 0) ?
+                                         sizes_fixed_cumulative.size() :
+                                         0,
+                                       MPI_UNSIGNED,
+                                       MPI_STATUS_IGNORE);
           AssertThrowMPI(ierr);
         }
 
-      // Write packed data to file simultaneously.
-      const unsigned int offset_fixed =
-        sizes_fixed_cumulative.size() * sizeof(unsigned int);
-
-      const char *data = src_data_fixed.data();
-
-      ierr = MPI_File_write_at(
-        fh,
-        offset_fixed +
-          global_first_cell *
-            sizes_fixed_cumulative.back(), // global position in file
-        DEAL_II_MPI_CONST_CAST(data),
-        src_data_fixed.size(), // local buffer
-        MPI_CHAR,
-        MPI_STATUS_IGNORE);
-      AssertThrowMPI(ierr);
+        // Write packed data to file simultaneously.
+        const unsigned int offset_fixed =
+          sizes_fixed_cumulative.size() * sizeof(unsigned int);
+
+        const char *data = src_data_fixed.data();
+
+        ierr = MPI_File_write_at_all(
+          fh,
+          offset_fixed +
+            global_first_cell *
+              sizes_fixed_cumulative.back(), // global position in file
+          DEAL_II_MPI_CONST_CAST(data),
+          src_data_fixed.size(), // local buffer
+          MPI_CHAR,
+          MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
 
-      ierr = MPI_File_close(&fh);
-      AssertThrowMPI(ierr);
-    }
+        ierr = MPI_File_close(&fh);
+        AssertThrowMPI(ierr);
+      }
 
     //
     // ---------- Variable size data ----------
@@ -1469,6 +1825,10 @@ namespace parallel
         MPI_Info info;
         int      ierr = MPI_Info_create(&info);
         AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_write"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
 
         MPI_File fh;
         ierr = MPI_File_open(mpi_communicator,
@@ -1490,14 +1850,13 @@ namespace parallel
         // Write sizes of each cell into file simultaneously.
         {
           const int *data = src_sizes_variable.data();
-          ierr =
-            MPI_File_write_at(fh,
-                              global_first_cell *
-                                sizeof(unsigned int), // global position in file
-                              DEAL_II_MPI_CONST_CAST(data),
-                              src_sizes_variable.size(), // local buffer
-                              MPI_INT,
-                              MPI_STATUS_IGNORE);
+          ierr = MPI_File_write_at_all(
+            fh,
+            global_first_cell * sizeof(unsigned int), // global position in file
+            DEAL_II_MPI_CONST_CAST(data),
+            src_sizes_variable.size(), // local buffer
+            MPI_INT,
+            MPI_STATUS_IGNORE);
           AssertThrowMPI(ierr);
         }
 
@@ -1521,13 +1880,13 @@ namespace parallel
         const char *data = src_data_variable.data();
 
         // Write data consecutively into file.
-        ierr = MPI_File_write_at(fh,
-                                 offset_variable +
-                                   prefix_sum, // global position in file
-                                 DEAL_II_MPI_CONST_CAST(data),
-                                 src_data_variable.size(), // local buffer
-                                 MPI_CHAR,
-                                 MPI_STATUS_IGNORE);
+        ierr = MPI_File_write_at_all(fh,
+                                     offset_variable +
+                                       prefix_sum, // global position in file
+                                     DEAL_II_MPI_CONST_CAST(data),
+                                     src_data_variable.size(), // local buffer
+                                     MPI_CHAR,
+                                     MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         ierr = MPI_File_close(&fh);
@@ -1564,15 +1923,89 @@ namespace parallel
 
     variable_size_data_stored = (n_attached_deserialize_variable > 0);
 
+    const int myrank = Utilities::MPI::this_mpi_process(mpi_communicator);
+    const int mpisize = Utilities::MPI::n_mpi_processes(mpi_communicator);
+
+    //
+    // ---------- Differential checkpoint of fixed size data ----------
+    //
+    // If a differential checkpoint has been written under this name, the
+    // fixed size data is read from its base checkpoint first and the
+    // changed chunks are applied afterwards. See save() for the layout of
+    // the file.
+    const std::string fname_delta = std::string(filename) + "_fixed.delta";
+    bool              is_differential = false;
+    if (myrank == 0)
+      is_differential = static_cast<bool>(std::ifstream(fname_delta));
+    is_differential =
+      Utilities::MPI::broadcast(mpi_communicator, is_differential);
+
+    std::string fname_fixed = std::string(filename) + "_fixed.data";
+
+    std::vector<unsigned int> delta_header(4);
+    std::vector<unsigned int> delta_sizes_fixed_cumulative;
+    if (is_differential)
+      {
+        MPI_File fh;
+        int      ierr = MPI_File_open(mpi_communicator,
+                                 DEAL_II_MPI_CONST_CAST(fname_delta.c_str()),
+                                 MPI_MODE_RDONLY,
+                                 MPI_INFO_NULL,
+                                 &fh);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_File_read_at_all(fh,
+                                    0,
+                                    delta_header.data(),
+                                    delta_header.size(),
+                                    MPI_UNSIGNED,
+                                    MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+        AssertThrow(delta_header[0] == static_cast<unsigned int>(mpisize),
+                    ExcMessage("Differential checkpoints can only be loaded "
+                               "on the same number of processes they were "
+                               "written with."));
+
+        delta_sizes_fixed_cumulative.resize(delta_header[2]);
+        ierr = MPI_File_read_at_all(fh,
+                                    delta_header.size() * sizeof(unsigned int),
+                                    delta_sizes_fixed_cumulative.data(),
+                                    delta_sizes_fixed_cumulative.size(),
+                                    MPI_UNSIGNED,
+                                    MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        std::vector<char> base_filename(delta_header[3]);
+        ierr = MPI_File_read_at_all(fh,
+                                    (delta_header.size() + delta_header[2]) *
+                                      sizeof(unsigned int),
+                                    base_filename.data(),
+                                    base_filename.size(),
+                                    MPI_CHAR,
+                                    MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_File_close(&fh);
+        AssertThrowMPI(ierr);
+
+        // the name of the base checkpoint is relative to the directory of
+        // the differential checkpoint
+        fname_fixed = directory_of(fname_delta) +
+                      std::string(base_filename.begin(), base_filename.end()) +
+                      "_fixed.data";
+      }
+
     //
     // ---------- Fixed size data ----------
     //
     {
-      const std::string fname_fixed = std::string(filename) + "_fixed.data";
-
       MPI_Info info;
       int      ierr = MPI_Info_create(&info);
       AssertThrowMPI(ierr);
+      ierr = MPI_Info_set(info,
+                          DEAL_II_MPI_CONST_CAST("romio_cb_read"),
+                          DEAL_II_MPI_CONST_CAST("enable"));
+      AssertThrowMPI(ierr);
 
       MPI_File fh;
       ierr = MPI_File_open(mpi_communicator,
@@ -1591,12 +2024,12 @@ namespace parallel
       // the file.
       sizes_fixed_cumulative.resize(1 + n_attached_deserialize_fixed +
                                     (variable_size_data_stored ? 1 : 0));
-      ierr = MPI_File_read_at(fh,
-                              0,
-                              sizes_fixed_cumulative.data(),
-                              sizes_fixed_cumulative.size(),
-                              MPI_UNSIGNED,
-                              MPI_STATUS_IGNORE);
+      ierr = MPI_File_read_at_all(fh,
+                                  0,
+                                  sizes_fixed_cumulative.data(),
+                                  sizes_fixed_cumulative.size(),
+                                  MPI_UNSIGNED,
+                                  MPI_STATUS_IGNORE);
       AssertThrowMPI(ierr);
 
       // Allocate sufficient memory.
@@ -1606,7 +2039,7 @@ namespace parallel
       const unsigned int offset =
         sizes_fixed_cumulative.size() * sizeof(unsigned int);
 
-      ierr = MPI_File_read_at(
+      ierr = MPI_File_read_at_all(
         fh,
         offset + global_first_cell *
                    sizes_fixed_cumulative.back(), // global position in file
@@ -1620,6 +2053,113 @@ namespace parallel
       AssertThrowMPI(ierr);
     }
 
+    // Apply the chunks of the differential checkpoint that changed since its
+    // base checkpoint.
+    if (is_differential)
+      {
+        AssertThrow(delta_sizes_fixed_cumulative == sizes_fixed_cumulative,
+                    ExcMessage("The differential checkpoint does not match "
+                               "its base checkpoint."));
+
+        MPI_Info info;
+        int      ierr = MPI_Info_create(&info);
+        AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_read"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
+
+        MPI_File fh;
+        ierr = MPI_File_open(mpi_communicator,
+                             DEAL_II_MPI_CONST_CAST(fname_delta.c_str()),
+                             MPI_MODE_RDONLY,
+                             info,
+                             &fh);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_Info_free(&info);
+        AssertThrowMPI(ierr);
+
+        const unsigned int offset_table =
+          (delta_header.size() + delta_header[2]) * sizeof(unsigned int) +
+          delta_header[3];
+        const unsigned int offset_buffers =
+          offset_table +
+          mpisize * delta_table_entry_size * sizeof(unsigned int);
+
+        std::array<unsigned int, delta_table_entry_size> table_entry;
+        ierr = MPI_File_read_at_all(fh,
+                                    offset_table + myrank *
+                                                     delta_table_entry_size *
+                                                     sizeof(unsigned int),
+                                    table_entry.data(),
+                                    table_entry.size(),
+                                    MPI_UNSIGNED,
+                                    MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+        AssertThrow(table_entry[0] ==
+                        global_first_cell * sizes_fixed_cumulative.back() &&
+                      table_entry[1] == dest_data_fixed.size(),
+                    ExcMessage("Differential checkpoints can only be loaded "
+                               "with the same partition of the cells they "
+                               "were written with."));
+
+        unsigned int prefix_sum = 0;
+
+        ierr = MPI_Exscan(&table_entry[3],
+                          &prefix_sum,
+                          1,
+                          MPI_UNSIGNED,
+                          MPI_SUM,
+                          mpi_communicator);
+        AssertThrowMPI(ierr);
+
+        std::vector<char> buffer(table_entry[3]);
+        ierr = MPI_File_read_at_all(fh,
+                                    offset_buffers + prefix_sum,
+                                    buffer.data(),
+                                    buffer.size(),
+                                    MPI_CHAR,
+                                    MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr);
+
+        ierr = MPI_File_close(&fh);
+        AssertThrowMPI(ierr);
+
+        // Make sure that the base checkpoint is still the one the
+        // differential checkpoint was written against, on all processes.
+        const std::uint64_t base_hash =
+          compute_checkpoint_hash(dest_data_fixed, delta_header[1]);
+        const unsigned int base_matches =
+          (static_cast<unsigned int>(base_hash & 0xffffffffu) ==
+             table_entry[4] &&
+           static_cast<unsigned int>(base_hash >> 32) == table_entry[5]) ?
+            1 :
+            0;
+        AssertThrow(Utilities::MPI::min(base_matches, mpi_communicator) == 1,
+                    ExcMessage("The base checkpoint <" + fname_fixed +
+                               "> has been changed after the differential "
+                               "checkpoint <" + fname_delta +
+                               "> was written."));
+
+        const unsigned int chunk_size = delta_header[1];
+        const char *       chunk_data =
+          buffer.data() + table_entry[2] * sizeof(unsigned int);
+        for (unsigned int i = 0; i < table_entry[2]; ++i)
+          {
+            unsigned int c;
+            std::memcpy(&c,
+                        buffer.data() + i * sizeof(unsigned int),
+                        sizeof(unsigned int));
+
+            const std::size_t size =
+              std::min<std::size_t>(chunk_size,
+                                    dest_data_fixed.size() - c * chunk_size);
+            std::memcpy(&dest_data_fixed[c * chunk_size], chunk_data, size);
+            chunk_data += size;
+          }
+      }
+
     //
     // ---------- Variable size data ----------
     //
@@ -1631,6 +2171,10 @@ namespace parallel
         MPI_Info info;
         int      ierr = MPI_Info_create(&info);
         AssertThrowMPI(ierr);
+        ierr = MPI_Info_set(info,
+                            DEAL_II_MPI_CONST_CAST("romio_cb_read"),
+                            DEAL_II_MPI_CONST_CAST("enable"));
+        AssertThrowMPI(ierr);
 
         MPI_File fh;
         ierr = MPI_File_open(mpi_communicator,
@@ -1645,12 +2189,12 @@ namespace parallel
 
         // Read sizes of all locally owned cells.
         dest_sizes_variable.resize(local_num_cells);
-        ierr = MPI_File_read_at(fh,
-                                global_first_cell * sizeof(unsigned int),
-                                dest_sizes_variable.data(),
-                                dest_sizes_variable.size(),
-                                MPI_INT,
-                                MPI_STATUS_IGNORE);
+        ierr = MPI_File_read_at_all(fh,
+                                    global_first_cell * sizeof(unsigned int),
+                                    dest_sizes_variable.data(),
+                                    dest_sizes_variable.size(),
+                                    MPI_INT,
+                                    MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         const unsigned int offset = global_num_cells * sizeof(unsigned int);
@@ -1671,12 +2215,12 @@ namespace parallel
         AssertThrowMPI(ierr);
 
         dest_data_variable.resize(size_on_proc);
-        ierr = MPI_File_read_at(fh,
-                                offset + prefix_sum,
-                                dest_data_variable.data(),
-                                dest_data_variable.size(),
-                                MPI_CHAR,
-                                MPI_STATUS_IGNORE);
+        ierr = MPI_File_read_at_all(fh,
+                                    offset + prefix_sum,
+                                    dest_data_variable.data(),
+                                    dest_data_variable.size(),
+                                    MPI_CHAR,
+                                    MPI_STATUS_IGNORE);
         AssertThrowMPI(ierr);
 
         ierr = MPI_File_close(&fh);
@@ -1696,6 +2240,20 @@ namespace parallel
 
 
 
+  template <int dim, int spacedim>
+  void
+  DistributedTriangulationBase<dim, spacedim>::DataTransfer::
+    set_checkpoint_chunk_size(const unsigned int chunk_size)
+  {
+    checkpoint_chunk_size = chunk_size;
+
+    base_checkpoint_filename.clear();
+    base_checkpoint_layout.clear();
+    base_checkpoint_hashes.clear();
+  }
+
+
+
   template <int dim, int spacedim>
   void
   DistributedTriangulationBase<dim, spacedim>::DataTransfer::clear()
@@ -60,6 +60,15 @@ Manifold<dim, spacedim>::get_intermediate_point(const Point<spacedim> &p1,
 
 
 
+template <int dim, int spacedim>
+bool
+Manifold<dim, spacedim>::supports_concurrent_calls() const
+{
+  return true;
+}
+
+
+
 template <int dim, int spacedim>
 Point<spacedim>
 Manifold<dim, spacedim>::get_new_point(
@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/fe/mapping_q1.h>
 
@@ -35,7 +36,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstdint>
 #include <functional>
+#include <iomanip>
 #include <list>
 #include <map>
 #include <memory>
@@ -115,6 +118,15 @@ namespace internal
 // anonymous namespace for internal helper functions
 namespace
 {
+  // the minimal number of refined objects that are handed to one thread when
+  // new vertices are placed or children are checked for distortion in
+  // parallel. computing a point on a manifold costs at least a few hundred
+  // floating point operations, so this is enough to amortize the overhead of
+  // a task
+  constexpr unsigned int refinement_parallel_grain_size = 128;
+
+
+
   // return whether the given cell is
   // patch_level_1, i.e. determine
   // whether either all or none of
@@ -654,6 +666,14 @@ namespace
    * children of the given cell is
    * distorted or not. This is the
    * function for dim==spacedim.
+   *
+   * The check relies on
+   * GeometryInfo::alternating_form_at_vertices(),
+   * which is only defined for
+   * hypercube cells. Children of
+   * simplex, wedge, and pyramid
+   * cells are therefore never
+   * reported as distorted.
    */
   template <int dim>
   bool
@@ -662,6 +682,9 @@ namespace
   {
     Assert(cell->has_children(), ExcInternalError());
 
+    if (cell->reference_cell() != ReferenceCells::get_hypercube<dim>())
+      return false;
+
     for (unsigned int c = 0; c < cell->n_children(); ++c)
       {
         Point<dim> vertices[GeometryInfo<dim>::vertices_per_cell];
@@ -1214,19 +1237,13 @@ namespace internal
       //
       // note that all arrays should have equal sizes (checked by
       // @p{monitor_memory}
-      if (total_cells > tria_level.refine_flags.size())
+      if (total_cells > tria_level.cell_flags.size())
         {
-          tria_level.refine_flags.reserve(total_cells);
-          tria_level.refine_flags.insert(tria_level.refine_flags.end(),
-                                         total_cells -
-                                           tria_level.refine_flags.size(),
-                                         /*RefinementCase::no_refinement=*/0);
-
-          tria_level.coarsen_flags.reserve(total_cells);
-          tria_level.coarsen_flags.insert(tria_level.coarsen_flags.end(),
-                                          total_cells -
-                                            tria_level.coarsen_flags.size(),
-                                          false);
+          tria_level.cell_flags.reserve(total_cells);
+          tria_level.cell_flags.insert(tria_level.cell_flags.end(),
+                                       total_cells -
+                                         tria_level.cell_flags.size(),
+                                       TriaLevel::default_cell_flags);
 
           tria_level.active_cell_indices.reserve(total_cells);
           tria_level.active_cell_indices.insert(
@@ -1258,16 +1275,7 @@ namespace internal
             total_cells - tria_level.global_level_cell_indices.size(),
             numbers::invalid_dof_index);
 
-          if (dimension < space_dimension)
-            {
-              tria_level.direction_flags.reserve(total_cells);
-              tria_level.direction_flags.insert(
-                tria_level.direction_flags.end(),
-                total_cells - tria_level.direction_flags.size(),
-                true);
-            }
-          else
-            tria_level.direction_flags.clear();
+          tria_level.direction_flags_used = (dimension < space_dimension);
 
           tria_level.parents.reserve((total_cells + 1) / 2);
           tria_level.parents.insert(tria_level.parents.end(),
@@ -1275,11 +1283,17 @@ namespace internal
                                       tria_level.parents.size(),
                                     -1);
 
-          tria_level.neighbors.reserve(total_cells * (2 * dimension));
-          tria_level.neighbors.insert(tria_level.neighbors.end(),
-                                      total_cells * (2 * dimension) -
-                                        tria_level.neighbors.size(),
-                                      std::make_pair(-1, -1));
+          tria_level.neighbor_indices.reserve(total_cells * (2 * dimension));
+          tria_level.neighbor_indices.insert(
+            tria_level.neighbor_indices.end(),
+            total_cells * (2 * dimension) - tria_level.neighbor_indices.size(),
+            -1);
+
+          tria_level.neighbor_levels.reserve(total_cells * (2 * dimension));
+          tria_level.neighbor_levels.insert(
+            tria_level.neighbor_levels.end(),
+            total_cells * (2 * dimension) - tria_level.neighbor_levels.size(),
+            0);
 
           if (tria_level.dim == 2 || tria_level.dim == 3)
             {
@@ -1324,14 +1338,14 @@ namespace internal
     {
       (void)tria_level;
       (void)true_dimension;
-      Assert(2 * true_dimension * tria_level.refine_flags.size() ==
-               tria_level.neighbors.size(),
-             ExcMemoryInexact(tria_level.refine_flags.size(),
-                              tria_level.neighbors.size()));
-      Assert(2 * true_dimension * tria_level.coarsen_flags.size() ==
-               tria_level.neighbors.size(),
-             ExcMemoryInexact(tria_level.coarsen_flags.size(),
-                              tria_level.neighbors.size()));
+      Assert(2 * true_dimension * tria_level.cell_flags.size() ==
+               tria_level.neighbor_indices.size(),
+             ExcMemoryInexact(tria_level.cell_flags.size(),
+                              tria_level.neighbor_indices.size()));
+      Assert(tria_level.neighbor_levels.size() ==
+               tria_level.neighbor_indices.size(),
+             ExcMemoryInexact(tria_level.neighbor_levels.size(),
+                              tria_level.neighbor_indices.size()));
     }
 
 
@@ -2438,8 +2452,10 @@ namespace internal
                 {
                   // set neighbor if not at boundary
                   if (nei.col[i] != static_cast<unsigned int>(-1))
-                    level.neighbors[cell * GeometryInfo<dim>::faces_per_cell +
-                                    j] = {0, nei.col[i]};
+                    level.set_neighbor(cell * GeometryInfo<dim>::faces_per_cell +
+                                         j,
+                                       0,
+                                       nei.col[i]);
 
                   // set face indices
                   cells_0.cells[cell * GeometryInfo<dim>::faces_per_cell + j] =
@@ -2654,15 +2670,13 @@ namespace internal
         level.subdomain_ids.assign(size, 0);
         level.level_subdomain_ids.assign(size, 0);
 
-        level.refine_flags.assign(size, false);
-        level.coarsen_flags.assign(size, false);
+        level.cell_flags.assign(size, TriaLevel::default_cell_flags);
+        level.direction_flags_used = (dim < spacedim);
 
         level.parents.assign((size + 1) / 2, -1);
 
-        if (dim < spacedim)
-          level.direction_flags.assign(size, true);
-
-        level.neighbors.assign(size * max_faces_per_cell, {-1, -1});
+        level.neighbor_indices.assign(size * max_faces_per_cell, -1);
+        level.neighbor_levels.assign(size * max_faces_per_cell, 0);
 
         level.reference_cell.assign(size, dealii::ReferenceCells::Invalid);
 
@@ -3968,6 +3982,104 @@ namespace internal
 
 
 
+      /**
+       * Place the vertices created during refinement at the centers of the
+       * objects they were created for, i.e., at the midpoints of lines or at
+       * the centers of quads and hexes, taking into account the manifold
+       * of each object. The first element of each pair is the refined
+       * object, the second one the index of its new vertex.
+       *
+       * Computing a point on a curved manifold can be much more expensive
+       * than setting up the topology of the children, but it only reads
+       * the vertices of the object and of its children's faces. The points
+       * are therefore computed in parallel. The objects passed to one call
+       * must not depend on each other's new vertices, which is why the
+       * refinement functions call this function once for the lines, once
+       * for the quads, and once for the hexes. As a consequence, the
+       * manifolds attached to the objects must allow concurrent calls, see
+       * the documentation of the Manifold class. If one of the manifolds
+       * attached to the triangulation does not, as indicated by
+       * Manifold::supports_concurrent_calls(), all points are computed on
+       * the current thread.
+       */
+      template <int dim, int spacedim, typename IteratorType>
+      static void
+      set_new_vertex_locations(
+        const std::vector<std::pair<IteratorType, unsigned int>> &new_vertices,
+        const bool                    interpolate_from_surrounding,
+        Triangulation<dim, spacedim> &triangulation)
+      {
+        const auto compute_points = [&](const std::size_t begin,
+                                        const std::size_t end) {
+          for (std::size_t i = begin; i < end; ++i)
+            triangulation.vertices[new_vertices[i].second] =
+              new_vertices[i].first->center(true, interpolate_from_surrounding);
+        };
+
+        // objects without an attached manifold use a FlatManifold, which
+        // can always be called concurrently, so it suffices to ask the
+        // manifolds attached to the triangulation
+        bool concurrent_calls_allowed = true;
+        for (const auto &manifold : triangulation.manifold)
+          if (manifold.second->supports_concurrent_calls() == false)
+            {
+              concurrent_calls_allowed = false;
+              break;
+            }
+
+        if (concurrent_calls_allowed)
+          dealii::parallel::apply_to_subranges(std::size_t(0),
+                                               new_vertices.size(),
+                                               compute_points,
+                                               refinement_parallel_grain_size);
+        else
+          compute_points(0, new_vertices.size());
+      }
+
+
+
+      /**
+       * Collect the cells in @p refined_cells that have distorted children
+       * into @p distorted_cells and then trigger the post_refinement_on_cell
+       * signal for each of them, in the order of @p refined_cells. This is
+       * done after all new vertices have been placed by
+       * set_new_vertex_locations(). The check for distortion only reads the
+       * geometry of the children and is done in parallel.
+       */
+      template <int dim, int spacedim>
+      static void
+      finalize_refined_cells(
+        Triangulation<dim, spacedim> &triangulation,
+        const std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          &        refined_cells,
+        const bool check_for_distorted_cells,
+        typename Triangulation<dim, spacedim>::DistortedCellList
+          &distorted_cells)
+      {
+        if (check_for_distorted_cells)
+          {
+            std::vector<std::uint8_t> is_distorted(refined_cells.size(), 0);
+            dealii::parallel::apply_to_subranges(
+              std::size_t(0),
+              refined_cells.size(),
+              [&](const std::size_t begin, const std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                  if (has_distorted_children<dim, spacedim>(refined_cells[i]))
+                    is_distorted[i] = 1;
+              },
+              refinement_parallel_grain_size);
+
+            for (std::size_t i = 0; i < refined_cells.size(); ++i)
+              if (is_distorted[i] != 0)
+                distorted_cells.distorted_cells.push_back(refined_cells[i]);
+          }
+
+        for (const auto &cell : refined_cells)
+          triangulation.signals.post_refinement_on_cell(cell);
+      }
+
+
+
       template <int dim, int spacedim>
       static typename Triangulation<dim, spacedim>::DistortedCellList
       execute_refinement_isotropic(Triangulation<dim, spacedim> &triangulation,
@@ -4078,6 +4190,17 @@ namespace internal
 
         unsigned int next_unused_vertex = 0;
 
+        // the locations of the new vertices are computed after the topology
+        // has been set up, see set_new_vertex_locations()
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::line_iterator,
+                    unsigned int>>
+          new_line_vertices;
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                    unsigned int>>
+          new_cell_vertices;
+
         {
           typename Triangulation<dim, spacedim>::active_line_iterator
             line = triangulation.begin_active_line(),
@@ -4100,7 +4223,7 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                new_line_vertices.emplace_back(line, next_unused_vertex);
 
                 bool pair_found = false;
                 (void)pair_found;
@@ -4147,6 +4270,10 @@ namespace internal
               }
         }
 
+        set_new_vertex_locations(new_line_vertices,
+                                 false,
+                                 triangulation);
+
         reserve_space(triangulation.faces->lines, 0, n_single_lines);
 
         typename Triangulation<dim, spacedim>::DistortedCellList
@@ -4155,11 +4282,12 @@ namespace internal
         typename Triangulation<dim, spacedim>::raw_line_iterator
           next_unused_line = triangulation.begin_raw_line();
 
-        const auto create_children = [](auto &        triangulation,
-                                        unsigned int &next_unused_vertex,
-                                        auto &        next_unused_line,
-                                        auto &        next_unused_cell,
-                                        const auto &  cell) {
+        const auto create_children = [&new_cell_vertices](
+                                       auto &        triangulation,
+                                       unsigned int &next_unused_vertex,
+                                       auto &        next_unused_line,
+                                       auto &        next_unused_cell,
+                                       const auto &  cell) {
           const auto ref_case = cell->refine_flag_set();
           cell->clear_refine_flag();
 
@@ -4194,8 +4322,7 @@ namespace internal
 
               new_vertices[8] = next_unused_vertex;
 
-              triangulation.vertices[next_unused_vertex] =
-                cell->center(true, true);
+              new_cell_vertices.emplace_back(cell, next_unused_vertex);
             }
 
           std::array<typename Triangulation<dim, spacedim>::raw_line_iterator,
@@ -4440,6 +4567,9 @@ namespace internal
               cell->child(c)->set_direction_flag(cell->direction_flag());
         };
 
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+
         for (int level = 0;
              level < static_cast<int>(triangulation.levels.size()) - 1;
              ++level)
@@ -4457,17 +4587,19 @@ namespace internal
                                   next_unused_cell,
                                   cell);
 
-                  if (cell->reference_cell() ==
-                        dealii::ReferenceCells::Quadrilateral &&
-                      check_for_distorted_cells &&
-                      has_distorted_children<dim, spacedim>(cell))
-                    cells_with_distorted_children.distorted_cells.push_back(
-                      cell);
-
-                  triangulation.signals.post_refinement_on_cell(cell);
+                  refined_cells.push_back(cell);
                 }
           }
 
+        set_new_vertex_locations(new_cell_vertices,
+                                 true,
+                                 triangulation);
+
+        finalize_refined_cells(triangulation,
+                               refined_cells,
+                               check_for_distorted_cells,
+                               cells_with_distorted_children);
+
         return cells_with_distorted_children;
       }
 
@@ -5212,6 +5344,22 @@ namespace internal
 
         unsigned int current_vertex = 0;
 
+        // the locations of the new vertices are computed after the topology
+        // of each kind of object has been set up, see
+        // set_new_vertex_locations()
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::line_iterator,
+                    unsigned int>>
+          new_line_vertices;
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::quad_iterator,
+                    unsigned int>>
+          new_quad_vertices;
+        std::vector<
+          std::pair<typename Triangulation<dim, spacedim>::cell_iterator,
+                    unsigned int>>
+          new_hex_vertices;
+
         // helper function - find the next available vertex number and mark it
         // as used.
         auto get_next_unused_vertex = [](const unsigned int current_vertex,
@@ -5242,7 +5390,7 @@ namespace internal
               current_vertex =
                 get_next_unused_vertex(current_vertex,
                                        triangulation.vertices_used);
-              triangulation.vertices[current_vertex] = line->center(true);
+              new_line_vertices.emplace_back(line, current_vertex);
 
               next_unused_line =
                 triangulation.faces->lines.template next_free_pair_object<1>(
@@ -5285,6 +5433,10 @@ namespace internal
             }
         }
 
+        set_new_vertex_locations(new_line_vertices,
+                                 false,
+                                 triangulation);
+
         // QUADS
         {
           typename Triangulation<dim, spacedim>::quad_iterator
@@ -5308,8 +5460,7 @@ namespace internal
                   current_vertex =
                     get_next_unused_vertex(current_vertex,
                                            triangulation.vertices_used);
-                  triangulation.vertices[current_vertex] =
-                    quad->center(true, true);
+                  new_quad_vertices.emplace_back(quad, current_vertex);
                 }
 
               // 2) create new lines (property is set later)
@@ -5583,9 +5734,16 @@ namespace internal
             }
         }
 
+        set_new_vertex_locations(new_quad_vertices,
+                                 true,
+                                 triangulation);
+
         typename Triangulation<3, spacedim>::DistortedCellList
           cells_with_distorted_children;
 
+        std::vector<typename Triangulation<dim, spacedim>::cell_iterator>
+          refined_cells;
+
         for (unsigned int level = 0; level != triangulation.levels.size() - 1;
              ++level)
           {
@@ -5632,8 +5790,7 @@ namespace internal
                     current_vertex =
                       get_next_unused_vertex(current_vertex,
                                              triangulation.vertices_used);
-                    triangulation.vertices[current_vertex] =
-                      hex->center(true, true);
+                    new_hex_vertices.emplace_back(hex, current_vertex);
                   }
 
                 boost::container::small_vector<
@@ -6237,14 +6394,19 @@ namespace internal
                   }
                 }
 
-                if (check_for_distorted_cells &&
-                    has_distorted_children<dim, spacedim>(hex))
-                  cells_with_distorted_children.distorted_cells.push_back(hex);
-
-                triangulation.signals.post_refinement_on_cell(hex);
+                refined_cells.push_back(hex);
               }
           }
 
+        set_new_vertex_locations(new_hex_vertices,
+                                 true,
+                                 triangulation);
+
+        finalize_refined_cells(triangulation,
+                               refined_cells,
+                               check_for_distorted_cells,
+                               cells_with_distorted_children);
+
         triangulation.faces->quads.clear_user_data();
 
         return cells_with_distorted_children;
@@ -14519,7 +14681,7 @@ Triangulation<dim, spacedim>::reset_cell_vertex_indices_cache()
       constexpr unsigned int     max_vertices_per_cell = 1 << dim;
       std::vector<unsigned int> &cache = levels[l]->cell_vertex_indices_cache;
       cache.clear();
-      cache.resize(levels[l]->refine_flags.size() * max_vertices_per_cell,
+      cache.resize(levels[l]->cell_flags.size() * max_vertices_per_cell,
                    numbers::invalid_unsigned_int);
       for (const auto &cell : cell_iterators_on_level(l))
         {
@@ -16319,6 +16481,47 @@ Triangulation<dim, spacedim>::memory_consumption() const
 
 
 
+template <int dim, int spacedim>
+void
+Triangulation<dim, spacedim>::print_memory_consumption(std::ostream &out) const
+{
+  // sum up the fields of the cells over all levels, keeping the order of the
+  // fields
+  std::vector<std::pair<std::string, std::size_t>> fields;
+  for (const auto &level : levels)
+    {
+      const auto level_fields = level->memory_consumption_per_field();
+      if (fields.empty())
+        fields = level_fields;
+      else
+        for (unsigned int i = 0; i < fields.size(); ++i)
+          fields[i].second += level_fields[i].second;
+    }
+
+  fields.emplace_back("vertices",
+                      MemoryConsumption::memory_consumption(vertices));
+  fields.emplace_back("vertices_used",
+                      MemoryConsumption::memory_consumption(vertices_used));
+  fields.emplace_back("faces",
+                      faces ? MemoryConsumption::memory_consumption(*faces) :
+                              0);
+
+  const std::size_t total = memory_consumption();
+  std::size_t       sum   = 0;
+  for (const auto &field : fields)
+    sum += field.second;
+  fields.emplace_back("other", total - sum);
+
+  out << "Memory consumption of the triangulation in bytes:" << std::endl;
+  for (const auto &field : fields)
+    out << "  " << std::left << std::setw(28) << field.first << std::right
+        << std::setw(14) << field.second << std::endl;
+  out << "  " << std::left << std::setw(28) << "total" << std::right
+      << std::setw(14) << total << std::endl;
+}
+
+
+
 template <int dim, int spacedim>
 Triangulation<dim, spacedim>::DistortedCellList::~DistortedCellList() noexcept =
   default;
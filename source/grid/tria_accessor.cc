@@ -2073,8 +2073,8 @@ CellAccessor<dim, spacedim>::direction_flag() const
   if (dim == spacedim)
     return true;
   else
-    return this->tria->levels[this->present_level]
-      ->direction_flags[this->present_index];
+    return this->tria->levels[this->present_level]->direction_flag(
+      this->present_index);
 }
 
 
@@ -2086,8 +2086,8 @@ CellAccessor<dim, spacedim>::set_direction_flag(
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
   if (dim < spacedim)
-    this->tria->levels[this->present_level]
-      ->direction_flags[this->present_index] = new_direction_flag;
+    this->tria->levels[this->present_level]->set_direction_flag(
+      this->present_index, new_direction_flag);
   else
     Assert(new_direction_flag == true,
            ExcMessage("If dim==spacedim, direction flags are always true and "
@@ -2229,23 +2229,13 @@ CellAccessor<dim, spacedim>::set_neighbor(
   AssertIndexRange(i, this->n_faces());
 
   if (pointer.state() == IteratorState::valid)
-    {
-      this->tria->levels[this->present_level]
-        ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell + i]
-        .first = pointer->present_level;
-      this->tria->levels[this->present_level]
-        ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell + i]
-        .second = pointer->present_index;
-    }
+    this->tria->levels[this->present_level]->set_neighbor(
+      this->present_index * GeometryInfo<dim>::faces_per_cell + i,
+      pointer->present_level,
+      pointer->present_index);
   else
-    {
-      this->tria->levels[this->present_level]
-        ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell + i]
-        .first = -1;
-      this->tria->levels[this->present_level]
-        ->neighbors[this->present_index * GeometryInfo<dim>::faces_per_cell + i]
-        .second = -1;
-    }
+    this->tria->levels[this->present_level]->set_neighbor(
+      this->present_index * GeometryInfo<dim>::faces_per_cell + i, -1, -1);
 }
 
 
@@ -1,6 +1,6 @@
 // ---------------------------------------------------------------------
 //
-// Copyright (C) 2006 - 2020 by the deal.II authors
+// Copyright (C) 2006 - 2021 by the deal.II authors
 //
 // This file is part of the deal.II library.
 //
@@ -27,15 +27,37 @@ namespace internal
     std::size_t
     TriaLevel::memory_consumption() const
     {
-      return (MemoryConsumption::memory_consumption(refine_flags) +
-              MemoryConsumption::memory_consumption(coarsen_flags) +
-              MemoryConsumption::memory_consumption(active_cell_indices) +
-              MemoryConsumption::memory_consumption(neighbors) +
-              MemoryConsumption::memory_consumption(subdomain_ids) +
-              MemoryConsumption::memory_consumption(level_subdomain_ids) +
-              MemoryConsumption::memory_consumption(parents) +
-              MemoryConsumption::memory_consumption(direction_flags) +
-              MemoryConsumption::memory_consumption(cells));
+      std::size_t mem = 0;
+      for (const auto &field : memory_consumption_per_field())
+        mem += field.second;
+      return mem;
+    }
+
+
+
+    std::vector<std::pair<std::string, std::size_t>>
+    TriaLevel::memory_consumption_per_field() const
+    {
+      using MemoryConsumption::memory_consumption;
+      return {
+        {"cell_flags", memory_consumption(cell_flags)},
+        {"active_cell_indices", memory_consumption(active_cell_indices)},
+        {"global_active_cell_indices",
+         memory_consumption(global_active_cell_indices)},
+        {"global_level_cell_indices",
+         memory_consumption(global_level_cell_indices)},
+        {"neighbor_indices", memory_consumption(neighbor_indices)},
+        {"neighbor_levels", memory_consumption(neighbor_levels)},
+        {"subdomain_ids", memory_consumption(subdomain_ids)},
+        {"level_subdomain_ids", memory_consumption(level_subdomain_ids)},
+        {"parents", memory_consumption(parents)},
+        {"cells", memory_consumption(cells)},
+        {"face_orientations", memory_consumption(face_orientations)},
+        {"reference_cell",
+         sizeof(reference_cell) +
+           reference_cell.capacity() * sizeof(dealii::ReferenceCell)},
+        {"cell_vertex_indices_cache",
+         memory_consumption(cell_vertex_indices_cache)}};
     }
   } // namespace TriangulationImplementation
 } // namespace internal
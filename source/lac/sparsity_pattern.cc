@@ -26,6 +26,7 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -235,6 +236,8 @@ SparsityPattern::reinit(const size_type                      m,
   rows = m;
   cols = n;
 
+  column_offsets.reset();
+
   // delete empty matrices
   if ((m == 0) || (n == 0))
     {
@@ -337,6 +340,8 @@ SparsityPattern::reinit(const size_type                      m,
 void
 SparsityPattern::compress()
 {
+  column_offsets.reset();
+
   // nothing to do if the object corresponds to an empty matrix
   if ((rowstart == nullptr) && (colnums == nullptr))
     {
@@ -438,6 +443,38 @@ SparsityPattern::compress()
 
 
 
+bool
+SparsityPattern::compress_column_indices()
+{
+  Assert(compressed, ExcNotCompressed());
+
+  column_offsets.reset();
+  if (rowstart == nullptr)
+    return false;
+
+  // check that all offsets fit into 32 bits before allocating memory
+  const std::int64_t min_offset = std::numeric_limits<std::int32_t>::min();
+  const std::int64_t max_offset = std::numeric_limits<std::int32_t>::max();
+  for (size_type row = 0; row < rows; ++row)
+    for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+      {
+        const std::int64_t offset = static_cast<std::int64_t>(colnums[j]) -
+                                    static_cast<std::int64_t>(row);
+        if (offset < min_offset || offset > max_offset)
+          return false;
+      }
+
+  column_offsets = std::make_unique<std::int32_t[]>(rowstart[rows]);
+  for (size_type row = 0; row < rows; ++row)
+    for (std::size_t j = rowstart[row]; j < rowstart[row + 1]; ++j)
+      column_offsets[j] = static_cast<std::int32_t>(
+        static_cast<std::int64_t>(colnums[j]) - static_cast<std::int64_t>(row));
+
+  return true;
+}
+
+
+
 void
 SparsityPattern::copy_from(const SparsityPattern &sp)
 {
@@ -1008,6 +1045,7 @@ SparsityPattern::block_read(std::istream &in)
   // reallocate space
   rowstart = std::make_unique<std::size_t[]>(max_dim + 1);
   colnums  = std::make_unique<size_type[]>(max_vec_len);
+  column_offsets.reset();
 
   // then read data
   in.read(reinterpret_cast<char *>(rowstart.get()),
@@ -1037,7 +1075,10 @@ SparsityPatternBase::memory_consumption() const
 std::size_t
 SparsityPattern::memory_consumption() const
 {
-  return sizeof(*this) + SparsityPatternBase::memory_consumption();
+  return sizeof(*this) + SparsityPatternBase::memory_consumption() +
+         (column_offsets != nullptr ?
+            n_nonzero_elements() * sizeof(std::int32_t) :
+            0);
 }
 
 
@@ -21,8 +21,13 @@
 #include <deal.II/lac/sparsity_tools.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <numeric>
+#include <queue>
 #include <set>
 
 #ifdef DEAL_II_WITH_MPI
@@ -392,6 +397,623 @@ namespace SparsityTools
         partition_indices[export_local_ids[i]] = export_to_part[i];
 #endif
     }
+
+
+
+    /**
+     * A graph in compressed row storage with weights on its vertices and
+     * edges, as used by the built-in multilevel partitioner.
+     */
+    struct WeightedGraph
+    {
+      std::vector<unsigned int> row_start;
+      std::vector<unsigned int> columns;
+      std::vector<unsigned int> edge_weights;
+      std::vector<unsigned int> vertex_weights;
+
+      unsigned int
+      n_vertices() const
+      {
+        return vertex_weights.size();
+      }
+    };
+
+
+
+    /**
+     * Collapse pairs of vertices of @p graph connected by the heaviest edges
+     * into single vertices (heavy-edge matching), and return the resulting
+     * coarser graph. On return, @p coarse_vertex contains for each vertex of
+     * @p graph the index of the vertex of the coarse graph it belongs to.
+     */
+    WeightedGraph
+    coarsen_graph(const WeightedGraph &      graph,
+                  std::vector<unsigned int> &coarse_vertex)
+    {
+      const unsigned int n             = graph.n_vertices();
+      const unsigned int invalid_index = numbers::invalid_unsigned_int;
+
+      // visit vertices with few neighbors first, since they have the
+      // fewest options to find a partner
+      std::vector<unsigned int> order(n);
+      std::iota(order.begin(), order.end(), 0U);
+      std::stable_sort(order.begin(),
+                       order.end(),
+                       [&](const unsigned int a, const unsigned int b) {
+                         return graph.row_start[a + 1] - graph.row_start[a] <
+                                graph.row_start[b + 1] - graph.row_start[b];
+                       });
+
+      coarse_vertex.assign(n, invalid_index);
+      std::vector<std::pair<unsigned int, unsigned int>> matching;
+      matching.reserve(n);
+      for (const unsigned int v : order)
+        if (coarse_vertex[v] == invalid_index)
+          {
+            unsigned int partner = v, partner_weight = 0;
+            for (unsigned int e = graph.row_start[v];
+                 e < graph.row_start[v + 1];
+                 ++e)
+              if (coarse_vertex[graph.columns[e]] == invalid_index &&
+                  graph.columns[e] != v &&
+                  graph.edge_weights[e] > partner_weight)
+                {
+                  partner        = graph.columns[e];
+                  partner_weight = graph.edge_weights[e];
+                }
+
+            coarse_vertex[v] = coarse_vertex[partner] = matching.size();
+            matching.emplace_back(v, partner);
+          }
+
+      // merge the adjacency lists of matched vertices, dropping the edge
+      // between them and adding up the weights of parallel edges
+      WeightedGraph coarse_graph;
+      coarse_graph.row_start.reserve(matching.size() + 1);
+      coarse_graph.row_start.push_back(0);
+      coarse_graph.vertex_weights.reserve(matching.size());
+      std::vector<unsigned int> position(matching.size(), invalid_index);
+      for (unsigned int c = 0; c < matching.size(); ++c)
+        {
+          const unsigned int begin = coarse_graph.columns.size();
+          for (const unsigned int v : {matching[c].first, matching[c].second})
+            {
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                {
+                  const unsigned int neighbor =
+                    coarse_vertex[graph.columns[e]];
+                  if (neighbor == c)
+                    continue;
+                  if (position[neighbor] == invalid_index)
+                    {
+                      position[neighbor] = coarse_graph.columns.size();
+                      coarse_graph.columns.push_back(neighbor);
+                      coarse_graph.edge_weights.push_back(
+                        graph.edge_weights[e]);
+                    }
+                  else
+                    coarse_graph.edge_weights[position[neighbor]] +=
+                      graph.edge_weights[e];
+                }
+              if (matching[c].second == matching[c].first)
+                break;
+            }
+          for (unsigned int e = begin; e < coarse_graph.columns.size(); ++e)
+            position[coarse_graph.columns[e]] = invalid_index;
+
+          coarse_graph.row_start.push_back(coarse_graph.columns.size());
+          coarse_graph.vertex_weights.push_back(
+            graph.vertex_weights[matching[c].first] +
+            (matching[c].second != matching[c].first ?
+               graph.vertex_weights[matching[c].second] :
+               0));
+        }
+
+      return coarse_graph;
+    }
+
+
+
+    /**
+     * Quality of a bisection: the amount by which the weights of the two
+     * parts exceed their limits, and the weight of the cut edges. Smaller
+     * is better, with the balance taking precedence over the cut.
+     */
+    std::pair<std::uint64_t, std::uint64_t>
+    bisection_quality(const std::array<std::uint64_t, 2> &part_weights,
+                      const std::array<std::uint64_t, 2> &max_part_weights,
+                      const std::uint64_t                 cut)
+    {
+      std::uint64_t excess = 0;
+      for (unsigned int s = 0; s < 2; ++s)
+        if (part_weights[s] > max_part_weights[s])
+          excess += part_weights[s] - max_part_weights[s];
+      return {excess, cut};
+    }
+
+
+
+    /**
+     * Improve the bisection @p side of @p graph by moving single vertices
+     * between the two parts in the spirit of Fiduccia and Mattheyses: in
+     * each pass, every vertex is moved at most once, always choosing the
+     * move that reduces the weight of the cut edges the most (or increases
+     * it the least) while respecting @p max_part_weights. At the end of a
+     * pass, the moves after the best intermediate state are undone. The
+     * passes stop as soon as one of them does not improve the bisection.
+     */
+    void
+    refine_bisection(const WeightedGraph &               graph,
+                     const std::array<std::uint64_t, 2> &max_part_weights,
+                     std::vector<unsigned char> &        side)
+    {
+      const unsigned int n = graph.n_vertices();
+
+      std::array<std::uint64_t, 2> part_weights = {{0, 0}};
+      for (unsigned int v = 0; v < n; ++v)
+        part_weights[side[v]] += graph.vertex_weights[v];
+
+      // the gain of a vertex is the reduction of the weight of the cut edges
+      // if the vertex is moved to the other part
+      std::vector<std::int64_t> gains(n);
+      std::vector<bool>         locked(n);
+      std::vector<unsigned int> moves;
+
+      const unsigned int max_moves_without_improvement =
+        std::max<unsigned int>(25, n / 100);
+      const unsigned int max_passes = 8;
+
+      for (unsigned int pass = 0; pass < max_passes; ++pass)
+        {
+          std::uint64_t cut = 0;
+          std::array<std::set<std::pair<std::int64_t, unsigned int>>, 2>
+            queues;
+          for (unsigned int v = 0; v < n; ++v)
+            {
+              gains[v]         = 0;
+              bool at_boundary = false;
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                if (side[graph.columns[e]] != side[v])
+                  {
+                    gains[v] += graph.edge_weights[e];
+                    cut += graph.edge_weights[e];
+                    at_boundary = true;
+                  }
+                else
+                  gains[v] -= graph.edge_weights[e];
+
+              // only vertices at the boundary between the two parts are
+              // candidates in the beginning, the others are added once one
+              // of their neighbors has been moved
+              if (at_boundary)
+                queues[side[v]].emplace(-gains[v], v);
+            }
+          cut /= 2;
+
+          std::fill(locked.begin(), locked.end(), false);
+          moves.clear();
+
+          auto best_quality =
+            bisection_quality(part_weights, max_part_weights, cut);
+          unsigned int n_best_moves = 0;
+
+          while (moves.size() - n_best_moves < max_moves_without_improvement)
+            {
+              // find the best feasible move out of either part
+              unsigned int from = numbers::invalid_unsigned_int;
+              for (unsigned int s = 0; s < 2; ++s)
+                if (!queues[s].empty())
+                  {
+                    const unsigned int v = queues[s].begin()->second;
+                    if (part_weights[1 - s] + graph.vertex_weights[v] >
+                        max_part_weights[1 - s])
+                      continue;
+                    if (from == numbers::invalid_unsigned_int ||
+                        gains[v] > gains[queues[from].begin()->second] ||
+                        (gains[v] == gains[queues[from].begin()->second] &&
+                         part_weights[s] > part_weights[from]))
+                      from = s;
+                  }
+              if (from == numbers::invalid_unsigned_int)
+                break;
+
+              const unsigned int v = queues[from].begin()->second;
+              queues[from].erase(queues[from].begin());
+              locked[v] = true;
+              side[v]   = 1 - from;
+              part_weights[from] -= graph.vertex_weights[v];
+              part_weights[1 - from] += graph.vertex_weights[v];
+              cut -= gains[v];
+              moves.push_back(v);
+
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                {
+                  const unsigned int u = graph.columns[e];
+                  if (locked[u])
+                    continue;
+                  queues[side[u]].erase({-gains[u], u});
+                  if (side[u] == side[v])
+                    gains[u] -= 2 * static_cast<std::int64_t>(
+                                      graph.edge_weights[e]);
+                  else
+                    gains[u] += 2 * static_cast<std::int64_t>(
+                                      graph.edge_weights[e]);
+                  queues[side[u]].emplace(-gains[u], u);
+                }
+
+              const auto quality =
+                bisection_quality(part_weights, max_part_weights, cut);
+              if (quality < best_quality)
+                {
+                  best_quality = quality;
+                  n_best_moves = moves.size();
+                }
+            }
+
+          // undo the moves after the best state
+          for (unsigned int i = n_best_moves; i < moves.size(); ++i)
+            {
+              const unsigned int v = moves[i];
+              part_weights[side[v]] -= graph.vertex_weights[v];
+              side[v] = 1 - side[v];
+              part_weights[side[v]] += graph.vertex_weights[v];
+            }
+
+          if (n_best_moves == 0)
+            break;
+        }
+    }
+
+
+
+    /**
+     * Split @p graph into two parts by growing the first part from a single
+     * vertex, always adding the vertex at its boundary that increases the
+     * weight of the cut edges the least, until it has reached
+     * @p target_weight. Several starting vertices are tried and the best
+     * result after refinement is returned.
+     */
+    std::vector<unsigned char>
+    grow_bisection(const WeightedGraph &               graph,
+                   const std::uint64_t                 target_weight,
+                   const std::array<std::uint64_t, 2> &max_part_weights)
+    {
+      const unsigned int n = graph.n_vertices();
+
+      // start with a vertex far away from the first one, found by a
+      // breadth-first search, and with vertices spread over the index range
+      std::vector<unsigned int> seeds;
+      {
+        std::vector<bool>        visited(n);
+        std::queue<unsigned int> queue;
+        queue.push(0);
+        visited[0]        = true;
+        unsigned int last = 0;
+        while (!queue.empty())
+          {
+            last = queue.front();
+            queue.pop();
+            for (unsigned int e = graph.row_start[last];
+                 e < graph.row_start[last + 1];
+                 ++e)
+              if (!visited[graph.columns[e]])
+                {
+                  visited[graph.columns[e]] = true;
+                  queue.push(graph.columns[e]);
+                }
+          }
+        seeds.push_back(last);
+      }
+      const unsigned int n_tries = 4;
+      for (unsigned int i = 0; i < n_tries; ++i)
+        if (std::find(seeds.begin(), seeds.end(), i * n / n_tries) ==
+            seeds.end())
+          seeds.push_back(i * n / n_tries);
+
+      std::vector<unsigned char>              best_side;
+      std::pair<std::uint64_t, std::uint64_t> best_quality;
+      std::vector<std::int64_t>               gains(n);
+      for (const unsigned int seed : seeds)
+        {
+          std::vector<unsigned char> side(n, 1);
+          std::uint64_t              weight = 0;
+
+          // the gain of a vertex is the reduction of the weight of the cut
+          // edges if the vertex is added to the first part
+          for (unsigned int v = 0; v < n; ++v)
+            {
+              gains[v] = 0;
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                gains[v] -= graph.edge_weights[e];
+            }
+
+          std::set<std::pair<std::int64_t, unsigned int>> frontier;
+          frontier.emplace(-gains[seed], seed);
+          unsigned int next_unvisited = 0;
+          while (weight < target_weight)
+            {
+              unsigned int v;
+              if (frontier.empty())
+                {
+                  // the graph is not connected, continue with the next
+                  // vertex not yet in the first part
+                  while (side[next_unvisited] == 0)
+                    ++next_unvisited;
+                  v = next_unvisited;
+                }
+              else
+                {
+                  v = frontier.begin()->second;
+                  frontier.erase(frontier.begin());
+                }
+
+              // stop if adding the vertex would overshoot the target by
+              // more than leaving it out undershoots it
+              if (weight > 0 &&
+                  weight + graph.vertex_weights[v] > target_weight &&
+                  weight + graph.vertex_weights[v] - target_weight >
+                    target_weight - weight)
+                break;
+
+              side[v] = 0;
+              weight += graph.vertex_weights[v];
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                {
+                  const unsigned int u = graph.columns[e];
+                  if (side[u] == 0)
+                    continue;
+                  frontier.erase({-gains[u], u});
+                  gains[u] +=
+                    2 * static_cast<std::int64_t>(graph.edge_weights[e]);
+                  frontier.emplace(-gains[u], u);
+                }
+            }
+
+          refine_bisection(graph, max_part_weights, side);
+
+          std::array<std::uint64_t, 2> part_weights = {{0, 0}};
+          std::uint64_t                cut          = 0;
+          for (unsigned int v = 0; v < n; ++v)
+            {
+              part_weights[side[v]] += graph.vertex_weights[v];
+              for (unsigned int e = graph.row_start[v];
+                   e < graph.row_start[v + 1];
+                   ++e)
+                if (side[graph.columns[e]] != side[v])
+                  cut += graph.edge_weights[e];
+            }
+
+          const auto quality =
+            bisection_quality(part_weights, max_part_weights, cut / 2);
+          if (best_side.empty() || quality < best_quality)
+            {
+              best_side    = std::move(side);
+              best_quality = quality;
+            }
+        }
+
+      return best_side;
+    }
+
+
+
+    /**
+     * Split @p graph into two parts, the first one of which has the fraction
+     * @p target_fraction of the total weight, such that the weight of the
+     * edges between the two parts is small. Each part may exceed its share
+     * of the total weight by the factor @p imbalance. The limits are computed
+     * from the exact shares instead of rounded target weights, so that the
+     * factors of nested bisections multiply without rounding errors. This is
+     * done with a multilevel scheme:
+     * The graph is coarsened repeatedly, the coarsest graph is bisected by
+     * grow_bisection(), and the bisection is projected back to the finer
+     * graphs, where it is improved by refine_bisection() on each level.
+     */
+    std::vector<unsigned char>
+    bisect_graph(const WeightedGraph &graph,
+                 const double         target_fraction,
+                 const double         imbalance)
+    {
+      // stop coarsening once the graph is small or does not shrink
+      // significantly anymore
+      const unsigned int max_coarsest_size = 64;
+
+      std::vector<WeightedGraph>             coarse_graphs;
+      std::vector<std::vector<unsigned int>> coarse_vertices;
+      while (true)
+        {
+          const WeightedGraph &fine_graph =
+            coarse_graphs.empty() ? graph : coarse_graphs.back();
+          if (fine_graph.n_vertices() <= max_coarsest_size)
+            break;
+
+          std::vector<unsigned int> coarse_vertex;
+          WeightedGraph coarse_graph = coarsen_graph(fine_graph, coarse_vertex);
+          if (coarse_graph.n_vertices() > 0.95 * fine_graph.n_vertices())
+            break;
+
+          coarse_graphs.push_back(std::move(coarse_graph));
+          coarse_vertices.push_back(std::move(coarse_vertex));
+        }
+
+      // allow the parts to exceed their share of the total weight by the
+      // given factor, and on coarse graphs additionally by the weight of the
+      // heaviest vertex
+      const std::uint64_t total_weight =
+        std::accumulate(graph.vertex_weights.begin(),
+                        graph.vertex_weights.end(),
+                        std::uint64_t(0));
+      const std::uint64_t target_weight =
+        static_cast<std::uint64_t>(std::round(target_fraction * total_weight));
+      const auto max_part_weights = [&](const WeightedGraph &level_graph) {
+        const std::uint64_t slack =
+          level_graph.n_vertices() == graph.n_vertices() ?
+            0 :
+            *std::max_element(level_graph.vertex_weights.begin(),
+                              level_graph.vertex_weights.end());
+        return std::array<std::uint64_t, 2>{
+          {static_cast<std::uint64_t>(imbalance * target_fraction *
+                                      total_weight) +
+             slack,
+           static_cast<std::uint64_t>(imbalance * (1. - target_fraction) *
+                                      total_weight) +
+             slack}};
+      };
+
+      const WeightedGraph &coarsest_graph =
+        coarse_graphs.empty() ? graph : coarse_graphs.back();
+      std::vector<unsigned char> side =
+        grow_bisection(coarsest_graph,
+                       target_weight,
+                       max_part_weights(coarsest_graph));
+
+      for (unsigned int level = coarse_graphs.size(); level > 0; --level)
+        {
+          const WeightedGraph &fine_graph =
+            (level == 1) ? graph : coarse_graphs[level - 2];
+
+          std::vector<unsigned char> fine_side(fine_graph.n_vertices());
+          for (unsigned int v = 0; v < fine_graph.n_vertices(); ++v)
+            fine_side[v] = side[coarse_vertices[level - 1][v]];
+          side = std::move(fine_side);
+
+          refine_bisection(fine_graph, max_part_weights(fine_graph), side);
+        }
+
+      return side;
+    }
+
+
+
+    /**
+     * Partition @p graph into @p n_partitions parts by recursive bisection
+     * and store the partition of vertex @p v, offset by
+     * @p first_partition, in the entry @p vertex_indices[v] of
+     * @p partition_indices. Every bisection may exceed the target weights
+     * by the factor @p imbalance.
+     */
+    void
+    partition_recursively(const WeightedGraph &            graph,
+                          const std::vector<unsigned int> &vertex_indices,
+                          const unsigned int               n_partitions,
+                          const unsigned int               first_partition,
+                          const double                     imbalance,
+                          std::vector<unsigned int> &      partition_indices)
+    {
+      if (n_partitions == 1 || graph.n_vertices() <= 1)
+        {
+          for (const unsigned int i : vertex_indices)
+            partition_indices[i] = first_partition;
+          return;
+        }
+
+      const unsigned int n_partitions_0 = n_partitions / 2;
+
+      const std::vector<unsigned char> side =
+        bisect_graph(graph,
+                     static_cast<double>(n_partitions_0) / n_partitions,
+                     imbalance);
+
+      // extract the subgraphs of both parts and partition them further
+      std::vector<unsigned int> new_index(graph.n_vertices());
+      for (unsigned int s = 0; s < 2; ++s)
+        {
+          WeightedGraph             subgraph;
+          std::vector<unsigned int> subgraph_vertex_indices;
+          for (unsigned int v = 0; v < graph.n_vertices(); ++v)
+            if (side[v] == s)
+              {
+                new_index[v] = subgraph_vertex_indices.size();
+                subgraph_vertex_indices.push_back(vertex_indices[v]);
+              }
+
+          subgraph.row_start.push_back(0);
+          for (unsigned int v = 0; v < graph.n_vertices(); ++v)
+            if (side[v] == s)
+              {
+                for (unsigned int e = graph.row_start[v];
+                     e < graph.row_start[v + 1];
+                     ++e)
+                  if (side[graph.columns[e]] == s)
+                    {
+                      subgraph.columns.push_back(new_index[graph.columns[e]]);
+                      subgraph.edge_weights.push_back(graph.edge_weights[e]);
+                    }
+                subgraph.row_start.push_back(subgraph.columns.size());
+                subgraph.vertex_weights.push_back(graph.vertex_weights[v]);
+              }
+
+          partition_recursively(subgraph,
+                                subgraph_vertex_indices,
+                                (s == 0) ? n_partitions_0 :
+                                           n_partitions - n_partitions_0,
+                                (s == 0) ? first_partition :
+                                           first_partition + n_partitions_0,
+                                imbalance,
+                                partition_indices);
+        }
+    }
+
+
+
+    void
+    partition_multilevel(const SparsityPattern &          sparsity_pattern,
+                         const std::vector<unsigned int> &cell_weights,
+                         const unsigned int               n_partitions,
+                         std::vector<unsigned int> &      partition_indices)
+    {
+      // set up the graph, ignoring the diagonal entries of the sparsity
+      // pattern
+      WeightedGraph graph;
+      graph.row_start.reserve(sparsity_pattern.n_rows() + 1);
+      graph.row_start.push_back(0);
+      graph.columns.reserve(sparsity_pattern.n_nonzero_elements());
+      for (SparsityPattern::size_type row = 0; row < sparsity_pattern.n_rows();
+           ++row)
+        {
+          for (SparsityPattern::iterator col = sparsity_pattern.begin(row);
+               col < sparsity_pattern.end(row);
+               ++col)
+            if (col->column() != row)
+              graph.columns.push_back(col->column());
+          graph.row_start.push_back(graph.columns.size());
+        }
+      graph.edge_weights.resize(graph.columns.size(), 1);
+
+      if (cell_weights.size() > 0)
+        {
+          Assert(cell_weights.size() == sparsity_pattern.n_rows(),
+                 ExcDimensionMismatch(cell_weights.size(),
+                                      sparsity_pattern.n_rows()));
+          graph.vertex_weights = cell_weights;
+        }
+      else
+        graph.vertex_weights.resize(sparsity_pattern.n_rows(), 1);
+
+      std::vector<unsigned int> vertex_indices(graph.n_vertices());
+      std::iota(vertex_indices.begin(), vertex_indices.end(), 0U);
+
+      // the imbalances of the bisections multiply along the recursion, so
+      // split the allowed imbalance of 3 percent between the levels of the
+      // recursion
+      unsigned int n_levels = 1;
+      while ((1U << n_levels) < n_partitions)
+        ++n_levels;
+      const double imbalance = std::pow(1.03, 1. / n_levels);
+
+      partition_recursively(
+        graph, vertex_indices, n_partitions, 0, imbalance, partition_indices);
+    }
   } // namespace
 
 
@@ -446,6 +1068,11 @@ namespace SparsityTools
                        cell_weights,
                        n_partitions,
                        partition_indices);
+    else if (partitioner == Partitioner::multilevel)
+      partition_multilevel(sparsity_pattern,
+                           cell_weights,
+                           n_partitions,
+                           partition_indices);
     else
       AssertThrow(false, ExcInternalError());
   }
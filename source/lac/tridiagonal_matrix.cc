@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/lac/full_matrix.h>
 #include <deal.II/lac/lapack_templates.h>
 #include <deal.II/lac/tridiagonal_matrix.h>
 #include <deal.II/lac/vector.h>
@@ -259,6 +260,44 @@ TridiagonalMatrix<number>::compute_eigenvalues()
 
 
 
+template <typename number>
+void
+TridiagonalMatrix<number>::compute_eigenvalues(FullMatrix<number> &eigenvectors)
+{
+#ifdef DEAL_II_WITH_LAPACK
+  Assert(state == matrix, ExcState(state));
+  Assert(is_symmetric, ExcNotImplemented());
+
+  const types::blas_int nn = n();
+  std::vector<number>   z(n() * n());
+  std::vector<number>   work(std::max<size_type>(1, 2 * n()));
+  types::blas_int       info;
+  stev(&V,
+       &nn,
+       diagonal.data(),
+       right.data(),
+       z.data(),
+       &nn,
+       work.data(),
+       &info);
+  Assert(info == 0, ExcInternalError());
+
+  // LAPACK returns the eigenvectors as the columns of a matrix in column
+  // major order
+  eigenvectors.reinit(n(), n());
+  for (size_type i = 0; i < n(); ++i)
+    for (size_type j = 0; j < n(); ++j)
+      eigenvectors(j, i) = z[i * n() + j];
+
+  state = LAPACKSupport::eigenvalues;
+#else
+  (void)eigenvectors;
+  AssertThrow(false, ExcNeedsLAPACK());
+#endif
+}
+
+
+
 template <typename number>
 number
 TridiagonalMatrix<number>::eigenvalue(const size_type i) const
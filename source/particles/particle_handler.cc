@@ -13,6 +13,8 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
@@ -590,12 +592,48 @@ namespace Particles
 
     (void)missing_points;
 
+    // Allocate the memory for all new particles at once. The new handles
+    // are contiguous and ordered by cell, so that the data of the particles
+    // of each cell ends up in consecutive memory.
+    std::vector<unsigned int> cell_offsets(cells.size() + 1, 0);
     for (unsigned int i = 0; i < cells.size(); ++i)
-      for (unsigned int p = 0; p < local_positions[i].size(); ++p)
-        insert_particle(positions[index_map[i][p]],
-                        local_positions[i][p],
-                        local_start_index + index_map[i][p],
-                        cells[i]);
+      cell_offsets[i + 1] = cell_offsets[i] + local_positions[i].size();
+
+    const typename PropertyPool<dim, spacedim>::Handle first_handle =
+      property_pool->register_particles(cell_offsets.back());
+
+    // Every cell appears only once in the list of cells returned above, so
+    // the particles can be inserted into the cells concurrently.
+    parallel::apply_to_subranges(
+      0U,
+      static_cast<unsigned int>(cells.size()),
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          {
+            Assert(cells[i]->is_locally_owned(),
+                   ExcMessage("You tried to insert a particle into a cell "
+                              "that is not locally owned. This is not "
+                              "supported."));
+
+            auto &particles_on_cell =
+              particles[cells[i]->active_cell_index()];
+            particles_on_cell.reserve(particles_on_cell.size() +
+                                      local_positions[i].size());
+            for (unsigned int p = 0; p < local_positions[i].size(); ++p)
+              {
+                const typename PropertyPool<dim, spacedim>::Handle handle =
+                  first_handle + cell_offsets[i] + p;
+                property_pool->set_location(handle,
+                                            positions[index_map[i][p]]);
+                property_pool->set_reference_location(handle,
+                                                      local_positions[i][p]);
+                property_pool->set_id(handle,
+                                      local_start_index + index_map[i][p]);
+                particles_on_cell.push_back(handle);
+              }
+          }
+      },
+      32);
 
     update_cached_numbers();
   }
@@ -1064,57 +1102,83 @@ namespace Particles
     // TODO: Extend this function to allow keeping particles on other
     // processes around (with an invalid cell).
 
-    std::vector<particle_iterator> particles_out_of_cell;
-
-    // Reserve some space for particles that need sorting to avoid frequent
-    // re-allocation. Guess 25% of particles need sorting. Balance memory
-    // overhead and performance.
-    particles_out_of_cell.reserve(n_locally_owned_particles() / 4);
-
-    // Now update the reference locations of the moved particles
-    std::vector<Point<spacedim>> real_locations;
-    std::vector<Point<dim>>      reference_locations;
-    real_locations.reserve(global_max_particles_per_cell);
-    reference_locations.reserve(global_max_particles_per_cell);
-
+    // Update the reference locations of the particles of all locally owned
+    // cells. Particles can be inserted into arbitrary cells, e.g. if their
+    // cell is not known. However, for artificial cells we can not evaluate
+    // the reference position of particles. Do not sort particles that are
+    // not locally owned, because they will be sorted by the process that
+    // owns them.
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells_to_sort;
     for (const auto &cell : triangulation->active_cell_iterators())
-      {
-        const unsigned int active_cell_index = cell->active_cell_index();
-        const unsigned int n_pic = particles[active_cell_index].size();
-
-        // Particles can be inserted into arbitrary cells, e.g. if their cell is
-        // not known. However, for artificial cells we can not evaluate
-        // the reference position of particles. Do not sort particles that are
-        // not locally owned, because they will be sorted by the process that
-        // owns them.
-        if (cell->is_locally_owned() == false)
+      if (cell->is_locally_owned() &&
+          particles[cell->active_cell_index()].size() > 0)
+        cells_to_sort.push_back(cell);
+
+    // The cells are processed in chunks on separate tasks, each of which
+    // collects the particles that left their cell in its own vector. The
+    // vectors are concatenated in the order of the cells afterwards, which
+    // keeps the result independent of the number of threads.
+    const unsigned int n_cells_per_chunk = 64;
+    const unsigned int n_chunks =
+      (cells_to_sort.size() + n_cells_per_chunk - 1) / n_cells_per_chunk;
+    std::vector<std::vector<particle_iterator>> particles_out_of_cell_in_chunk(
+      n_chunks);
+
+    parallel::apply_to_subranges(
+      0U,
+      n_chunks,
+      [&](const unsigned int first_chunk, const unsigned int end_chunk) {
+        std::vector<Point<spacedim>> real_locations;
+        std::vector<Point<dim>>      reference_locations;
+        real_locations.reserve(global_max_particles_per_cell);
+        reference_locations.reserve(global_max_particles_per_cell);
+
+        for (unsigned int chunk = first_chunk; chunk < end_chunk; ++chunk)
           {
-            continue;
-          }
-
-        auto pic = particles_in_cell(cell);
+            const unsigned int end_cell =
+              std::min<unsigned int>((chunk + 1) * n_cells_per_chunk,
+                                     cells_to_sort.size());
+            for (unsigned int c = chunk * n_cells_per_chunk; c < end_cell; ++c)
+              {
+                const auto &cell = cells_to_sort[c];
+                auto        pic  = particles_in_cell(cell);
 
-        real_locations.clear();
-        for (const auto &particle : pic)
-          real_locations.push_back(particle.get_location());
+                real_locations.clear();
+                for (const auto &particle : pic)
+                  real_locations.push_back(particle.get_location());
 
-        reference_locations.resize(n_pic);
-        mapping->transform_points_real_to_unit_cell(cell,
-                                                    real_locations,
-                                                    reference_locations);
+                reference_locations.resize(real_locations.size());
+                mapping->transform_points_real_to_unit_cell(
+                  cell, real_locations, reference_locations);
 
-        auto particle = pic.begin();
-        for (const auto &p_unit : reference_locations)
-          {
-            if (p_unit[0] == std::numeric_limits<double>::infinity() ||
-                !GeometryInfo<dim>::is_inside_unit_cell(p_unit))
-              particles_out_of_cell.push_back(particle);
-            else
-              particle->set_reference_location(p_unit);
+                auto particle = pic.begin();
+                for (const auto &p_unit : reference_locations)
+                  {
+                    if (p_unit[0] == std::numeric_limits<double>::infinity() ||
+                        !GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                      particles_out_of_cell_in_chunk[chunk].push_back(particle);
+                    else
+                      particle->set_reference_location(p_unit);
 
-            ++particle;
+                    ++particle;
+                  }
+              }
           }
-      }
+      },
+      1);
+
+    std::vector<particle_iterator> particles_out_of_cell;
+    {
+      std::size_t n_particles_out_of_cell = 0;
+      for (const auto &chunk : particles_out_of_cell_in_chunk)
+        n_particles_out_of_cell += chunk.size();
+      particles_out_of_cell.reserve(n_particles_out_of_cell);
+      for (const auto &chunk : particles_out_of_cell_in_chunk)
+        particles_out_of_cell.insert(particles_out_of_cell.end(),
+                                     chunk.begin(),
+                                     chunk.end());
+    }
 
     // There are three reasons why a particle is not in its old cell:
     // It moved to another cell, to another subdomain or it left the mesh.
@@ -1162,77 +1226,95 @@ namespace Particles
         &vertex_to_cell_centers =
           triangulation_cache->get_vertex_to_cell_centers_directions();
 
-      std::vector<unsigned int> neighbor_permutation;
-
-      // Find the cells that the particles moved to.
-      for (auto &out_particle : particles_out_of_cell)
-        {
-          // make a copy of the current cell, since we will modify the
-          // variable current_cell in the following but we need the original in
-          // the case the particle is not found
-          auto current_cell = out_particle->get_surrounding_cell();
-
-          // The cell the particle is in
-          Point<dim> current_reference_position;
-          bool       found_cell = false;
-
-          // Check if the particle is in one of the old cell's neighbors
-          // that are adjacent to the closest vertex
-          const unsigned int closest_vertex =
-            GridTools::find_closest_vertex_of_cell<dim, spacedim>(
-              current_cell, out_particle->get_location(), *mapping);
-          Tensor<1, spacedim> vertex_to_particle =
-            out_particle->get_location() - current_cell->vertex(closest_vertex);
-          vertex_to_particle /= vertex_to_particle.norm();
-
-          const unsigned int closest_vertex_index =
-            current_cell->vertex_index(closest_vertex);
-          const unsigned int n_neighbor_cells =
-            vertex_to_cells[closest_vertex_index].size();
-
-          neighbor_permutation.resize(n_neighbor_cells);
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
-            neighbor_permutation[i] = i;
-
-          const auto &cell_centers =
-            vertex_to_cell_centers[closest_vertex_index];
-          std::sort(neighbor_permutation.begin(),
-                    neighbor_permutation.end(),
-                    [&vertex_to_particle, &cell_centers](const unsigned int a,
-                                                         const unsigned int b) {
-                      return compare_particle_association(a,
-                                                          b,
-                                                          vertex_to_particle,
-                                                          cell_centers);
-                    });
-
-          // Search all of the cells adjacent to the closest vertex of the
-          // previous cell Most likely we will find the particle in them.
-          for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+      // Find the cells that the particles moved to. Most particles are found
+      // in one of the neighbors of their old cell that are adjacent to the
+      // vertex closest to the particle. This search only reads shared data
+      // and is done in parallel, storing the result for every particle in
+      // its own slot.
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                              new_cells(particles_out_of_cell.size());
+      std::vector<Point<dim>> new_reference_positions(
+        particles_out_of_cell.size());
+
+      parallel::apply_to_subranges(
+        std::size_t(0),
+        particles_out_of_cell.size(),
+        [&](const std::size_t begin, const std::size_t end) {
+          std::vector<unsigned int> neighbor_permutation;
+
+          for (std::size_t p = begin; p < end; ++p)
             {
-              try
+              const auto &out_particle = particles_out_of_cell[p];
+              const auto  current_cell = out_particle->get_surrounding_cell();
+
+              const unsigned int closest_vertex =
+                GridTools::find_closest_vertex_of_cell<dim, spacedim>(
+                  current_cell, out_particle->get_location(), *mapping);
+              Tensor<1, spacedim> vertex_to_particle =
+                out_particle->get_location() -
+                current_cell->vertex(closest_vertex);
+              vertex_to_particle /= vertex_to_particle.norm();
+
+              const unsigned int closest_vertex_index =
+                current_cell->vertex_index(closest_vertex);
+              const unsigned int n_neighbor_cells =
+                vertex_to_cells[closest_vertex_index].size();
+
+              neighbor_permutation.resize(n_neighbor_cells);
+              for (unsigned int i = 0; i < n_neighbor_cells; ++i)
+                neighbor_permutation[i] = i;
+
+              const auto &cell_centers =
+                vertex_to_cell_centers[closest_vertex_index];
+              std::sort(neighbor_permutation.begin(),
+                        neighbor_permutation.end(),
+                        [&vertex_to_particle,
+                         &cell_centers](const unsigned int a,
+                                        const unsigned int b) {
+                          return compare_particle_association(
+                            a, b, vertex_to_particle, cell_centers);
+                        });
+
+              // Search all of the cells adjacent to the closest vertex of the
+              // previous cell Most likely we will find the particle in them.
+              for (unsigned int i = 0; i < n_neighbor_cells; ++i)
                 {
-                  typename std::set<typename Triangulation<dim, spacedim>::
-                                      active_cell_iterator>::const_iterator
-                    cell = vertex_to_cells[closest_vertex_index].begin();
-
-                  std::advance(cell, neighbor_permutation[i]);
-                  const Point<dim> p_unit =
-                    mapping->transform_real_to_unit_cell(
-                      *cell, out_particle->get_location());
-                  if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                  try
                     {
-                      current_cell               = *cell;
-                      current_reference_position = p_unit;
-                      found_cell                 = true;
-                      break;
+                      typename std::set<
+                        typename Triangulation<dim, spacedim>::
+                          active_cell_iterator>::const_iterator cell =
+                        vertex_to_cells[closest_vertex_index].begin();
+
+                      std::advance(cell, neighbor_permutation[i]);
+                      const Point<dim> p_unit =
+                        mapping->transform_real_to_unit_cell(
+                          *cell, out_particle->get_location());
+                      if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                        {
+                          new_cells[p]               = *cell;
+                          new_reference_positions[p] = p_unit;
+                          break;
+                        }
                     }
+                  catch (typename Mapping<dim>::ExcTransformationFailed &)
+                    {}
                 }
-              catch (typename Mapping<dim>::ExcTransformationFailed &)
-                {}
             }
+        },
+        32);
+
+      // Now move the particles to their new cells, which modifies the
+      // particle containers and is done serially.
+      for (unsigned int p = 0; p < particles_out_of_cell.size(); ++p)
+        {
+          auto &out_particle = particles_out_of_cell[p];
+
+          // The cell the particle is in
+          auto       current_cell               = new_cells[p];
+          Point<dim> current_reference_position = new_reference_positions[p];
 
-          if (!found_cell)
+          if (current_cell.state() != IteratorState::valid)
             {
               // The particle is not in a neighbor of the old cell.
               // Look for the new cell in the whole local domain.
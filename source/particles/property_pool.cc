@@ -14,6 +14,7 @@
 // ---------------------------------------------------------------------
 
 
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/signaling_nan.h>
 
 #include <deal.II/particles/property_pool.h>
@@ -22,6 +23,17 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Particles
 {
+  namespace
+  {
+    /**
+     * The minimal number of particles handled by one task when particle
+     * data is initialized or copied in parallel.
+     */
+    constexpr unsigned int grain_size = 2048;
+  } // namespace
+
+
+
   template <int dim, int spacedim>
   const typename PropertyPool<dim, spacedim>::Handle
     PropertyPool<dim, spacedim>::invalid_handle = static_cast<Handle>(-1);
@@ -114,6 +126,41 @@ namespace Particles
 
 
 
+  template <int dim, int spacedim>
+  typename PropertyPool<dim, spacedim>::Handle
+  PropertyPool<dim, spacedim>::register_particles(
+    const unsigned int n_particles)
+  {
+    const Handle first_handle = locations.size();
+
+    locations.resize(locations.size() + n_particles);
+    reference_locations.resize(reference_locations.size() + n_particles);
+    ids.resize(ids.size() + n_particles);
+    properties.resize(properties.size() + n_particles * n_properties);
+
+    // Initialize the new slots in the same way as register_particle(). The
+    // vectors have been resized above, so the slots can be written
+    // concurrently.
+    parallel::apply_to_subranges(
+      first_handle,
+      first_handle + n_particles,
+      [&](const Handle begin, const Handle end) {
+        for (Handle handle = begin; handle < end; ++handle)
+          {
+            locations[handle] = numbers::signaling_nan<Point<spacedim>>();
+            reference_locations[handle] = numbers::signaling_nan<Point<dim>>();
+            ids[handle]                 = numbers::invalid_unsigned_int;
+            for (unsigned int j = 0; j < n_properties; ++j)
+              properties[handle * n_properties + j] = 0;
+          }
+      },
+      grain_size);
+
+    return first_handle;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   PropertyPool<dim, spacedim>::deregister_particle(Handle &handle)
@@ -195,29 +242,36 @@ namespace Particles
   PropertyPool<dim, spacedim>::sort_memory_slots(
     const std::vector<Handle> &handles_to_sort)
   {
-    std::vector<Point<spacedim>>       sorted_locations;
-    std::vector<Point<dim>>            sorted_reference_locations;
-    std::vector<types::particle_index> sorted_ids;
-    std::vector<double>                sorted_properties;
-
-    sorted_locations.reserve(locations.size());
-    sorted_reference_locations.reserve(reference_locations.size());
-    sorted_ids.reserve(ids.size());
-    sorted_properties.reserve(properties.size());
-
-    for (auto &handle : handles_to_sort)
-      {
-        Assert(handle != invalid_handle,
-               ExcMessage(
-                 "Invalid handle detected during sorting particle memory."));
-
-        sorted_locations.push_back(locations[handle]);
-        sorted_reference_locations.push_back(reference_locations[handle]);
-        sorted_ids.push_back(ids[handle]);
-
-        for (unsigned int j = 0; j < n_properties; ++j)
-          sorted_properties.push_back(properties[handle * n_properties + j]);
-      }
+    const std::size_t n_sorted = handles_to_sort.size();
+
+    std::vector<Point<spacedim>>       sorted_locations(n_sorted);
+    std::vector<Point<dim>>            sorted_reference_locations(n_sorted);
+    std::vector<types::particle_index> sorted_ids(n_sorted);
+    std::vector<double> sorted_properties(n_sorted * n_properties);
+
+    // every entry of the sorted arrays is written exactly once, so the
+    // arrays can be filled concurrently
+    parallel::apply_to_subranges(
+      std::size_t(0),
+      n_sorted,
+      [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i)
+          {
+            const Handle handle = handles_to_sort[i];
+            Assert(handle != invalid_handle,
+                   ExcMessage("Invalid handle detected during sorting "
+                              "particle memory."));
+
+            sorted_locations[i]           = locations[handle];
+            sorted_reference_locations[i] = reference_locations[handle];
+            sorted_ids[i]                 = ids[handle];
+
+            for (unsigned int j = 0; j < n_properties; ++j)
+              sorted_properties[i * n_properties + j] =
+                properties[handle * n_properties + j];
+          }
+      },
+      grain_size);
 
     Assert(sorted_locations.size() ==
              locations.size() - currently_available_handles.size(),
@@ -0,0 +1,102 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test DataOutInterface::write_vtu_in_background(): the files written for
+// several "time steps" from snapshots must coincide with what write_vtu()
+// produces at the time the snapshot is taken, even though the patches are
+// rebuilt in between, and errors must be reported when waiting.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+int
+main()
+{
+  initlog();
+
+  Triangulation<2> triangulation;
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(3);
+
+  FE_Q<2>       fe(1);
+  DoFHandler<2> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+
+  DataOut<2> data_out;
+
+  // the time stamp could differ between the two ways of writing
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  data_out.set_flags(flags);
+
+  std::vector<std::string> expected;
+  for (unsigned int step = 0; step < 5; ++step)
+    {
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + 0.1 * i;
+
+      data_out.clear_data_vectors();
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(solution, "solution");
+      data_out.build_patches();
+
+      std::ostringstream reference;
+      data_out.write_vtu(reference);
+      expected.push_back(reference.str());
+
+      data_out.write_vtu_in_background("output_" + std::to_string(step) +
+                                         ".vtu",
+                                       2);
+    }
+  data_out.wait_for_background_writes();
+
+  for (unsigned int step = 0; step < expected.size(); ++step)
+    {
+      std::ifstream      in("output_" + std::to_string(step) + ".vtu");
+      std::ostringstream written;
+      written << in.rdbuf();
+      deallog << "Step " << step << ": "
+              << (written.str() == expected[step] ? "OK" : "DIFFERENT")
+              << std::endl;
+    }
+
+  // errors on the background task are reported when waiting
+  data_out.write_vtu_in_background("non/existing/directory/output.vtu");
+  try
+    {
+      data_out.wait_for_background_writes();
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "Writing to a non-existing directory failed" << std::endl;
+    }
+}
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that compressed VTU data larger than one block is split into
+// several independently compressed blocks with a valid multi-block header,
+// by decoding and decompressing the point coordinates again.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <string>
+
+#include "../tests.h"
+
+void
+check(const DataOutBase::VtkFlags::ZlibCompressionLevel level)
+{
+  // 50x50 cells with four vertices each in three components, i.e.,
+  // 120000 bytes that do not fill the last block of 64 KiB completely
+  Triangulation<2> triangulation;
+  GridGenerator::subdivided_hyper_cube(triangulation, 50);
+
+  DataOut<2> data_out;
+  data_out.attach_triangulation(triangulation);
+  data_out.build_patches();
+
+  DataOutBase::VtkFlags flags;
+  flags.compression_level = level;
+  data_out.set_flags(flags);
+
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  const std::string output = out.str();
+
+  const std::string tag =
+    "<DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"binary\">\n";
+  const std::size_t start = output.find(tag) + tag.size();
+  const std::string data =
+    output.substr(start, output.find('\n', start) - start);
+
+  // the first three entries of the header are encoded in the first 16
+  // characters, the list of compressed block sizes follows
+  const std::vector<unsigned char> header_start =
+    Utilities::decode_base64(data.substr(0, 16));
+  const uint32_t *header_entries =
+    reinterpret_cast<const uint32_t *>(header_start.data());
+  const uint32_t n_blocks        = header_entries[0];
+  const uint32_t block_size      = header_entries[1];
+  const uint32_t last_block_size = header_entries[2];
+  deallog << "Blocks: " << n_blocks << ", block size: " << block_size
+          << ", last block size: " << last_block_size << std::endl;
+
+  const std::size_t header_bytes = (3 + n_blocks) * sizeof(uint32_t);
+  const std::size_t header_chars = 4 * ((header_bytes + 2) / 3);
+  const std::vector<unsigned char> header =
+    Utilities::decode_base64(data.substr(0, header_chars));
+  const std::vector<unsigned char> compressed =
+    Utilities::decode_base64(data.substr(header_chars));
+
+  std::vector<float> points((n_blocks - 1) * block_size / sizeof(float) +
+                            last_block_size / sizeof(float));
+  std::size_t        offset = 0;
+  for (unsigned int b = 0; b < n_blocks; ++b)
+    {
+      const uint32_t compressed_size =
+        reinterpret_cast<const uint32_t *>(header.data())[3 + b];
+      uLongf size = (b == n_blocks - 1) ? last_block_size : block_size;
+      const int err =
+        uncompress(reinterpret_cast<Bytef *>(points.data()) +
+                     std::size_t(b) * block_size,
+                   &size,
+                   compressed.data() + offset,
+                   compressed_size);
+      AssertThrow(err == Z_OK, ExcInternalError());
+      AssertThrow(size == ((b == n_blocks - 1) ? last_block_size : block_size),
+                  ExcInternalError());
+      offset += compressed_size;
+    }
+  AssertThrow(offset == compressed.size(), ExcInternalError());
+
+  double sum = 0;
+  for (const float p : points)
+    sum += p;
+  deallog << "Number of coordinates: " << points.size()
+          << ", sum of coordinates: " << sum << std::endl;
+}
+
+int
+main()
+{
+  initlog();
+
+  check(DataOutBase::VtkFlags::best_speed);
+  check(DataOutBase::VtkFlags::best_compression);
+}
@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test RepartitioningPolicyTools::GraphPartitioningPolicy and
+// RepartitioningPolicyTools::compute_n_ghost_cells(): starting from a
+// partition along a space-filling curve with ragged subdomains, the graph
+// partitioner should create subdomains with fewer ghost cells, also if the
+// graph is coarsened by combining several cells into one vertex.
+
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+#include <deal.II/distributed/repartitioning_policy_tools.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include "tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+print_ghost_cells(const Triangulation<dim> &                        tria,
+                  const LinearAlgebra::distributed::Vector<double> &partition)
+{
+  deallog << "n_ghost_cells:";
+  for (const unsigned int n :
+       RepartitioningPolicyTools::compute_n_ghost_cells(tria, partition))
+    deallog << ' ' << n;
+  deallog << std::endl;
+}
+
+template <int dim>
+void
+print_cell_counts(const Triangulation<dim> &tria)
+{
+  unsigned int n_locally_owned_cells = 0, n_ghost_cells = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      ++n_locally_owned_cells;
+    else if (cell->is_ghost())
+      ++n_ghost_cells;
+
+  deallog << "n_locally_owned_active_cells: " << n_locally_owned_cells
+          << std::endl;
+  deallog << "n_ghost_active_cells:         " << n_ghost_cells << std::endl;
+}
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const unsigned int dim  = 2;
+  const MPI_Comm     comm = MPI_COMM_WORLD;
+
+  // partition a uniformly refined square along the z-order curve, which
+  // leads to subdomains with ragged boundaries for three processes
+  Triangulation<dim> basetria;
+  GridGenerator::hyper_cube(basetria);
+  basetria.refine_global(4);
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm));
+
+  // current partition
+  {
+    deallog.push("default");
+    print_ghost_cells(tria, LinearAlgebra::distributed::Vector<double>());
+    print_cell_counts(tria);
+    deallog.pop();
+  }
+
+  // partition with the built-in graph partitioner
+  {
+    const auto partition_new =
+      RepartitioningPolicyTools::GraphPartitioningPolicy<dim>().partition(
+        tria);
+
+    parallel::fullydistributed::Triangulation<dim> tria_pft(comm);
+    tria_pft.create_triangulation(
+      TriangulationDescription::Utilities::
+        create_description_from_triangulation(tria, partition_new));
+
+    deallog.push("graph");
+    print_ghost_cells(tria, partition_new);
+    print_cell_counts(tria_pft);
+    deallog.pop();
+  }
+
+  // partition the graph of groups of up to four cells
+  {
+    const auto partition_new =
+      RepartitioningPolicyTools::GraphPartitioningPolicy<dim>(
+        SparsityTools::Partitioner::multilevel, 4)
+        .partition(tria);
+
+    parallel::fullydistributed::Triangulation<dim> tria_pft(comm);
+    tria_pft.create_triangulation(
+      TriangulationDescription::Utilities::
+        create_description_from_triangulation(tria, partition_new));
+
+    deallog.push("coarsened graph");
+    print_ghost_cells(tria, partition_new);
+    print_cell_counts(tria_pft);
+    deallog.pop();
+  }
+}
@@ -0,0 +1,199 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test differential checkpoints of cell-attached data with
+// fullydistributed::Triangulation::save()/load(): save a base checkpoint,
+// change the data on a part of the cells, save a differential checkpoint,
+// and check that the data loaded from both checkpoints is correct, that
+// the differential checkpoint only contains the changed chunks, and that
+// loading a differential checkpoint fails once its base checkpoint has been
+// overwritten.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <cstring>
+
+#include "./tests.h"
+
+using namespace dealii;
+
+
+// the data attached to each cell: a number of values depending on the
+// position of the cell, which change in the left part of the domain at time
+// 1
+const unsigned int n_values = 32;
+
+template <int dim>
+std::vector<double>
+cell_values(const Point<dim> &center, const unsigned int time)
+{
+  std::vector<double> values(n_values);
+  for (unsigned int i = 0; i < n_values; ++i)
+    values[i] = center[0] + 10. * center[dim - 1] + i +
+                ((center[0] < 0.25) ? 100. * time : 0.);
+  return values;
+}
+
+
+
+std::size_t
+file_size(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  return file ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
+
+
+template <int dim>
+void
+save(parallel::fullydistributed::Triangulation<dim> &tria,
+     const std::string &                             filename,
+     const unsigned int                              time)
+{
+  tria.register_data_attach(
+    [time](const typename Triangulation<dim>::cell_iterator &cell,
+           const typename Triangulation<dim>::CellStatus) {
+      const std::vector<double> values = cell_values(cell->center(), time);
+      std::vector<char>         buffer(values.size() * sizeof(double));
+      std::memcpy(buffer.data(), values.data(), buffer.size());
+      return buffer;
+    },
+    /*returns_variable_size_data=*/false);
+
+  tria.save(filename);
+}
+
+
+
+template <int dim>
+void
+load(const std::string &filename, const unsigned int time, MPI_Comm comm)
+{
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.load(filename);
+
+  // the handle of the first fixed size data set, see register_data_attach()
+  const unsigned int handle = 1;
+
+  bool data_matches = true;
+  tria.notify_ready_to_unpack(
+    handle,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const typename Triangulation<dim>::CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      const std::vector<double> values = cell_values(cell->center(), time);
+      data_matches &=
+        (static_cast<std::size_t>(data_range.end() - data_range.begin()) ==
+           values.size() * sizeof(double) &&
+         std::memcmp(&*data_range.begin(),
+                     values.data(),
+                     values.size() * sizeof(double)) == 0);
+    });
+
+  deallog << "load " << filename << ": " << tria.n_global_active_cells()
+          << " cells, data matches: " << data_matches << std::endl;
+}
+
+
+
+template <int dim>
+void
+test(MPI_Comm comm)
+{
+  Triangulation<dim> basetria;
+  GridGenerator::hyper_cube(basetria);
+  basetria.refine_global(4);
+
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  const auto description =
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm);
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(description);
+  tria.set_differential_checkpoints(true, 1024);
+
+  const std::string stem = "save_load_02_" + std::to_string(dim) + "d_";
+
+  // the first checkpoint becomes the base checkpoint, the second one only
+  // contains the chunks with cells in the left part of the domain, and the
+  // third one none at all
+  save(tria, stem + "base", 0);
+  save(tria, stem + "delta_1", 1);
+  save(tria, stem + "delta_2", 0);
+
+  for (const std::string name : {"base", "delta_1", "delta_2"})
+    deallog << name << ": " << file_size(stem + name + "_fixed.data")
+            << " bytes full, " << file_size(stem + name + "_fixed.delta")
+            << " bytes differential" << std::endl;
+
+  load<dim>(stem + "base", 0, comm);
+  load<dim>(stem + "delta_1", 1, comm);
+  load<dim>(stem + "delta_2", 0, comm);
+
+  // after disabling differential checkpoints, a complete checkpoint is
+  // written again and replaces the differential one
+  tria.set_differential_checkpoints(false);
+  save(tria, stem + "delta_1", 1);
+  deallog << "delta_1: " << file_size(stem + "delta_1_fixed.data")
+          << " bytes full, " << file_size(stem + "delta_1_fixed.delta")
+          << " bytes differential" << std::endl;
+  load<dim>(stem + "delta_1", 1, comm);
+
+  // overwriting the base checkpoint with different data invalidates the
+  // differential checkpoint that refers to it
+  save(tria, stem + "base", 1);
+  try
+    {
+      load<dim>(stem + "delta_2", 0, comm);
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "load " << stem << "delta_2 after overwriting the base "
+              << "checkpoint: exception" << std::endl;
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  deallog.push("2d");
+  test<2>(comm);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(comm);
+  deallog.pop();
+}
@@ -0,0 +1,178 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test that fixed-size and variable-size data attached to the cells of a
+// fullydistributed::Triangulation survive a save()/load() cycle on several
+// processes, where every process writes and reads its part of the files
+// with collective MPI-IO calls.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <cstring>
+
+#include "./tests.h"
+
+using namespace dealii;
+
+
+// the data attached to each cell: a fixed number of values depending on
+// the position of the cell, and a number of values that also varies with
+// the position of the cell (including cells without any values)
+template <int dim>
+std::vector<double>
+fixed_size_values(const Point<dim> &center)
+{
+  std::vector<double> values(4);
+  for (unsigned int i = 0; i < values.size(); ++i)
+    values[i] = center[0] + 10. * center[dim - 1] + i;
+  return values;
+}
+
+
+
+template <int dim>
+std::vector<double>
+variable_size_values(const Point<dim> &center)
+{
+  const unsigned int  n_values = static_cast<unsigned int>(16 * center[0]) % 5;
+  std::vector<double> values(n_values);
+  for (unsigned int i = 0; i < n_values; ++i)
+    values[i] = -center[dim - 1] - 100. * i;
+  return values;
+}
+
+
+
+std::vector<char>
+to_buffer(const std::vector<double> &values)
+{
+  std::vector<char> buffer(values.size() * sizeof(double));
+  if (values.size() > 0)
+    std::memcpy(buffer.data(), values.data(), buffer.size());
+  return buffer;
+}
+
+
+
+bool
+matches(const boost::iterator_range<std::vector<char>::const_iterator> &range,
+        const std::vector<double> &                                     values)
+{
+  const std::size_t size = range.end() - range.begin();
+  return size == values.size() * sizeof(double) &&
+         (size == 0 ||
+          std::memcmp(&*range.begin(), values.data(), size) == 0);
+}
+
+
+
+template <int dim>
+void
+test(MPI_Comm comm)
+{
+  Triangulation<dim> basetria;
+  GridGenerator::hyper_cube(basetria);
+  basetria.refine_global(4);
+
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  const auto description =
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm);
+
+  const std::string filename = "save_load_03_" + std::to_string(dim) + "d";
+
+  unsigned int handle_fixed, handle_variable;
+  {
+    parallel::fullydistributed::Triangulation<dim> tria(comm);
+    tria.create_triangulation(description);
+
+    handle_fixed = tria.register_data_attach(
+      [](const typename Triangulation<dim>::cell_iterator &cell,
+         const typename Triangulation<dim>::CellStatus) {
+        return to_buffer(fixed_size_values(cell->center()));
+      },
+      /*returns_variable_size_data=*/false);
+    handle_variable = tria.register_data_attach(
+      [](const typename Triangulation<dim>::cell_iterator &cell,
+         const typename Triangulation<dim>::CellStatus) {
+        return to_buffer(variable_size_values(cell->center()));
+      },
+      /*returns_variable_size_data=*/true);
+
+    tria.save(filename);
+
+    deallog << "saved " << tria.n_locally_owned_active_cells() << " of "
+            << tria.n_global_active_cells() << " cells" << std::endl;
+  }
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.load(filename);
+
+  unsigned int n_cells          = 0;
+  bool         fixed_matches    = true;
+  bool         variable_matches = true;
+  tria.notify_ready_to_unpack(
+    handle_fixed,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const typename Triangulation<dim>::CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      ++n_cells;
+      fixed_matches &= matches(data_range, fixed_size_values(cell->center()));
+    });
+  tria.notify_ready_to_unpack(
+    handle_variable,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const typename Triangulation<dim>::CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      variable_matches &=
+        matches(data_range, variable_size_values(cell->center()));
+    });
+
+  deallog << "loaded " << n_cells << " of " << tria.n_global_active_cells()
+          << " cells, fixed size data matches: " << fixed_matches
+          << ", variable size data matches: " << variable_matches
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  deallog.push("2d");
+  test<2>(comm);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(comm);
+  deallog.pop();
+}
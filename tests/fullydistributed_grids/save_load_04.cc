@@ -0,0 +1,178 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test that a differential checkpoint refers to its base checkpoint
+// relative to its own directory: write a base checkpoint and differential
+// checkpoints in the same and in a different directory, then change the
+// working directory and check that the differential checkpoints can still
+// be loaded.
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "./tests.h"
+
+using namespace dealii;
+
+
+// the data attached to each cell, which changes in the left part of the
+// domain at time 1
+const unsigned int n_values = 32;
+
+template <int dim>
+std::vector<double>
+cell_values(const Point<dim> &center, const unsigned int time)
+{
+  std::vector<double> values(n_values);
+  for (unsigned int i = 0; i < n_values; ++i)
+    values[i] = center[0] + 10. * center[dim - 1] + i +
+                ((center[0] < 0.25) ? 100. * time : 0.);
+  return values;
+}
+
+
+
+std::size_t
+file_size(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  return file ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
+
+
+template <int dim>
+void
+save(parallel::fullydistributed::Triangulation<dim> &tria,
+     const std::string &                             filename,
+     const unsigned int                              time)
+{
+  tria.register_data_attach(
+    [time](const typename Triangulation<dim>::cell_iterator &cell,
+           const typename Triangulation<dim>::CellStatus) {
+      const std::vector<double> values = cell_values(cell->center(), time);
+      std::vector<char>         buffer(values.size() * sizeof(double));
+      std::memcpy(buffer.data(), values.data(), buffer.size());
+      return buffer;
+    },
+    /*returns_variable_size_data=*/false);
+
+  tria.save(filename);
+}
+
+
+
+template <int dim>
+void
+load(const std::string &filename, const unsigned int time, MPI_Comm comm)
+{
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.load(filename);
+
+  // the handle of the first fixed size data set, see register_data_attach()
+  const unsigned int handle = 1;
+
+  bool data_matches = true;
+  tria.notify_ready_to_unpack(
+    handle,
+    [&](const typename Triangulation<dim>::cell_iterator &cell,
+        const typename Triangulation<dim>::CellStatus,
+        const boost::iterator_range<std::vector<char>::const_iterator>
+          &data_range) {
+      const std::vector<double> values = cell_values(cell->center(), time);
+      data_matches &=
+        (static_cast<std::size_t>(data_range.end() - data_range.begin()) ==
+           values.size() * sizeof(double) &&
+         std::memcmp(&*data_range.begin(),
+                     values.data(),
+                     values.size() * sizeof(double)) == 0);
+    });
+
+  deallog << "load " << filename << ": " << tria.n_global_active_cells()
+          << " cells, data matches: " << data_matches << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm     comm = MPI_COMM_WORLD;
+  const unsigned int dim  = 2;
+
+  Triangulation<dim> basetria;
+  GridGenerator::hyper_cube(basetria);
+  basetria.refine_global(4);
+
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  const auto description =
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm);
+
+  parallel::fullydistributed::Triangulation<dim> tria(comm);
+  tria.create_triangulation(description);
+  tria.set_differential_checkpoints(true, 1024);
+
+  // the directories may exist from a previous run of this test
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    {
+      mkdir("save_load_04", 0755);
+      mkdir("save_load_04/sub", 0755);
+    }
+  MPI_Barrier(comm);
+
+  save(tria, "save_load_04/base", 0);
+  save(tria, "save_load_04/delta_1", 1);
+  save(tria, "save_load_04/sub/delta_2", 1);
+
+  for (const std::string name : {"base", "delta_1", "sub/delta_2"})
+    deallog << name << ": "
+            << file_size("save_load_04/" + name + "_fixed.data")
+            << " bytes full, "
+            << file_size("save_load_04/" + name + "_fixed.delta")
+            << " bytes differential" << std::endl;
+
+  // the names of the base checkpoint stored in the differential checkpoints
+  // are relative to their directories, so they remain valid after changing
+  // the working directory
+  int ierr = chdir("save_load_04");
+  AssertThrow(ierr == 0, ExcIO());
+
+  load<dim>("base", 0, comm);
+  load<dim>("delta_1", 1, comm);
+  load<dim>("sub/delta_2", 1, comm);
+
+  // go back, where the log files of the processes are written
+  ierr = chdir("..");
+  AssertThrow(ierr == 0, ExcIO());
+}
@@ -0,0 +1,131 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Time the adaptive refinement of a 3D shell with a spherical manifold on
+// one and on several threads, and check that both produce the same
+// vertices. The test only runs in release mode, where the timings are
+// meaningful. Run this manually to see the timings on std output and see
+// below for settings to change.
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+// number of global refinements before the adaptive cycles:
+const unsigned int n_global_refinements = 1;
+// number of adaptive refinement cycles:
+const unsigned int n_cycles = 3;
+// how many times to run each benchmark before averaging
+const unsigned int n_runs = 1;
+// maximum number of threads to test (to speed up testing)
+const unsigned int n_max_threads = 4;
+
+
+
+// Refine a shell adaptively towards a point on its outer surface and
+// return the time spent in execute_coarsening_and_refinement() along with
+// the final vertices.
+template <int dim>
+std::pair<double, std::vector<Point<dim>>>
+refine_adaptively()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.refine_global(n_global_refinements);
+
+  Point<dim> target;
+  target[0] = 1.;
+
+  double time = 0.;
+  for (unsigned int cycle = 0; cycle < n_cycles; ++cycle)
+    {
+      // refine the half of the cells closest to the target
+      std::vector<double> distances;
+      for (const auto &cell : tria.active_cell_iterators())
+        distances.push_back(cell->center().distance(target));
+      std::vector<double> sorted_distances = distances;
+      std::nth_element(sorted_distances.begin(),
+                       sorted_distances.begin() + distances.size() / 2,
+                       sorted_distances.end());
+      const double threshold = sorted_distances[distances.size() / 2];
+
+      unsigned int index = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (distances[index++] < threshold)
+          cell->set_refine_flag();
+
+      Timer timer;
+      tria.execute_coarsening_and_refinement();
+      time += timer.wall_time();
+    }
+
+  return {time, tria.get_vertices()};
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  MultithreadInfo::set_thread_limit(1);
+  double                  serial_time = 0.;
+  std::vector<Point<dim>> serial_vertices;
+  for (unsigned int run = 0; run < n_runs; ++run)
+    {
+      const auto result = refine_adaptively<dim>();
+      serial_time += result.first / n_runs;
+      serial_vertices = result.second;
+    }
+  std::cout << "threads: 1 time: " << serial_time << std::endl;
+
+  bool same_vertices = true;
+  for (unsigned int n_threads = 2; n_threads <= n_max_threads; ++n_threads)
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      double time = 0.;
+      for (unsigned int run = 0; run < n_runs; ++run)
+        {
+          const auto result = refine_adaptively<dim>();
+          time += result.first / n_runs;
+          same_vertices &= (result.second == serial_vertices);
+        }
+      std::cout << "threads: " << n_threads << " time: " << time
+                << " speedup: " << serial_time / time << std::endl;
+    }
+
+  deallog << dim << "d: " << serial_vertices.size()
+          << " vertices, same vertices on all thread counts: "
+          << same_vertices << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<3>();
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+}
@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the neighbor information, which is stored as separate arrays of
+// indices and levels, on adaptively refined meshes, including neighbors on
+// much coarser levels in 1d. Check the breakdown of the memory consumption
+// of the triangulation by field and compare the neighbor storage with the
+// previous layout of one std::pair<int,int> per face.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <map>
+#include <sstream>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test(const unsigned int n_cycles)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  // repeatedly refine the cell with its last vertex at the center of the
+  // domain
+  Point<dim> center;
+  for (unsigned int d = 0; d < dim; ++d)
+    center[d] = 0.5;
+  for (unsigned int cycle = 0; cycle < n_cycles; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->vertex(GeometryInfo<dim>::vertices_per_cell - 1)
+              .distance(center) < 1e-12)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  unsigned int n_neighbors     = 0;
+  int          max_level_jump  = 0;
+  bool         neighbors_match = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (cell->at_boundary(f))
+        neighbors_match &=
+          (cell->neighbor_index(f) == -1 && cell->neighbor_level(f) == -1);
+      else
+        {
+          ++n_neighbors;
+          const auto neighbor = cell->neighbor(f);
+          neighbors_match &= (neighbor->level() == cell->neighbor_level(f) &&
+                              neighbor->index() == cell->neighbor_index(f));
+          max_level_jump =
+            std::max(max_level_jump, cell->level() - neighbor->level());
+          if (neighbor->is_active() && neighbor->level() == cell->level())
+            neighbors_match &=
+              (neighbor->neighbor(cell->neighbor_of_neighbor(f)) == cell);
+        }
+
+  deallog << dim << "d: " << tria.n_levels() << " levels, "
+          << tria.n_active_cells() << " active cells, " << n_neighbors
+          << " neighbors, largest level difference " << max_level_jump
+          << ", neighbors match: " << neighbors_match << std::endl;
+
+  // the printed sizes depend on the standard library and the configuration,
+  // so only list the fields, check that they add up to the total, and
+  // compare the neighbor storage with a std::vector<std::pair<int,int>> of
+  // the same capacity
+  std::stringstream stream;
+  tria.print_memory_consumption(stream);
+  std::string line;
+  std::getline(stream, line);
+  std::map<std::string, std::size_t> fields;
+  std::size_t                        sum = 0;
+  std::string                        name;
+  std::size_t                        bytes;
+  while (stream >> name >> bytes)
+    {
+      fields[name] = bytes;
+      if (name != "total")
+        {
+          deallog << name << ' ';
+          sum += bytes;
+        }
+    }
+  deallog << std::endl;
+  deallog << "Fields add up to the total: " << (sum == fields["total"])
+          << std::endl;
+
+  const std::size_t vector_headers =
+    tria.n_levels() * sizeof(std::vector<int>);
+  const std::size_t index_bytes = fields["neighbor_indices"] - vector_headers;
+  const std::size_t level_bytes = fields["neighbor_levels"] - vector_headers;
+  deallog << "Neighbor storage relative to pairs of int: "
+          << static_cast<double>(index_bytes + level_bytes) /
+               (index_bytes / sizeof(int) * sizeof(std::pair<int, int>))
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1>(40);
+  test<2>(4);
+  test<3>(3);
+}
@@ -0,0 +1,235 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test GridTools::partition_triangulation with
+// SparsityTools::Partitioner::multilevel: print the weight of each partition
+// and the number of faces between cells of different partitions, with and
+// without cell weights, for a mesh whose cells form two disconnected
+// components, and for more than two partitions. The weight of each partition
+// must exceed the average by at most 3%, and the edge cut must be within 10% of
+// the one of the partition along the z-order curve, also if the cells are
+// passed to the partitioner in random order.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include "../tests.h"
+
+
+// return the number of faces between cells with different subdomain ids
+template <int dim>
+unsigned int
+count_edge_cut(const Triangulation<dim> &tria)
+{
+  unsigned int edge_cut = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (const unsigned int f : cell->face_indices())
+      if (!cell->at_boundary(f) &&
+          cell->neighbor(f)->active_cell_index() > cell->active_cell_index() &&
+          cell->neighbor(f)->subdomain_id() != cell->subdomain_id())
+        ++edge_cut;
+  return edge_cut;
+}
+
+
+
+// print the weights of the partitions stored in the subdomain ids of the
+// cells, and check that the partition is balanced and does not cut more than
+// 10% more faces than the z-order partition, which is close to optimal on the
+// small uniform meshes of this test
+template <int dim>
+void
+check_partition(const Triangulation<dim> &       tria,
+                const std::vector<unsigned int> &cell_weights,
+                const unsigned int               n_partitions,
+                const unsigned int               edge_cut_zorder)
+{
+  std::vector<unsigned int> partition_weights(n_partitions);
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      AssertThrow(cell->subdomain_id() < n_partitions, ExcInternalError());
+      partition_weights[cell->subdomain_id()] +=
+        cell_weights.empty() ? 1 : cell_weights[cell->active_cell_index()];
+    }
+
+  const unsigned int total_weight =
+    std::accumulate(partition_weights.begin(), partition_weights.end(), 0U);
+  const unsigned int max_weight =
+    *std::max_element(partition_weights.begin(), partition_weights.end());
+
+  deallog << "Partition weights:";
+  for (const unsigned int weight : partition_weights)
+    deallog << ' ' << weight;
+  deallog << std::endl;
+  deallog << "Imbalance within 3%: "
+          << (max_weight * n_partitions <= 1.03 * total_weight) << std::endl;
+
+  const unsigned int edge_cut = count_edge_cut(tria);
+  AssertThrow(edge_cut <= 1.1 * edge_cut_zorder,
+              ExcMessage("The edge cut exceeds the one of the z-order "
+                         "partition by more than 10%."));
+  deallog << "Edge cut: " << edge_cut << std::endl;
+}
+
+
+
+template <int dim>
+void
+partition_and_print(Triangulation<dim> &             tria,
+                    const std::vector<unsigned int> &cell_weights,
+                    const unsigned int               n_partitions)
+{
+  // do not group siblings in the z-order partition, which would make its
+  // parts differ in size by up to a whole family of cells
+  GridTools::partition_triangulation_zorder(n_partitions, tria, false);
+  const unsigned int edge_cut_zorder = count_edge_cut(tria);
+
+  GridTools::partition_triangulation(n_partitions,
+                                     cell_weights,
+                                     tria,
+                                     SparsityTools::Partitioner::multilevel);
+  check_partition(tria, cell_weights, n_partitions, edge_cut_zorder);
+
+  // the active cells are numbered along the z-order curve, so partition the
+  // graph of the cells again with the cells numbered in random order to make
+  // sure that the partitioner does not profit from that numbering
+  const unsigned int n_cells = tria.n_active_cells();
+  std::vector<unsigned int> permutation(n_cells);
+  std::iota(permutation.begin(), permutation.end(), 0U);
+  for (unsigned int i = n_cells - 1; i > 0; --i)
+    std::swap(permutation[i], permutation[Testing::rand() % (i + 1)]);
+
+  DynamicSparsityPattern connectivity;
+  GridTools::get_face_connectivity_of_cells(tria, connectivity);
+  DynamicSparsityPattern shuffled_connectivity(n_cells);
+  for (unsigned int i = 0; i < n_cells; ++i)
+    for (auto entry = connectivity.begin(i); entry != connectivity.end(i);
+         ++entry)
+      shuffled_connectivity.add(permutation[i], permutation[entry->column()]);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(shuffled_connectivity);
+
+  std::vector<unsigned int> shuffled_weights(cell_weights.size());
+  for (unsigned int i = 0; i < cell_weights.size(); ++i)
+    shuffled_weights[permutation[i]] = cell_weights[i];
+
+  std::vector<unsigned int> partition_indices(n_cells);
+  SparsityTools::partition(sparsity_pattern,
+                           shuffled_weights,
+                           n_partitions,
+                           partition_indices,
+                           SparsityTools::Partitioner::multilevel);
+  for (const auto &cell : tria.active_cell_iterators())
+    cell->set_subdomain_id(
+      partition_indices[permutation[cell->active_cell_index()]]);
+
+  deallog.push("shuffled");
+  check_partition(tria, cell_weights, n_partitions, edge_cut_zorder);
+  deallog.pop();
+}
+
+
+
+template <int dim>
+void
+test_uniform(const unsigned int n_refinements, const unsigned int n_partitions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  partition_and_print(tria, {}, n_partitions);
+}
+
+
+
+template <int dim>
+void
+test_weighted(const unsigned int n_refinements,
+              const unsigned int n_partitions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  // cells in the left half of the domain are four times as expensive
+  std::vector<unsigned int> cell_weights(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_weights[cell->active_cell_index()] = cell->center()[0] < 0.5 ? 4 : 1;
+
+  partition_and_print(tria, cell_weights, n_partitions);
+}
+
+
+
+template <int dim>
+void
+test_disconnected(const unsigned int n_refinements,
+                  const unsigned int n_partitions)
+{
+  // two cubes that do not touch, the second one with twice as many cells
+  Triangulation<dim> left, right, tria;
+  GridGenerator::hyper_cube(left, 0., 1.);
+  std::vector<unsigned int> repetitions(dim, 1);
+  repetitions[0] = 2;
+  Point<dim> p1, p2;
+  p1[0] = 2.;
+  for (unsigned int d = 0; d < dim; ++d)
+    p2[d] = 1.;
+  p2[0] = 4.;
+  GridGenerator::subdivided_hyper_rectangle(right, repetitions, p1, p2);
+  GridGenerator::merge_triangulations(left, right, tria);
+  tria.refine_global(n_refinements);
+
+  partition_and_print(tria, {}, n_partitions);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d uniform");
+  test_uniform<2>(4, 5);
+  deallog.pop();
+
+  deallog.push("3d uniform");
+  test_uniform<3>(3, 3);
+  deallog.pop();
+
+  deallog.push("2d weighted");
+  test_weighted<2>(4, 3);
+  deallog.pop();
+
+  deallog.push("3d weighted");
+  test_weighted<3>(2, 4);
+  deallog.pop();
+
+  deallog.push("2d disconnected");
+  test_disconnected<2>(3, 4);
+  deallog.pop();
+
+  deallog.push("3d disconnected");
+  test_disconnected<3>(1, 3);
+  deallog.pop();
+}
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// The vertices created during isotropic refinement are placed on the
+// manifold after the new cells have been set up, for all objects of one
+// dimension at once. Check on adaptively refined curved meshes that every
+// new vertex is at the center of its parent object as computed by the
+// accessors, and that post_refinement_on_cell is triggered once for every
+// refined cell.
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.refine_global(1);
+
+  unsigned int n_signals = 0;
+  tria.signals.post_refinement_on_cell.connect(
+    [&](const typename Triangulation<dim>::cell_iterator &cell) {
+      Assert(cell->has_children(), ExcInternalError());
+      ++n_signals;
+    });
+
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      unsigned int n_flagged = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] > 0. && cell->center()[1] > 0.)
+          {
+            cell->set_refine_flag();
+            ++n_flagged;
+          }
+      n_signals = 0;
+      tria.execute_coarsening_and_refinement();
+
+      double max_distance = 0.;
+      for (const auto &cell : tria.cell_iterators())
+        {
+          for (const unsigned int l : cell->line_indices())
+            if (cell->line(l)->has_children())
+              max_distance =
+                std::max(max_distance,
+                         cell->line(l)->child(0)->vertex(1).distance(
+                           cell->line(l)->center(true)));
+          if (dim == 3)
+            for (const unsigned int f : cell->face_indices())
+              if (cell->face(f)->has_children())
+                max_distance =
+                  std::max(max_distance,
+                           cell->face(f)->child(0)->vertex(3).distance(
+                             cell->face(f)->center(true, true)));
+          if (cell->has_children())
+            max_distance = std::max(
+              max_distance,
+              cell->child(0)
+                ->vertex(GeometryInfo<dim>::vertices_per_cell - 1)
+                .distance(cell->center(true, true)));
+        }
+
+      deallog << dim << "d cycle " << cycle << ": " << n_flagged
+              << " cells refined, " << n_signals << " signals, "
+              << tria.n_active_cells() << " active cells, "
+              << tria.n_used_vertices()
+              << " vertices, max distance to centers: " << max_distance
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
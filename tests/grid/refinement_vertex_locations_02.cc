@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Refine a 3D shell with a spherical manifold adaptively on one and on
+// several threads, and check that the vertices placed in parallel during
+// refinement are the same in both cases.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+// Refine a shell adaptively towards a point on its outer surface and
+// return the final vertices.
+template <int dim>
+std::vector<Point<dim>>
+refine_adaptively()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.refine_global(1);
+
+  Point<dim> target;
+  target[0] = 1.;
+
+  for (unsigned int cycle = 0; cycle < 3; ++cycle)
+    {
+      // refine the half of the cells closest to the target
+      std::vector<double> distances;
+      for (const auto &cell : tria.active_cell_iterators())
+        distances.push_back(cell->center().distance(target));
+      std::vector<double> sorted_distances = distances;
+      std::nth_element(sorted_distances.begin(),
+                       sorted_distances.begin() + distances.size() / 2,
+                       sorted_distances.end());
+      const double threshold = sorted_distances[distances.size() / 2];
+
+      unsigned int index = 0;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (distances[index++] < threshold)
+          cell->set_refine_flag();
+
+      tria.execute_coarsening_and_refinement();
+    }
+
+  return tria.get_vertices();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  MultithreadInfo::set_thread_limit(1);
+  const std::vector<Point<dim>> serial_vertices = refine_adaptively<dim>();
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  const std::vector<Point<dim>> parallel_vertices = refine_adaptively<dim>();
+
+  deallog << dim << "d: " << serial_vertices.size()
+          << " vertices, same vertices on several threads: "
+          << (parallel_vertices == serial_vertices) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<3>();
+}
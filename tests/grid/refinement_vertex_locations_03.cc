@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// A manifold that returns false from supports_concurrent_calls() must not
+// be called from several threads at once during refinement. Check this
+// with a manifold that counts how many of its calls are active at the same
+// time, and check that the vertices are the same as with the manifold it
+// is derived from.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <atomic>
+
+#include "../tests.h"
+
+
+// the triangulation stores a clone of the manifold, so keep the counters
+// outside of the class
+std::atomic<unsigned int> n_calls(0);
+std::atomic<unsigned int> n_active_calls(0);
+std::atomic<unsigned int> max_active_calls(0);
+
+
+
+template <int dim>
+class SerialSphericalManifold : public SphericalManifold<dim>
+{
+public:
+  virtual std::unique_ptr<Manifold<dim>>
+  clone() const override
+  {
+    return std::make_unique<SerialSphericalManifold<dim>>();
+  }
+
+  virtual bool
+  supports_concurrent_calls() const override
+  {
+    return false;
+  }
+
+  virtual Point<dim>
+  get_new_point(const ArrayView<const Point<dim>> &vertices,
+                const ArrayView<const double> &   weights) const override
+  {
+    ++n_calls;
+    const unsigned int n_active = ++n_active_calls;
+    unsigned int       max_active = max_active_calls;
+    while (n_active > max_active &&
+           !max_active_calls.compare_exchange_weak(max_active, n_active))
+      ;
+
+    const Point<dim> p =
+      SphericalManifold<dim>::get_new_point(vertices, weights);
+
+    --n_active_calls;
+    return p;
+  }
+};
+
+
+
+template <int dim>
+std::vector<Point<dim>>
+refine(const Manifold<dim> &manifold)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_manifold(0, manifold);
+  tria.refine_global(3);
+
+  return tria.get_vertices();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const std::vector<Point<dim>> vertices =
+    refine<dim>(SphericalManifold<dim>());
+
+  n_calls          = 0;
+  max_active_calls = 0;
+  const std::vector<Point<dim>> serial_vertices =
+    refine<dim>(SerialSphericalManifold<dim>());
+
+  deallog << dim << "d: manifold called: " << (n_calls > 0)
+          << ", maximal number of concurrent calls: " << max_active_calls
+          << ", same vertices: " << (serial_vertices == vertices)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+
+  test<2>();
+  test<3>();
+}
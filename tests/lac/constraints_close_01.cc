@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check AffineConstraints::close() and merge() on a set of constraints large
+// enough to be split into several tasks, with chains of constraints, zero
+// weights and duplicate entries after resolution, against a direct
+// expansion of the constraints
+
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+// the raw constraints: x_i = 1/2 x_{i+1} + 1/2 x_{i+3} + 0 x_{i+2} + 1 for
+// i divisible by 3, where chains of up to four constraints are formed
+const unsigned int n_dofs = 6000;
+
+bool
+is_raw_constrained(const unsigned int i)
+{
+  return i % 3 == 0 && i + 3 < n_dofs;
+}
+
+std::vector<std::pair<unsigned int, double>>
+raw_entries(const unsigned int i)
+{
+  std::vector<std::pair<unsigned int, double>> entries;
+  entries.emplace_back(i + 1, 0.5);
+  entries.emplace_back(i + 2, 0.);
+  if ((i / 3) % 4 != 3)
+    entries.emplace_back(i + 3, 0.5);
+  else
+    // refer back to a dof of the previous line, which creates duplicates in
+    // the resolution of the previous line
+    entries.emplace_back(i - 2, 0.5);
+  return entries;
+}
+
+// expand the constraint of dof i recursively into a map of unconstrained
+// dofs
+void
+expand(const unsigned int            i,
+       const double                  weight,
+       std::map<unsigned int, double> &expansion,
+       double &                      inhomogeneity)
+{
+  inhomogeneity += weight;
+  for (const auto &entry : raw_entries(i))
+    if (entry.second == 0.)
+      continue;
+    else if (is_raw_constrained(entry.first))
+      expand(entry.first, weight * entry.second, expansion, inhomogeneity);
+    else
+      expansion[entry.first] += weight * entry.second;
+}
+
+
+
+void
+test()
+{
+  AffineConstraints<double> constraints;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    if (is_raw_constrained(i))
+      {
+        constraints.add_line(i);
+        for (const auto &entry : raw_entries(i))
+          constraints.add_entry(i, entry.first, entry.second);
+        constraints.set_inhomogeneity(i, 1.);
+      }
+  constraints.close();
+
+  deallog << "Number of constraints: " << constraints.n_constraints()
+          << std::endl;
+
+  std::size_t n_entries      = 0;
+  double      max_difference = 0.;
+  bool        has_chain      = false;
+  bool        is_sorted      = true;
+  for (const auto &line : constraints.get_lines())
+    {
+      std::map<unsigned int, double> expansion;
+      double                         inhomogeneity = 0.;
+      expand(line.index, 1., expansion, inhomogeneity);
+
+      n_entries += line.entries.size();
+      if (line.entries.size() != expansion.size())
+        max_difference = std::numeric_limits<double>::max();
+      for (unsigned int j = 0; j < line.entries.size(); ++j)
+        {
+          has_chain |= constraints.is_constrained(line.entries[j].first);
+          if (j > 0)
+            is_sorted &= line.entries[j].first > line.entries[j - 1].first;
+          max_difference =
+            std::max(max_difference,
+                     std::abs(line.entries[j].second -
+                              expansion[line.entries[j].first]));
+        }
+      max_difference =
+        std::max(max_difference, std::abs(line.inhomogeneity - inhomogeneity));
+    }
+  deallog << "Number of entries: " << n_entries << std::endl;
+  deallog << "Entries constrained: " << has_chain << std::endl;
+  deallog << "Entries sorted: " << is_sorted << std::endl;
+  deallog << "Difference to expansion: " << max_difference << std::endl;
+
+  for (unsigned int l = 0; l < 5; ++l)
+    {
+      const auto &line = constraints.get_lines()[l];
+      deallog << "x_" << line.index << " =";
+      for (const auto &entry : line.entries)
+        deallog << " + " << entry.second << " x_" << entry.first;
+      deallog << " + " << line.inhomogeneity << std::endl;
+    }
+
+  // merge with constraints for the dofs that the first lines refer to
+  AffineConstraints<double> other;
+  for (unsigned int i = 1; i < n_dofs; i += 3)
+    {
+      other.add_line(i);
+      other.add_entry(i, i + 1, 1.);
+    }
+  other.close();
+  constraints.merge(other, AffineConstraints<double>::no_conflicts_allowed);
+
+  deallog << "Number of constraints after merge: "
+          << constraints.n_constraints() << std::endl;
+  n_entries = 0;
+  has_chain = false;
+  for (const auto &line : constraints.get_lines())
+    {
+      n_entries += line.entries.size();
+      for (const auto &entry : line.entries)
+        has_chain |= constraints.is_constrained(entry.first);
+    }
+  deallog << "Number of entries after merge: " << n_entries << std::endl;
+  deallog << "Entries constrained after merge: " << has_chain << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test SolverGMRES with classical Gram-Schmidt orthogonalization (CGS2) for
+// dealii::Vector and for LinearAlgebra::distributed::Vector, which uses the
+// blocked inner products, and compare with modified Gram-Schmidt.
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// A non-symmetric tridiagonal matrix from a discretized convection-diffusion
+// problem
+class ConvectionDiffusionOperator
+{
+public:
+  ConvectionDiffusionOperator(const unsigned int size)
+    : size(size)
+  {}
+
+  template <typename VectorType>
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    for (unsigned int i = 0; i < size; ++i)
+      {
+        double sum = 2.5 * src(i);
+        if (i > 0)
+          sum -= 1.4 * src(i - 1);
+        if (i + 1 < size)
+          sum -= 0.6 * src(i + 1);
+        dst(i) = sum;
+      }
+  }
+
+  const unsigned int size;
+};
+
+
+
+template <typename VectorType>
+void
+test(const unsigned int size)
+{
+  using AdditionalData = typename SolverGMRES<VectorType>::AdditionalData;
+
+  ConvectionDiffusionOperator A(size);
+
+  VectorType b(size), x_mgs(size), x_cgs(size);
+  for (unsigned int i = 0; i < size; ++i)
+    b(i) = 1. + std::cos(0.3 * i);
+
+  {
+    SolverControl control(500, 1e-10, false, false);
+    SolverGMRES<VectorType> solver(control, AdditionalData(12));
+    solver.solve(A, x_mgs, b, PreconditionIdentity());
+    deallog << "MGS converged in " << control.last_step() << " steps"
+            << std::endl;
+  }
+
+  {
+    SolverControl           control(500, 1e-10, false, false);
+    SolverGMRES<VectorType> solver(
+      control,
+      AdditionalData(
+        12,
+        false,
+        true,
+        false,
+        AdditionalData::OrthogonalizationStrategy::classical_gram_schmidt));
+    solver.solve(A, x_cgs, b, PreconditionIdentity());
+    deallog << "CGS2 converged in " << control.last_step() << " steps"
+            << std::endl;
+  }
+
+  x_cgs -= x_mgs;
+  deallog << "Difference between MGS and CGS2 solution: "
+          << (x_cgs.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("Vector");
+  test<Vector<double>>(100);
+  deallog.pop();
+
+  deallog.push("distributed::Vector");
+  test<LinearAlgebra::distributed::Vector<double>>(100);
+  test<LinearAlgebra::distributed::Vector<double>>(3000);
+  deallog.pop();
+}
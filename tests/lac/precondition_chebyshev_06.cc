@@ -0,0 +1,154 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test the options of PreconditionChebyshev that shorten the eigenvalue
+// computation: a tolerance on the residual bound of the largest Ritz value,
+// a warm start from the previous estimate, and a guess from another operator
+// with a similar spectrum, which stop the iteration earlier if they are
+// larger than the current Ritz value
+
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+// A Laplace matrix with a slightly varying coefficient plus a mass term
+// with the given shift. The shift changes the spectrum of the Jacobi
+// preconditioned matrix, whose largest eigenvalue is about (4+shift) /
+// (2+shift).
+void
+make_laplace_matrix(const unsigned int    size,
+                    const double          shift,
+                    SparsityPattern &     sparsity,
+                    SparseMatrix<double> &matrix)
+{
+  DynamicSparsityPattern dsp(size, size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      dsp.add(i, i);
+      if (i > 0)
+        dsp.add(i, i - 1);
+      if (i + 1 < size)
+        dsp.add(i, i + 1);
+    }
+  sparsity.copy_from(dsp);
+  matrix.reinit(sparsity);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      const double coefficient = 1. + 0.5 * i / size;
+      matrix.set(i, i, (2. + shift) * coefficient);
+      if (i > 0)
+        matrix.set(i, i - 1, -coefficient);
+      if (i + 1 < size)
+        matrix.set(i, i + 1, -coefficient);
+    }
+}
+
+
+
+void
+print(const std::string &                                 name,
+      const PreconditionChebyshev<>::EigenvalueInformation &info)
+{
+  deallog << name << ": CG iterations " << info.cg_iterations
+          << ", max eigenvalue estimate " << info.max_eigenvalue_estimate
+          << std::endl;
+}
+
+
+
+void
+check()
+{
+  SparsityPattern      sparsity, sparsity_coarse;
+  SparseMatrix<double> matrix, matrix_coarse;
+  make_laplace_matrix(400, 0., sparsity, matrix);
+
+  Vector<double> vector(matrix.m());
+
+  PreconditionChebyshev<>::AdditionalData data;
+  data.smoothing_range     = 20.;
+  data.degree              = 4;
+  data.eig_cg_n_iterations = 40;
+  data.eig_cg_residual     = 1e-12;
+
+  PreconditionChebyshev<> full;
+  full.initialize(matrix, data);
+  const auto info_full = full.estimate_eigenvalues(vector);
+  print("Full iteration", info_full);
+
+  data.eig_cg_relative_tolerance = 1e-2;
+  PreconditionChebyshev<> tolerance;
+  tolerance.initialize(matrix, data);
+  print("Ritz value tolerance", tolerance.estimate_eigenvalues(vector));
+
+  // the Ritz values approach the largest eigenvalue of this matrix quickly,
+  // so a guess larger than the current Ritz value only makes a difference
+  // for a loose tolerance
+  data.eig_cg_relative_tolerance = 6.5e-2;
+
+  // a slowly changing operator: the second estimate starts from the first,
+  // whose largest eigenvalue is slightly larger than the one of the new
+  // operator, and stops earlier than without the previous estimate
+  data.eig_warm_start = true;
+  PreconditionChebyshev<> warm_start;
+  warm_start.initialize(matrix, data);
+  print("Warm start, first", warm_start.estimate_eigenvalues(vector));
+  make_laplace_matrix(400, 0.02, sparsity, matrix);
+  warm_start.initialize(matrix, data);
+  print("Warm start, second", warm_start.estimate_eigenvalues(vector));
+
+  data.eig_warm_start = false;
+  PreconditionChebyshev<> cold_start;
+  cold_start.initialize(matrix, data);
+  print("Cold start, second", cold_start.estimate_eigenvalues(vector));
+
+  // the same operator on a coarser mesh has a similar spectrum
+  data.max_eigenvalue_guess = info_full.max_eigenvalue_estimate;
+  make_laplace_matrix(200, 0., sparsity_coarse, matrix_coarse);
+  Vector<double>          vector_coarse(matrix_coarse.m());
+  PreconditionChebyshev<> guess;
+  guess.initialize(matrix_coarse, data);
+  print("Guess from fine level", guess.estimate_eigenvalues(vector_coarse));
+
+  // a guess that is much too small, e.g. because the spectrum has grown
+  // since the guess was computed, must not stop the iteration early
+  data.max_eigenvalue_guess = 0.5 * info_full.max_eigenvalue_estimate;
+  PreconditionChebyshev<> small_guess;
+  small_guess.initialize(matrix_coarse, data);
+  print("Guess too small", small_guess.estimate_eigenvalues(vector_coarse));
+
+  data.max_eigenvalue_guess = 0.;
+  PreconditionChebyshev<> no_guess;
+  no_guess.initialize(matrix_coarse, data);
+  print("No guess", no_guess.estimate_eigenvalues(vector_coarse));
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  check();
+}
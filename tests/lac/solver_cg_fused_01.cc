@@ -0,0 +1,239 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test SolverCG with an operator that provides a vmult() with operations
+// before and after the matrix-vector product, which makes the solver use the
+// fused vector updates. Compare with the same operator hidden behind the
+// plain vmult() interface. The large case spans many chunks of
+// internal::VectorOperations::parallel_chunked_sum() and is run on one and on
+// several threads, which must give the same result bit by bit.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+// A tridiagonal matrix with entries -1, 2 + c_i, -1 that runs the given
+// operations on blocks of rows, similar to MatrixFree::cell_loop()
+class TridiagonalOperator
+{
+public:
+  TridiagonalOperator(const unsigned int size, const unsigned int block_size)
+    : diagonal(size)
+    , block_size(block_size)
+  {
+    for (unsigned int i = 0; i < size; ++i)
+      diagonal[i] = 2. + 0.1 * i;
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    vmult(dst, src, {}, {});
+  }
+
+  void
+  vmult(VectorType &      dst,
+        const VectorType &src,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_before,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_after) const
+  {
+    const unsigned int size     = diagonal.size();
+    const unsigned int n_blocks = (size + block_size - 1) / block_size;
+
+    const auto block_end = [&](const unsigned int block) {
+      return std::min(size, (block + 1) * block_size);
+    };
+
+    if (operation_before)
+      operation_before(0, block_end(0));
+    for (unsigned int block = 0; block < n_blocks; ++block)
+      {
+        // row i reads src(i+1), so the next block must be prepared first
+        if (operation_before && block + 1 < n_blocks)
+          operation_before(block_end(block), block_end(block + 1));
+
+        for (unsigned int i = block * block_size; i < block_end(block); ++i)
+          {
+            double sum = diagonal[i] * src(i);
+            if (i > 0)
+              sum -= src(i - 1);
+            if (i + 1 < size)
+              sum -= src(i + 1);
+            dst(i) = sum;
+          }
+
+        if (operation_after)
+          operation_after(block * block_size, block_end(block));
+      }
+  }
+
+  std::vector<double> diagonal;
+
+  const unsigned int block_size;
+};
+
+
+// Only provide the plain vmult() interface
+class PlainOperator
+{
+public:
+  PlainOperator(const TridiagonalOperator &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+  const TridiagonalOperator &op;
+};
+
+
+template <typename MatrixType, typename PreconditionerType>
+void
+solve(const MatrixType &        A,
+      const PreconditionerType &preconditioner,
+      VectorType &              x,
+      const VectorType &        b)
+{
+  SolverControl        control(200, 1e-10);
+  SolverCG<VectorType> solver(control);
+
+  x = 0.;
+  solver.solve(A, x, b, preconditioner);
+  deallog << "Converged in " << control.last_step() << " iterations"
+          << std::endl;
+}
+
+
+
+void
+test_small()
+{
+  const unsigned int  size = 50;
+  TridiagonalOperator fused_operator(size, 7);
+  PlainOperator       plain_operator(fused_operator);
+
+  VectorType b(size), x_fused(size), x_plain(size);
+  for (unsigned int i = 0; i < size; ++i)
+    b(i) = 1. + std::sin(static_cast<double>(i));
+
+  {
+    deallog.push("identity");
+    PreconditionIdentity preconditioner;
+    solve(fused_operator, preconditioner, x_fused, b);
+    solve(plain_operator, preconditioner, x_plain, b);
+    x_plain -= x_fused;
+    deallog << "Difference to plain vmult: "
+            << (x_plain.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+            << std::endl;
+    deallog.pop();
+  }
+
+  {
+    deallog.push("diagonal");
+    DiagonalMatrix<VectorType> preconditioner;
+    preconditioner.get_vector().reinit(size);
+    for (unsigned int i = 0; i < size; ++i)
+      preconditioner.get_vector()(i) = 1. / fused_operator.diagonal[i];
+    solve(fused_operator, preconditioner, x_fused, b);
+    solve(plain_operator, preconditioner, x_plain, b);
+    x_plain -= x_fused;
+    deallog << "Difference to plain vmult: "
+            << (x_plain.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+            << std::endl;
+    deallog.pop();
+  }
+}
+
+
+
+// A system large enough that the inner products are computed on several
+// threads, with blocks of rows covering several chunks of fused_dot_chunk_size
+// entries
+void
+test_large()
+{
+  const unsigned int  size = 20000;
+  TridiagonalOperator fused_operator(size, 1000);
+  PlainOperator       plain_operator(fused_operator);
+
+  VectorType b(size), x_serial(size), x_parallel(size), x_plain(size);
+  for (unsigned int i = 0; i < size; ++i)
+    b(i) = 1. + std::sin(static_cast<double>(i));
+
+  DiagonalMatrix<VectorType> preconditioner;
+  preconditioner.get_vector().reinit(size);
+  for (unsigned int i = 0; i < size; ++i)
+    preconditioner.get_vector()(i) = 1. / fused_operator.diagonal[i];
+
+  MultithreadInfo::set_thread_limit(1);
+  solve(fused_operator, preconditioner, x_serial, b);
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+  solve(fused_operator, preconditioner, x_parallel, b);
+
+  bool same_result = true;
+  for (unsigned int i = 0; i < size; ++i)
+    same_result &= (x_serial(i) == x_parallel(i));
+  deallog << "Same result on one and several threads: " << same_result
+          << std::endl;
+
+  solve(plain_operator, preconditioner, x_plain, b);
+  x_plain -= x_parallel;
+  deallog << "Difference to plain vmult: "
+          << (x_plain.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  static_assert(internal::SolverCG::supports_fused_iteration<
+                  VectorType,
+                  TridiagonalOperator,
+                  PreconditionIdentity>::value,
+                "Fused path should be selected");
+  static_assert(!internal::SolverCG::supports_fused_iteration<
+                  VectorType,
+                  PlainOperator,
+                  PreconditionIdentity>::value,
+                "Fused path should not be selected");
+
+  test_small();
+
+  deallog.push("large");
+  test_large();
+  deallog.pop();
+}
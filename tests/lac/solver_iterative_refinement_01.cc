@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test SolverIterativeRefinement and PreconditionMixedPrecision: an exact
+// LU factorization in single precision recovers double precision accuracy
+// in a few steps, an ILU(0) in single precision makes the refinement
+// stagnate, but works as preconditioner for GMRES
+
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_gmres.h>
+#include <deal.II/lac/solver_iterative_refinement.h>
+#include <deal.II/lac/sparse_ilu.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 16;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  SparseMatrix<float> A_float(structure);
+  A_float.copy_from(A);
+
+  Vector<double> rhs(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    rhs(i) = random_value<double>();
+
+  // ILU with full pattern, i.e., an exact LU factorization in float
+  {
+    SparsityPattern lu_pattern(dim, dim, dim);
+    for (unsigned int i = 0; i < dim; ++i)
+      for (unsigned int j = 0; j < dim; ++j)
+        lu_pattern.add(i, j);
+    lu_pattern.compress();
+
+    SparseILU<float>::AdditionalData data;
+    data.use_this_sparsity = &lu_pattern;
+    SparseILU<float> lu;
+    lu.initialize(A_float, data);
+
+    const PreconditionMixedPrecision<SparseILU<float>> inverse(lu);
+
+    SolverControl control(100, 1e-12 * rhs.l2_norm());
+    SolverIterativeRefinement<Vector<double>> solver(control);
+    Vector<double>                            solution(dim);
+    check_solver_within_range(solver.solve(A, solution, rhs, inverse),
+                              control.last_step(),
+                              2,
+                              4);
+
+    const auto &report = solver.get_convergence_report();
+    deallog << "Stagnated: " << report.stagnated
+            << ", contraction below 1e-3: "
+            << (report.average_contraction < 1e-3) << std::endl;
+  }
+
+  // ILU(0) in float: too inaccurate for refinement
+  {
+    SparseILU<float> ilu;
+    ilu.initialize(A_float);
+
+    const PreconditionMixedPrecision<SparseILU<float>> preconditioner(ilu);
+
+    {
+      SolverControl control(100, 1e-12 * rhs.l2_norm());
+      SolverIterativeRefinement<Vector<double>> solver(control);
+      Vector<double>                            solution(dim);
+      try
+        {
+          solver.solve(A, solution, rhs, preconditioner);
+        }
+      catch (
+        const SolverIterativeRefinement<Vector<double>>::ExcRefinementStagnated
+          &)
+        {
+          deallog << "Refinement stagnated: "
+                  << solver.get_convergence_report().stagnated << std::endl;
+        }
+    }
+
+    {
+      SolverControl control(200, 1e-12 * rhs.l2_norm());
+      SolverGMRES<Vector<double>> solver(control);
+      Vector<double>              solution(dim);
+      check_solver_within_range(
+        solver.solve(A, solution, rhs, preconditioner),
+        control.last_step(),
+        5,
+        60);
+
+      Vector<double> residual(dim);
+      A.vmult(residual, solution);
+      residual -= rhs;
+      deallog << "GMRES-IR residual below tolerance: "
+              << (residual.l2_norm() < 1e-10 * rhs.l2_norm()) << std::endl;
+    }
+  }
+}
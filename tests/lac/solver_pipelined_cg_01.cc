@@ -0,0 +1,120 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Compare SolverPipelinedCG with SolverCG on a 2D Laplacian, both for
+// dealii::Vector and for LinearAlgebra::distributed::Vector, which uses the
+// fused vector updates and the non-blocking reduction. The iteration counts,
+// solutions and condition number estimates must agree.
+
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipelined_cg.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+template <typename VectorType, typename PreconditionerType>
+void
+test(const SparseMatrix<double> &A, const PreconditionerType &preconditioner)
+{
+  VectorType b(A.m()), x_cg(A.m()), x_pipelined(A.m());
+  for (unsigned int i = 0; i < b.size(); ++i)
+    b(i) = 1. + 0.1 * std::sin(0.2 * i);
+
+  double condition_number_cg        = 0.;
+  double condition_number_pipelined = 0.;
+
+  SolverControl control(200, 1e-10);
+  {
+    SolverCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [&](const double cond) { condition_number_cg = cond; });
+    solver.solve(A, x_cg, b, preconditioner);
+  }
+  const unsigned int steps_cg = control.last_step();
+
+  {
+    SolverPipelinedCG<VectorType> solver(control);
+    solver.connect_condition_number_slot(
+      [&](const double cond) { condition_number_pipelined = cond; });
+    solver.solve(A, x_pipelined, b, preconditioner);
+  }
+
+  deallog << "Steps CG: " << steps_cg
+          << ", steps pipelined CG: " << control.last_step() << std::endl;
+
+  x_pipelined -= x_cg;
+  deallog << "Difference of solutions: "
+          << (x_pipelined.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+          << std::endl;
+  deallog << "Difference of condition number estimates: "
+          << (std::abs(condition_number_cg - condition_number_pipelined) <
+                  1e-6 * condition_number_cg ?
+                "below 1e-6 relative" :
+                "too large")
+          << std::endl;
+}
+
+
+
+// A point Jacobi preconditioner that works with all vector types
+template <typename VectorType>
+DiagonalMatrix<VectorType>
+make_jacobi(const SparseMatrix<double> &A)
+{
+  DiagonalMatrix<VectorType> jacobi;
+  jacobi.get_vector().reinit(A.m());
+  for (unsigned int i = 0; i < A.m(); ++i)
+    jacobi.get_vector()(i) = 1. / A.diag_element(i);
+  return jacobi;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog.depth_file(2);
+
+  const unsigned int size = 32;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+  SparseMatrix<double> A(structure);
+  testproblem.five_point(A);
+
+  deallog.push("Vector");
+  test<Vector<double>>(A, PreconditionIdentity());
+  test<Vector<double>>(A, make_jacobi<Vector<double>>(A));
+  deallog.pop();
+
+  using DistributedVector = LinearAlgebra::distributed::Vector<double>;
+  deallog.push("distributed::Vector");
+  test<DistributedVector>(A, PreconditionIdentity());
+  test<DistributedVector>(A, make_jacobi<DistributedVector>(A));
+  deallog.pop();
+}
@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check SparsityPattern::compress_column_indices() and that the kernels of
+// SparseMatrix that use the compressed column indices give the same result
+// as with the global column indices
+
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+#include "../testmatrix.h"
+
+
+double
+difference(const Vector<double> &a, const Vector<double> &b)
+{
+  Vector<double> diff(a);
+  diff -= b;
+  return diff.linfty_norm();
+}
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 17;
+  const unsigned int dim  = (size - 1) * (size - 1);
+
+  FDMatrix        testproblem(size, size);
+  SparsityPattern structure(dim, dim, 5);
+  testproblem.five_point_structure(structure);
+  structure.compress();
+
+  SparsityPattern structure_compressed;
+  structure_compressed.copy_from(structure);
+  deallog << "Compressed: " << structure_compressed.compress_column_indices()
+          << ' ' << structure_compressed.has_compressed_column_indices()
+          << std::endl;
+  deallog << "Original: " << structure.has_compressed_column_indices()
+          << std::endl;
+
+  // use a nonsymmetric matrix to distinguish between vmult and Tvmult
+  SparseMatrix<double> A(structure), A_compressed(structure_compressed);
+  testproblem.five_point(A, true);
+  testproblem.five_point(A_compressed, true);
+
+  Vector<double> src(dim), dst(dim), dst_compressed(dim);
+  for (unsigned int i = 0; i < dim; ++i)
+    src(i) = random_value<double>();
+
+  A.vmult(dst, src);
+  A_compressed.vmult(dst_compressed, src);
+  deallog << "vmult:      " << difference(dst, dst_compressed) << std::endl;
+
+  A.vmult_add(dst, src);
+  A_compressed.vmult_add(dst_compressed, src);
+  deallog << "vmult_add:  " << difference(dst, dst_compressed) << std::endl;
+
+  A.Tvmult(dst, src);
+  A_compressed.Tvmult(dst_compressed, src);
+  deallog << "Tvmult:     " << difference(dst, dst_compressed) << std::endl;
+
+  A.Tvmult_add(dst, src);
+  A_compressed.Tvmult_add(dst_compressed, src);
+  deallog << "Tvmult_add: " << difference(dst, dst_compressed) << std::endl;
+
+  A.precondition_SOR(dst, src, 1.2);
+  A_compressed.precondition_SOR(dst_compressed, src, 1.2);
+  deallog << "SOR:        " << difference(dst, dst_compressed) << std::endl;
+
+  // setting up the pattern anew discards the compressed indices
+  structure_compressed.reinit(dim, dim, 5);
+  testproblem.five_point_structure(structure_compressed);
+  structure_compressed.compress();
+  deallog << "After reinit: "
+          << structure_compressed.has_compressed_column_indices()
+          << std::endl;
+
+  // rectangular pattern with entries on both sides of the diagonal
+  SparsityPattern rectangular(4, 10, 3);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      rectangular.add(i, 0);
+      rectangular.add(i, 9 - i);
+    }
+  rectangular.compress();
+  deallog << "Rectangular: " << rectangular.compress_column_indices()
+          << std::endl;
+  SparseMatrix<double> B(rectangular);
+  for (unsigned int i = 0; i < 4; ++i)
+    {
+      B.set(i, 0, 1. + i);
+      B.set(i, 9 - i, 2. * i - 1.);
+    }
+  Vector<double> src_rect(10), dst_rect(4), Tdst_rect(10);
+  for (unsigned int i = 0; i < 10; ++i)
+    src_rect(i) = i + 1.;
+  B.vmult(dst_rect, src_rect);
+  deallog << "Rectangular vmult: ";
+  for (const double d : dst_rect)
+    deallog << d << ' ';
+  deallog << std::endl;
+  B.Tvmult(Tdst_rect, dst_rect);
+  deallog << "Rectangular Tvmult: ";
+  for (const double d : Tdst_rect)
+    deallog << d << ' ';
+  deallog << std::endl;
+}
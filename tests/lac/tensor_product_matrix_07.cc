@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test the variants of TensorProductMatrixSymmetricSum::vmult() and
+// apply_inverse() with a user-provided temporary array as well as
+// TensorProductMatrixSymmetricSum::apply_inverse_batched() against the
+// variants with two arguments. The number of matrices is chosen not to be a
+// multiple of the SIMD width.
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/tensor_product_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim, int n_rows_1d>
+void
+do_test(const unsigned int size, const unsigned int n_matrices)
+{
+  deallog << "Testing dim=" << dim << ", degree=" << size
+          << ", n_matrices=" << n_matrices << std::endl;
+
+  using MatrixType = TensorProductMatrixSymmetricSum<dim, double, n_rows_1d>;
+  std::vector<MatrixType> matrices(n_matrices);
+  for (unsigned int m = 0; m < n_matrices; ++m)
+    {
+      std::array<Table<2, double>, dim> mass;
+      std::array<Table<2, double>, dim> laplace;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const double h = 1. + 0.1 * (m + d);
+          mass[d].reinit(size, size);
+          laplace[d].reinit(size, size);
+          for (unsigned int i = 0; i < size; ++i)
+            {
+              mass[d](i, i) = 2. / 3. * h;
+              if (i > 0)
+                mass[d](i, i - 1) = 1. / 6. * h;
+              if (i < size - 1)
+                mass[d](i, i + 1) = 1. / 6. * h;
+              laplace[d](i, i) = 2. / h;
+              if (i > 0)
+                laplace[d](i, i - 1) = -1. / h;
+              if (i < size - 1)
+                laplace[d](i, i + 1) = -1. / h;
+            }
+        }
+      matrices[m].reinit(mass, laplace);
+    }
+
+  const unsigned int n_entries = matrices[0].m();
+  Vector<double>     src(n_matrices * n_entries), dst(src.size()),
+    dst_ref(src.size());
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  AlignedVector<double> tmp;
+  double                error_vmult = 0, error_inverse = 0;
+  for (unsigned int m = 0; m < n_matrices; ++m)
+    {
+      const ArrayView<const double> src_view(src.begin() + m * n_entries,
+                                             n_entries);
+      const ArrayView<double> dst_view(dst.begin() + m * n_entries,
+                                       n_entries);
+      const ArrayView<double> dst_ref_view(dst_ref.begin() + m * n_entries,
+                                           n_entries);
+
+      matrices[m].vmult(dst_ref_view, src_view);
+      matrices[m].vmult(dst_view, src_view, tmp);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        error_vmult =
+          std::max(error_vmult, std::abs(dst_view[i] - dst_ref_view[i]));
+
+      matrices[m].apply_inverse(dst_ref_view, src_view);
+      matrices[m].apply_inverse(dst_view, src_view, tmp);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        error_inverse =
+          std::max(error_inverse, std::abs(dst_view[i] - dst_ref_view[i]));
+    }
+  deallog << "Verification of vmult with scratch: "
+          << (error_vmult < 1e-12 ? "OK" : "FAILED") << std::endl;
+  deallog << "Verification of inverse with scratch: "
+          << (error_inverse < 1e-12 ? "OK" : "FAILED") << std::endl;
+
+  dst = 0.;
+  MatrixType::apply_inverse_batched(
+    ArrayView<const MatrixType>(matrices.data(), matrices.size()),
+    ArrayView<double>(dst.begin(), dst.size()),
+    ArrayView<const double>(src.begin(), src.size()));
+  dst -= dst_ref;
+  deallog << "Verification of batched inverse: "
+          << (dst.linfty_norm() < 1e-12 * dst_ref.linfty_norm() ? "OK" :
+                                                                  "FAILED")
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  do_test<1, -1>(3, 7);
+  do_test<2, -1>(1, 3);
+  do_test<2, -1>(4, 7);
+  do_test<2, 5>(5, 9);
+  do_test<3, -1>(3, 7);
+  do_test<3, 4>(4, 5);
+
+  return 0;
+}
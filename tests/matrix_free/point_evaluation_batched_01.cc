@@ -0,0 +1,182 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check FEPointEvaluation set up for a batch of cells with one point per
+// cell by comparing to the evaluation on the individual cells
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_point_evaluation.h>
+
+#include <iostream>
+
+#include "../tests.h"
+
+
+
+double
+difference_norm(const double a, const double b)
+{
+  return std::abs(a - b);
+}
+
+
+
+template <int rank, int dim>
+double
+difference_norm(const Tensor<rank, dim> &a, const Tensor<rank, dim> &b)
+{
+  return (a - b).norm();
+}
+
+
+
+template <int n_components, int dim>
+void
+test(const FiniteElement<dim> &fe, const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1, dim == 2 ? 6 : 12);
+
+  MappingQ<dim> mapping(mapping_degree);
+  deallog << fe.get_name() << " with mapping of degree " << mapping_degree
+          << std::endl;
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  Vector<double> vector(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < vector.size(); ++i)
+    vector(i) = random_value<double>();
+
+  // two points per cell, placed in the batch in a non-contiguous order
+  std::vector<typename Triangulation<dim>::cell_iterator> cells;
+  std::vector<Point<dim>>                                 unit_points;
+  for (unsigned int round = 0; round < 2; ++round)
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        Point<dim> p;
+        for (unsigned int d = 0; d < dim; ++d)
+          p[d] = random_value<double>();
+        cells.push_back(cell);
+        unit_points.push_back(p);
+      }
+
+  const unsigned int  dofs_per_cell = fe.dofs_per_cell;
+  std::vector<double> solution_values(cells.size() * dofs_per_cell);
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+      typename DoFHandler<dim>::cell_iterator(&tria,
+                                              cells[i]->level(),
+                                              cells[i]->index(),
+                                              &dof_handler)
+        ->get_dof_indices(dof_indices);
+      for (unsigned int k = 0; k < dofs_per_cell; ++k)
+        solution_values[i * dofs_per_cell + k] = vector(dof_indices[k]);
+    }
+
+  FEPointEvaluation<n_components, dim> evaluator(
+    mapping, fe, update_values | update_gradients);
+  FEPointEvaluation<n_components, dim> evaluator_batched(
+    mapping, fe, update_values | update_gradients);
+
+  evaluator_batched.reinit(make_array_view(cells),
+                           make_array_view(unit_points));
+  evaluator_batched.evaluate(solution_values,
+                             EvaluationFlags::values |
+                               EvaluationFlags::gradients);
+
+  std::vector<double> cell_values(dofs_per_cell);
+  double              error_evaluate = 0;
+  for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+      std::copy(solution_values.begin() + i * dofs_per_cell,
+                solution_values.begin() + (i + 1) * dofs_per_cell,
+                cell_values.begin());
+      evaluator.reinit(cells[i],
+                       ArrayView<const Point<dim>>(&unit_points[i], 1));
+      evaluator.evaluate(cell_values,
+                         EvaluationFlags::values | EvaluationFlags::gradients);
+      error_evaluate =
+        std::max(error_evaluate,
+                 difference_norm(evaluator.get_value(0),
+                                 evaluator_batched.get_value(i)));
+      error_evaluate =
+        std::max(error_evaluate,
+                 difference_norm(evaluator.get_gradient(0),
+                                 evaluator_batched.get_gradient(i)));
+    }
+  deallog << "Evaluate:  " << (error_evaluate < 1e-12 ? "OK" : "FAILED")
+          << std::endl;
+
+  // test integration with the evaluated values and gradients as test data
+  for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+      evaluator_batched.submit_value(evaluator_batched.get_value(i), i);
+      evaluator_batched.submit_gradient(evaluator_batched.get_gradient(i), i);
+    }
+  std::vector<double> integrated(cells.size() * dofs_per_cell);
+  evaluator_batched.integrate(integrated,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+
+  double error_integrate = 0;
+  for (unsigned int i = 0; i < cells.size(); ++i)
+    {
+      std::copy(solution_values.begin() + i * dofs_per_cell,
+                solution_values.begin() + (i + 1) * dofs_per_cell,
+                cell_values.begin());
+      evaluator.reinit(cells[i],
+                       ArrayView<const Point<dim>>(&unit_points[i], 1));
+      evaluator.evaluate(cell_values,
+                         EvaluationFlags::values | EvaluationFlags::gradients);
+      evaluator.submit_value(evaluator.get_value(0), 0);
+      evaluator.submit_gradient(evaluator.get_gradient(0), 0);
+      evaluator.integrate(cell_values,
+                          EvaluationFlags::values |
+                            EvaluationFlags::gradients);
+      for (unsigned int k = 0; k < dofs_per_cell; ++k)
+        error_integrate =
+          std::max(error_integrate,
+                   std::abs(cell_values[k] -
+                            integrated[i * dofs_per_cell + k]));
+    }
+  deallog << "Integrate: " << (error_integrate < 1e-12 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<1, 2>(FE_Q<2>(1), 1);
+  test<1, 2>(FE_Q<2>(3), 2);
+  test<2, 2>(FESystem<2>(FE_Q<2>(2), 2), 2);
+  test<1, 3>(FE_Q<3>(2), 2);
+  test<3, 3>(FESystem<3>(FE_Q<3>(1), 3), 1);
+}
@@ -0,0 +1,431 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test PreconditionAdditiveSchwarz for a symmetric interior penalty
+// discretization of the Laplacian with FE_DGQ on a Cartesian mesh: on a single
+// cell, the preconditioner is the exact inverse; it is symmetric; it
+// accelerates CG, alone and as preconditioner of a Chebyshev iteration; and
+// it works as smoother in a p-multigrid with MGTransferGlobalCoarsening.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/precondition_additive_schwarz.h>
+
+#include <deal.II/multigrid/mg_coarse.h>
+#include <deal.II/multigrid/mg_matrix.h>
+#include <deal.II/multigrid/mg_smoother.h>
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+#include <deal.II/multigrid/multigrid.h>
+
+#include "../tests.h"
+
+
+// Symmetric interior penalty Laplacian with the penalty parameter assumed by
+// the default local matrices of PreconditionAdditiveSchwarz, i.e., twice the
+// one of step-59 (penalty factor 1)
+template <int dim, typename number = double>
+class LaplaceOperator : public Subscriptor
+{
+public:
+  using value_type = number;
+  using VectorType = LinearAlgebra::distributed::Vector<number>;
+
+  void
+  initialize(const DoFHandler<dim> &dof_handler)
+  {
+    fe_degree = dof_handler.get_fe().degree;
+
+    typename MatrixFree<dim, number>::AdditionalData additional_data;
+    additional_data.mapping_update_flags =
+      update_gradients | update_JxW_values;
+    additional_data.mapping_update_flags_inner_faces =
+      update_JxW_values | update_normal_vectors | update_jacobians;
+    additional_data.mapping_update_flags_boundary_faces =
+      update_JxW_values | update_normal_vectors | update_jacobians;
+
+    AffineConstraints<number> constraints;
+    constraints.close();
+
+    auto data = std::make_shared<MatrixFree<dim, number>>();
+    data->reinit(mapping,
+                 dof_handler,
+                 constraints,
+                 QGauss<1>(fe_degree + 1),
+                 additional_data);
+    matrix_free = data;
+  }
+
+  std::shared_ptr<const MatrixFree<dim, number>>
+  get_matrix_free() const
+  {
+    return matrix_free;
+  }
+
+  void
+  initialize_dof_vector(VectorType &vector) const
+  {
+    matrix_free->initialize_dof_vector(vector);
+  }
+
+  types::global_dof_index
+  m() const
+  {
+    return matrix_free->get_vector_partitioner()->size();
+  }
+
+  number
+  el(const unsigned int, const unsigned int) const
+  {
+    Assert(false, ExcNotImplemented());
+    return 0;
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    matrix_free->loop(&LaplaceOperator::local_apply,
+                      &LaplaceOperator::local_apply_face,
+                      &LaplaceOperator::local_apply_boundary,
+                      this,
+                      dst,
+                      src,
+                      true);
+  }
+
+  void
+  Tvmult(VectorType &dst, const VectorType &src) const
+  {
+    vmult(dst, src);
+  }
+
+private:
+  void
+  local_apply(const MatrixFree<dim, number> &              data,
+              VectorType &                                 dst,
+              const VectorType &                           src,
+              const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, -1, 0, 1, number> phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, EvaluationFlags::gradients);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          phi.submit_gradient(phi.get_gradient(q), q);
+        phi.integrate_scatter(EvaluationFlags::gradients, dst);
+      }
+  }
+
+  void
+  local_apply_face(
+    const MatrixFree<dim, number> &              data,
+    VectorType &                                 dst,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, -1, 0, 1, number> phi_m(data, true);
+    FEFaceEvaluation<dim, -1, 0, 1, number> phi_p(data, false);
+    const auto flags = EvaluationFlags::values | EvaluationFlags::gradients;
+    for (unsigned int face = face_range.first; face < face_range.second; ++face)
+      {
+        phi_m.reinit(face);
+        phi_p.reinit(face);
+        phi_m.gather_evaluate(src, flags);
+        phi_p.gather_evaluate(src, flags);
+        const VectorizedArray<number> sigma =
+          (std::abs((phi_m.get_normal_vector(0) *
+                     phi_m.inverse_jacobian(0))[dim - 1]) +
+           std::abs((phi_m.get_normal_vector(0) *
+                     phi_p.inverse_jacobian(0))[dim - 1])) *
+          number(std::max(fe_degree, 1U) * (fe_degree + 1.0));
+
+        for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+          {
+            const VectorizedArray<number> jump =
+              phi_m.get_value(q) - phi_p.get_value(q);
+            const VectorizedArray<number> average_derivative =
+              (phi_m.get_normal_derivative(q) +
+               phi_p.get_normal_derivative(q)) *
+              number(0.5);
+            const VectorizedArray<number> test_by_value =
+              jump * sigma - average_derivative;
+            phi_m.submit_normal_derivative(-jump * number(0.5), q);
+            phi_p.submit_normal_derivative(-jump * number(0.5), q);
+            phi_m.submit_value(test_by_value, q);
+            phi_p.submit_value(-test_by_value, q);
+          }
+        phi_m.integrate_scatter(flags, dst);
+        phi_p.integrate_scatter(flags, dst);
+      }
+  }
+
+  void
+  local_apply_boundary(
+    const MatrixFree<dim, number> &              data,
+    VectorType &                                 dst,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, -1, 0, 1, number> phi(data, true);
+    const auto flags = EvaluationFlags::values | EvaluationFlags::gradients;
+    for (unsigned int face = face_range.first; face < face_range.second; ++face)
+      {
+        phi.reinit(face);
+        phi.gather_evaluate(src, flags);
+        const VectorizedArray<number> sigma =
+          std::abs((phi.get_normal_vector(0) *
+                    phi.inverse_jacobian(0))[dim - 1]) *
+          number(std::max(fe_degree, 1U) * (fe_degree + 1.0) * 2.);
+
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          {
+            const VectorizedArray<number> jump = phi.get_value(q) * number(2.);
+            const VectorizedArray<number> normal_derivative =
+              phi.get_normal_derivative(q);
+            phi.submit_normal_derivative(-jump * number(0.5), q);
+            phi.submit_value(jump * sigma - normal_derivative, q);
+          }
+        phi.integrate_scatter(flags, dst);
+      }
+  }
+
+  MappingQ1<dim>                                 mapping;
+  std::shared_ptr<const MatrixFree<dim, number>> matrix_free;
+  unsigned int                                   fe_degree;
+};
+
+
+
+template <int dim>
+void
+test_single_cell(const unsigned int degree)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  // use a cell with different extents in the coordinate directions
+  Point<dim> upper_right;
+  for (unsigned int d = 0; d < dim; ++d)
+    upper_right[d] = 0.5 + 0.75 * d;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_rectangle(tria, Point<dim>(), upper_right);
+
+  FE_DGQ<dim>     fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  LaplaceOperator<dim> laplace;
+  laplace.initialize(dof_handler);
+
+  PreconditionAdditiveSchwarz<dim> schwarz;
+  schwarz.initialize(laplace);
+
+  VectorType src, dst, result;
+  laplace.initialize_dof_vector(src);
+  laplace.initialize_dof_vector(dst);
+  laplace.initialize_dof_vector(result);
+  for (auto &entry : src)
+    entry = random_value<double>();
+
+  schwarz.vmult(dst, src);
+  laplace.vmult(result, dst);
+  result -= src;
+  deallog << "Exact inverse on single cell " << fe.get_name() << ": "
+          << (result.linfty_norm() < 1e-10 * src.linfty_norm() ? "OK" :
+                                                                 "FAILED")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_refined(const unsigned int degree, const unsigned int n_refinements)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  deallog << "Testing " << FE_DGQ<dim>(degree).get_name() << " with "
+          << n_refinements << " refinements" << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  // set up the hierarchy of polynomial degrees k, max(1, k/2), ..., 1
+  std::vector<unsigned int> degrees({degree});
+  while (degrees.back() > 1)
+    degrees.push_back(degrees.back() / 2);
+  std::reverse(degrees.begin(), degrees.end());
+
+  const unsigned int min_level = 0;
+  const unsigned int max_level = degrees.size() - 1;
+
+  MGLevelObject<DoFHandler<dim>>       dof_handlers(min_level, max_level, tria);
+  MGLevelObject<LaplaceOperator<dim>>  operators(min_level, max_level);
+  MGLevelObject<AffineConstraints<double>> constraints(min_level, max_level);
+  for (unsigned int l = min_level; l <= max_level; ++l)
+    {
+      dof_handlers[l].distribute_dofs(FE_DGQ<dim>(degrees[l]));
+      operators[l].initialize(dof_handlers[l]);
+      constraints[l].close();
+    }
+
+  const LaplaceOperator<dim> &laplace = operators[max_level];
+
+  PreconditionAdditiveSchwarz<dim> schwarz;
+  schwarz.initialize(laplace);
+
+  VectorType u, v, Pu, Pv;
+  laplace.initialize_dof_vector(u);
+  laplace.initialize_dof_vector(v);
+  laplace.initialize_dof_vector(Pu);
+  laplace.initialize_dof_vector(Pv);
+  for (unsigned int i = 0; i < u.locally_owned_size(); ++i)
+    {
+      u.local_element(i) = random_value<double>();
+      v.local_element(i) = random_value<double>();
+    }
+  schwarz.vmult(Pu, u);
+  schwarz.vmult(Pv, v);
+  deallog << "Symmetry: "
+          << (std::abs(v * Pu - u * Pv) < 1e-12 * std::abs(v * Pu) ? "OK" :
+                                                                     "FAILED")
+          << std::endl;
+
+  VectorType rhs, solution;
+  laplace.initialize_dof_vector(rhs);
+  laplace.initialize_dof_vector(solution);
+  rhs = 1.;
+
+  unsigned int n_iterations_identity = 0;
+  {
+    ReductionControl     control(1000, 1e-14, 1e-8, false, false);
+    SolverCG<VectorType> solver(control);
+    solution = 0.;
+    solver.solve(laplace, solution, rhs, PreconditionIdentity());
+    n_iterations_identity = control.last_step();
+  }
+
+  unsigned int n_iterations_schwarz = 0;
+  {
+    ReductionControl     control(1000, 1e-14, 1e-8, false, false);
+    SolverCG<VectorType> solver(control);
+    solution = 0.;
+    solver.solve(laplace, solution, rhs, schwarz);
+    n_iterations_schwarz = control.last_step();
+  }
+  deallog << "CG with Schwarz converges faster than unpreconditioned CG: "
+          << (n_iterations_schwarz < n_iterations_identity) << std::endl;
+
+  using SmootherType = PreconditionChebyshev<LaplaceOperator<dim>,
+                                            VectorType,
+                                            PreconditionAdditiveSchwarz<dim>>;
+  MGLevelObject<typename SmootherType::AdditionalData> smoother_data(min_level,
+                                                                     max_level);
+  for (unsigned int l = min_level; l <= max_level; ++l)
+    {
+      smoother_data[l].preconditioner =
+        std::make_shared<PreconditionAdditiveSchwarz<dim>>();
+      smoother_data[l].preconditioner->initialize(operators[l]);
+      smoother_data[l].smoothing_range     = 15.;
+      smoother_data[l].degree              = 3;
+      smoother_data[l].eig_cg_n_iterations = 10;
+    }
+
+  {
+    SmootherType chebyshev;
+    chebyshev.initialize(laplace, smoother_data[max_level]);
+
+    ReductionControl     control(1000, 1e-14, 1e-8, false, false);
+    SolverCG<VectorType> solver(control);
+    solution = 0.;
+    solver.solve(laplace, solution, rhs, chebyshev);
+    deallog << "CG with Chebyshev around Schwarz converges faster: "
+            << (control.last_step() < n_iterations_schwarz) << std::endl;
+  }
+
+  // p-multigrid with Chebyshev around the Schwarz method as smoother
+  MGLevelObject<MGTwoLevelTransfer<dim, VectorType>> transfers(min_level,
+                                                               max_level);
+  for (unsigned int l = min_level; l < max_level; ++l)
+    transfers[l + 1].reinit(dof_handlers[l + 1],
+                            dof_handlers[l],
+                            constraints[l + 1],
+                            constraints[l]);
+  MGTransferGlobalCoarsening<dim, VectorType> transfer(
+    transfers,
+    [&](const auto l, auto &vec) { operators[l].initialize_dof_vector(vec); });
+
+  mg::Matrix<VectorType> mg_matrix(operators);
+
+  MGSmootherPrecondition<LaplaceOperator<dim>, SmootherType, VectorType>
+    mg_smoother;
+  mg_smoother.initialize(operators, smoother_data);
+
+  ReductionControl     coarse_control(1000, 1e-14, 1e-12, false, false);
+  SolverCG<VectorType> coarse_solver(coarse_control);
+  PreconditionIdentity coarse_preconditioner;
+  MGCoarseGridIterativeSolver<VectorType,
+                              SolverCG<VectorType>,
+                              LaplaceOperator<dim>,
+                              PreconditionIdentity>
+    mg_coarse(coarse_solver, operators[min_level], coarse_preconditioner);
+
+  Multigrid<VectorType> mg(
+    mg_matrix, mg_coarse, transfer, mg_smoother, mg_smoother);
+  PreconditionMG<dim, VectorType, MGTransferGlobalCoarsening<dim, VectorType>>
+    preconditioner(dof_handlers[max_level], mg, transfer);
+
+  {
+    ReductionControl     control(100, 1e-14, 1e-8, false, false);
+    SolverCG<VectorType> solver(control);
+    solution = 0.;
+    solver.solve(laplace, solution, rhs, preconditioner);
+    deallog << "CG with p-multigrid converges in less than 15 iterations: "
+            << (control.last_step() < 15) << std::endl;
+  }
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_init(argc, argv, 1);
+
+  initlog();
+
+  test_single_cell<2>(1);
+  test_single_cell<2>(4);
+  test_single_cell<3>(3);
+
+  test_refined<2>(4, 3);
+  test_refined<3>(3, 2);
+}
@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test SolverCG with a matrix-free operator whose vmult() passes the
+// operations of the solver to MatrixFree::cell_loop() as
+// operation_before_loop and operation_after_loop, which makes the solver use
+// the fused vector updates. Compare with the same operator hidden behind the
+// plain vmult() interface, and check that repeated solves give the same
+// result bit by bit.
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+template <int dim, int fe_degree>
+class HelmholtzOperator
+{
+public:
+  HelmholtzOperator(const MatrixFree<dim, double> &data)
+    : data(data)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    vmult(dst, src, {}, {});
+  }
+
+  void
+  vmult(VectorType &      dst,
+        const VectorType &src,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_before_loop,
+        const std::function<void(const unsigned int, const unsigned int)>
+          &operation_after_loop) const
+  {
+    // the cell loop with operations before and after the loop does not zero
+    // the destination vector, so do it together with the operation of the
+    // solver
+    data.cell_loop(
+      &HelmholtzOperator::local_apply_cell,
+      this,
+      dst,
+      src,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          dst.local_element(i) = 0.;
+        if (operation_before_loop)
+          operation_before_loop(begin, end);
+      },
+      operation_after_loop);
+  }
+
+  void
+  compute_inverse_diagonal(VectorType &inverse_diagonal) const
+  {
+    MatrixFreeTools::compute_diagonal(data,
+                                      inverse_diagonal,
+                                      &HelmholtzOperator::local_apply,
+                                      this);
+    for (auto &entry : inverse_diagonal)
+      entry = 1. / entry;
+  }
+
+private:
+  void
+  local_apply(FEEvaluation<dim, fe_degree> &phi) const
+  {
+    phi.evaluate(EvaluationFlags::values | EvaluationFlags::gradients);
+    for (unsigned int q = 0; q < phi.n_q_points; ++q)
+      {
+        phi.submit_value(10. * phi.get_value(q), q);
+        phi.submit_gradient(phi.get_gradient(q), q);
+      }
+    phi.integrate(EvaluationFlags::values | EvaluationFlags::gradients);
+  }
+
+  void
+  local_apply_cell(
+    const MatrixFree<dim, double> &              matrix_free,
+    VectorType &                                 dst,
+    const VectorType &                           src,
+    const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree> phi(matrix_free);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second; ++cell)
+      {
+        phi.reinit(cell);
+        phi.read_dof_values(src);
+        local_apply(phi);
+        phi.distribute_local_to_global(dst);
+      }
+  }
+
+  const MatrixFree<dim, double> &data;
+};
+
+
+// Only provide the plain vmult() interface
+template <typename OperatorType>
+class PlainOperator
+{
+public:
+  PlainOperator(const OperatorType &op)
+    : op(op)
+  {}
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    op.vmult(dst, src);
+  }
+
+  const OperatorType &op;
+};
+
+
+template <typename MatrixType, typename PreconditionerType>
+void
+solve(const MatrixType &        A,
+      const PreconditionerType &preconditioner,
+      VectorType &              x,
+      const VectorType &        b)
+{
+  SolverControl        control(200, 1e-10);
+  SolverCG<VectorType> solver(control);
+
+  x = 0.;
+  solver.solve(A, x, b, preconditioner);
+  deallog << "Converged in " << control.last_step() << " iterations"
+          << std::endl;
+}
+
+
+
+template <typename MatrixType, typename PreconditionerType>
+void
+compare(const MatrixType &        fused_operator,
+        const PreconditionerType &preconditioner,
+        const VectorType &        b)
+{
+  static_assert(internal::SolverCG::supports_fused_iteration<
+                  VectorType,
+                  MatrixType,
+                  PreconditionerType>::value,
+                "Fused path should be selected");
+
+  VectorType x_fused, x_repeated, x_plain;
+  x_fused.reinit(b);
+  x_repeated.reinit(b);
+  x_plain.reinit(b);
+
+  solve(fused_operator, preconditioner, x_fused, b);
+  solve(fused_operator, preconditioner, x_repeated, b);
+
+  bool same_result = true;
+  for (unsigned int i = 0; i < b.locally_owned_size(); ++i)
+    same_result &= (x_fused.local_element(i) == x_repeated.local_element(i));
+  deallog << "Same result when repeated: " << same_result << std::endl;
+
+  const PlainOperator<MatrixType> plain_operator(fused_operator);
+  solve(plain_operator, preconditioner, x_plain, b);
+  x_plain -= x_fused;
+  deallog << "Difference to plain vmult: "
+          << (x_plain.l2_norm() < 1e-8 ? "below 1e-8" : "too large")
+          << std::endl;
+}
+
+
+
+template <int dim, int fe_degree>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(5 - dim);
+
+  FE_Q<dim>       fe(fe_degree);
+  DoFHandler<dim> dof(tria);
+  dof.distribute_dofs(fe);
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  deallog << "Testing " << fe.get_name() << " with " << dof.n_dofs()
+          << " DoFs" << std::endl;
+
+  // use the loop without threads, which runs the operations before and
+  // after the cell loop interleaved with the cells
+  MatrixFree<dim, double>                          matrix_free;
+  typename MatrixFree<dim, double>::AdditionalData data;
+  data.tasks_parallel_scheme = MatrixFree<dim, double>::AdditionalData::none;
+  matrix_free.reinit(
+    MappingQ1<dim>(), dof, constraints, QGauss<1>(fe_degree + 1), data);
+
+  const HelmholtzOperator<dim, fe_degree> fused_operator(matrix_free);
+
+  VectorType b;
+  matrix_free.initialize_dof_vector(b);
+  for (unsigned int i = 0; i < b.locally_owned_size(); ++i)
+    b.local_element(i) = 1. + std::sin(static_cast<double>(i));
+
+  {
+    deallog.push("identity");
+    compare(fused_operator, PreconditionIdentity(), b);
+    deallog.pop();
+  }
+
+  {
+    deallog.push("diagonal");
+    DiagonalMatrix<VectorType> preconditioner;
+    fused_operator.compute_inverse_diagonal(preconditioner.get_vector());
+    compare(fused_operator, preconditioner, b);
+    deallog.pop();
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2, 3>();
+  test<3, 2>();
+}
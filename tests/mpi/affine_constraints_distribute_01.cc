@@ -0,0 +1,152 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check AffineConstraints::distribute(), its generic variant, and the
+// split-phase variant distribute_start()/distribute_finish() for
+// LinearAlgebra::distributed::Vector with constraints that depend on both
+// locally owned entries and entries owned by other processes, comparing
+// against the result for a serial vector
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "../tests.h"
+
+
+template <typename Number>
+double
+compute_error(const LinearAlgebra::distributed::Vector<Number> &vec,
+              const Vector<double> &                            reference)
+{
+  double error = 0;
+  for (const auto i : vec.locally_owned_elements())
+    error = std::max(error, std::abs(vec(i) - reference(i)));
+  return Utilities::MPI::max(error, MPI_COMM_WORLD);
+}
+
+
+template <typename Number>
+void
+fill(LinearAlgebra::distributed::Vector<Number> &vec,
+     Vector<double> &                            reference,
+     const double                                shift)
+{
+  for (unsigned int i = 0; i < reference.size(); ++i)
+    reference(i) = std::sin(1. + i + shift);
+  for (const auto i : vec.locally_owned_elements())
+    vec(i) = reference(i);
+}
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  // each process owns 10 entries. constrain the entries 2 and 7 to
+  // their left neighbor and an entry six indices further to the right, and
+  // the entries 4 and 9 to their right neighbor, which makes some
+  // constraints depend on entries of the next process
+  const unsigned int n = 10 * numproc;
+  IndexSet           locally_owned(n);
+  locally_owned.add_range(10 * myid, 10 * myid + 10);
+
+  AffineConstraints<double> constraints;
+  for (unsigned int i = 0; i < n; ++i)
+    if (i % 5 == 2)
+      {
+        constraints.add_line(i);
+        constraints.add_entry(i, i - 1, 0.5);
+        constraints.add_entry(i, (i + 6) % n, 0.25);
+        constraints.set_inhomogeneity(i, 0.01 * i);
+      }
+    else if (i % 5 == 4)
+      {
+        constraints.add_line(i);
+        constraints.add_entry(i, (i + 1) % n, 2.);
+      }
+  constraints.close();
+
+  Vector<double>                             reference(n);
+  LinearAlgebra::distributed::Vector<double> vec(locally_owned,
+                                                 MPI_COMM_WORLD);
+
+  fill(vec, reference, 0.);
+  constraints.distribute(reference);
+  constraints.distribute(vec);
+  deallog << "distribute(): "
+          << (compute_error(vec, reference) < 1e-14 ? "OK" : "FAILED")
+          << std::endl;
+
+  // repeated calls that reuse the ghosted vector
+  LinearAlgebra::distributed::Vector<double> ghosted_vector;
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      fill(vec, reference, step);
+      constraints.distribute(reference);
+      constraints.distribute_start(vec, ghosted_vector);
+      constraints.distribute_finish(vec, ghosted_vector);
+      deallog << "distribute_start/finish() step " << step << ": "
+              << (compute_error(vec, reference) < 1e-14 ? "OK" : "FAILED")
+              << std::endl;
+    }
+
+  // the generic variant, selected by naming the vector type explicitly
+  fill(vec, reference, 0.);
+  constraints.distribute(reference);
+  constraints.distribute<LinearAlgebra::distributed::Vector<double>>(vec);
+  deallog << "distribute<VectorType>(): "
+          << (compute_error(vec, reference) < 1e-14 ? "OK" : "FAILED")
+          << std::endl;
+
+  // single-precision vector with double-precision constraints
+  LinearAlgebra::distributed::Vector<float> vec_float(locally_owned,
+                                                      MPI_COMM_WORLD);
+  fill(vec_float, reference, 0.);
+  constraints.distribute(reference);
+  constraints.distribute(vec_float);
+  deallog << "distribute() float: "
+          << (compute_error(vec_float, reference) < 1e-6 ? "OK" : "FAILED")
+          << std::endl;
+}
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+
+      test();
+    }
+  else
+    test();
+}
@@ -0,0 +1,206 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check Utilities::MPI::isum() and compare SolverPipelinedCG with SolverCG
+// for a LinearAlgebra::distributed::Vector distributed over several
+// processes, where the non-blocking reduction of the pipelined method runs
+// while the operator exchanges ghost values
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+#include <deal.II/lac/solver_cg.h>
+#include <deal.II/lac/solver_control.h>
+#include <deal.II/lac/solver_pipelined_cg.h>
+
+#include "../tests.h"
+
+
+using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+
+void
+test_isum()
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  const double values[3] = {1. + myid, 0.5 * myid, -2.};
+  double       sums[3];
+  MPI_Request  request;
+  Utilities::MPI::isum(ArrayView<const double>(values, 3),
+                       MPI_COMM_WORLD,
+                       ArrayView<double>(sums, 3),
+                       request);
+  const int ierr = MPI_Wait(&request, MPI_STATUS_IGNORE);
+  AssertThrowMPI(ierr);
+  deallog << "isum: " << sums[0] << ' ' << sums[1] << ' ' << sums[2]
+          << std::endl;
+
+  // in-place reduction
+  double in_place[2] = {1., 1. * myid};
+  Utilities::MPI::isum(ArrayView<const double>(in_place, 2),
+                       MPI_COMM_WORLD,
+                       ArrayView<double>(in_place, 2),
+                       request);
+  const int ierr2 = MPI_Wait(&request, MPI_STATUS_IGNORE);
+  AssertThrowMPI(ierr2);
+  deallog << "isum in place: " << in_place[0] << ' ' << in_place[1]
+          << std::endl;
+}
+
+
+
+// The matrix of a one-dimensional Laplacian with a varying diagonal, i.e.,
+// entries -1, d_i, -1 with d_i between 2.2 and 3.2, whose rows are
+// distributed over all processes
+class DistributedTridiagonalOperator
+{
+public:
+  DistributedTridiagonalOperator(const unsigned int size)
+    : size(size)
+  {}
+
+  double
+  diagonal(const types::global_dof_index i) const
+  {
+    return 2.7 + 0.5 * std::sin(0.01 * i);
+  }
+
+  void
+  vmult(VectorType &dst, const VectorType &src) const
+  {
+    src.update_ghost_values();
+    for (const auto i : dst.locally_owned_elements())
+      {
+        double sum = diagonal(i) * src(i);
+        if (i > 0)
+          sum -= src(i - 1);
+        if (i + 1 < size)
+          sum -= src(i + 1);
+        dst(i) = sum;
+      }
+    src.zero_out_ghost_values();
+  }
+
+private:
+  const unsigned int size;
+};
+
+
+
+template <typename PreconditionerType>
+void
+test_solver(const DistributedTridiagonalOperator &A,
+            const VectorType &                    b,
+            const PreconditionerType &            preconditioner)
+{
+  VectorType x_cg, x_pipelined;
+  x_cg.reinit(b);
+  x_pipelined.reinit(b);
+
+  SolverControl control(2000, 1e-10);
+  {
+    SolverCG<VectorType> solver(control);
+    solver.solve(A, x_cg, b, preconditioner);
+  }
+  const unsigned int steps_cg = control.last_step();
+
+  {
+    SolverPipelinedCG<VectorType> solver(control);
+    solver.solve(A, x_pipelined, b, preconditioner);
+  }
+
+  deallog << "Steps CG and pipelined CG differ by at most 1: "
+          << (std::abs(static_cast<int>(steps_cg) -
+                       static_cast<int>(control.last_step())) <= 1 ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  x_pipelined -= x_cg;
+  deallog << "Difference of solutions: "
+          << (x_pipelined.linfty_norm() < 1e-8 * x_cg.linfty_norm() ?
+                "below 1e-8 relative" :
+                "too large")
+          << std::endl;
+}
+
+
+
+void
+test()
+{
+  test_isum();
+
+  const unsigned int size = 1000;
+  const unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs =
+    Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  const IndexSet locally_owned =
+    Utilities::create_evenly_distributed_partitioning(myid, n_procs, size);
+  IndexSet ghosts(size);
+  if (locally_owned.n_elements() > 0)
+    {
+      if (locally_owned.nth_index_in_set(0) > 0)
+        ghosts.add_index(locally_owned.nth_index_in_set(0) - 1);
+      if (locally_owned.nth_index_in_set(locally_owned.n_elements() - 1) + 1 <
+          size)
+        ghosts.add_index(
+          locally_owned.nth_index_in_set(locally_owned.n_elements() - 1) + 1);
+    }
+
+  DistributedTridiagonalOperator A(size);
+
+  VectorType b(locally_owned, ghosts, MPI_COMM_WORLD);
+  for (const auto i : locally_owned)
+    b(i) = 1. + 0.1 * std::sin(0.2 * i);
+
+  deallog.push("identity");
+  test_solver(A, b, PreconditionIdentity());
+  deallog.pop();
+
+  DiagonalMatrix<VectorType> jacobi;
+  jacobi.get_vector().reinit(b);
+  for (const auto i : locally_owned)
+    jacobi.get_vector()(i) = 1. / A.diagonal(i);
+  deallog.push("jacobi");
+  test_solver(A, b, jacobi);
+  deallog.pop();
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+
+      test();
+    }
+  else
+    test();
+}
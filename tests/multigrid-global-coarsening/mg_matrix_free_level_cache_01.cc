@@ -0,0 +1,173 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test MGLevelMatrixFreeCache: set up the operators and Chebyshev smoothers
+// of a two-level hierarchy of meshes in several "Newton steps" with a
+// changing coefficient and check that the MatrixFree objects and the
+// coefficient tables are reused, that eigenvalue estimates are reused up to
+// the given limit, and that the cache is invalidated by mesh refinement.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/diagonal_matrix.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/precondition.h>
+
+#include <deal.II/matrix_free/operators.h>
+
+#include <deal.II/multigrid/mg_matrix_free_level_cache.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test()
+{
+  using Number              = double;
+  using VectorType          = LinearAlgebra::distributed::Vector<Number>;
+  using VectorizedArrayType = VectorizedArray<Number>;
+  using OperatorType = MatrixFreeOperators::LaplaceOperator<dim,
+                                                            1,
+                                                            2,
+                                                            1,
+                                                            VectorType,
+                                                            VectorizedArrayType>;
+  using SmootherType =
+    PreconditionChebyshev<OperatorType, VectorType, DiagonalMatrix<VectorType>>;
+
+  const unsigned int n_levels = 2;
+
+  std::vector<Triangulation<dim>> trias(n_levels);
+  for (unsigned int l = 0; l < n_levels; ++l)
+    {
+      GridGenerator::hyper_cube(trias[l]);
+      trias[l].refine_global(2 + l);
+    }
+
+  MappingQ1<dim>                         mapping;
+  FE_Q<dim>                              fe(1);
+  std::vector<DoFHandler<dim>>           dof_handlers(n_levels);
+  std::vector<AffineConstraints<Number>> constraints(n_levels);
+  std::vector<OperatorType>              operators(n_levels);
+  std::vector<SmootherType>              smoothers(n_levels);
+  std::vector<std::shared_ptr<const MatrixFree<dim, Number, VectorizedArrayType>>>
+                                                     old_matrix_free(n_levels);
+  std::vector<const Table<2, VectorizedArrayType> *> old_coefficient(n_levels);
+
+  const auto distribute_dofs = [&]() {
+    for (unsigned int l = 0; l < n_levels; ++l)
+      {
+        dof_handlers[l].reinit(trias[l]);
+        dof_handlers[l].distribute_dofs(fe);
+        constraints[l].clear();
+        DoFTools::make_zero_boundary_constraints(dof_handlers[l],
+                                                 constraints[l]);
+        constraints[l].close();
+      }
+  };
+
+  distribute_dofs();
+
+  MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType> cache(
+    typename MGLevelMatrixFreeCache<dim, Number, VectorizedArrayType>::
+      AdditionalData(true, 2));
+
+  const auto newton_step = [&](const unsigned int step) {
+    deallog << "Step " << step << std::endl;
+    for (unsigned int l = 0; l < n_levels; ++l)
+      {
+        const auto matrix_free = cache.reinit(
+          l, mapping, dof_handlers[l], constraints[l], QGauss<1>(2));
+
+        // a coefficient that depends on the "linearization point", here
+        // simply the step
+        cache.update_coefficient(
+          l, [&](const auto &matrix_free, auto &coefficient) {
+            for (unsigned int cell = 0; cell < matrix_free.n_cell_batches();
+                 ++cell)
+              for (unsigned int q = 0; q < coefficient.size(1); ++q)
+                coefficient(cell, q) = 1. + 0.1 * step;
+          });
+
+        if (step > 0)
+          deallog << "Level " << l << ": same MatrixFree object: "
+                  << (old_matrix_free[l] == matrix_free)
+                  << ", same coefficient table: "
+                  << (old_coefficient[l] == cache.get_coefficient(l).get())
+                  << std::endl;
+        old_matrix_free[l] = matrix_free;
+        old_coefficient[l] = cache.get_coefficient(l).get();
+
+        operators[l].initialize(matrix_free);
+        operators[l].set_coefficient(cache.get_coefficient(l));
+        operators[l].compute_diagonal();
+
+        typename SmootherType::AdditionalData smoother_data;
+        smoother_data.smoothing_range     = 20.;
+        smoother_data.degree              = 5;
+        smoother_data.eig_cg_n_iterations = 20;
+        smoother_data.preconditioner =
+          operators[l].get_matrix_diagonal_inverse();
+
+        VectorType src, dst;
+        matrix_free->initialize_dof_vector(src);
+        matrix_free->initialize_dof_vector(dst);
+
+        cache.initialize_chebyshev(
+          l, smoothers[l], operators[l], smoother_data, src);
+
+        // one smoothing step on a constant right hand side
+        src = 1.;
+        constraints[l].set_zero(src);
+        smoothers[l].vmult(dst, src);
+        deallog << "Level " << l << ": |S b| = " << dst.l2_norm() << std::endl;
+      }
+  };
+
+  for (unsigned int step = 0; step < 5; ++step)
+    newton_step(step);
+
+  deallog << "Refine mesh" << std::endl;
+  for (unsigned int l = 0; l < n_levels; ++l)
+    trias[l].refine_global(1);
+  distribute_dofs();
+  newton_step(5);
+
+  cache.get_statistics().print(deallog.get_file_stream());
+}
+
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(4);
+
+  test<2>();
+}
@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test that MGLevelMatrixFreeCache::reinit() only returns a cached
+// MatrixFree object if the mapping, the MatrixFree::AdditionalData, and the
+// contents of the constraints are the same as for the cached object, and
+// that the cache cannot be copied.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/multigrid/mg_matrix_free_level_cache.h>
+
+#include <type_traits>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test()
+{
+  using Number          = double;
+  using CacheType       = MGLevelMatrixFreeCache<dim, Number>;
+  using MatrixFreeType  = typename CacheType::MatrixFreeType;
+  using MatrixFreeData  = typename MatrixFreeType::AdditionalData;
+  using MatrixFreeConst = std::shared_ptr<const MatrixFreeType>;
+
+  static_assert(!std::is_copy_constructible<CacheType>::value &&
+                  !std::is_copy_assignable<CacheType>::value,
+                "MGLevelMatrixFreeCache must not be copyable");
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  MappingQ1<dim>  mapping;
+  MappingQ<dim>   other_mapping(2);
+  FE_Q<dim>       fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  DoFTools::make_zero_boundary_constraints(dof_handler, constraints);
+  constraints.close();
+
+  // the same constrained indices, but with an inhomogeneity
+  AffineConstraints<Number> other_constraints;
+  DoFTools::make_zero_boundary_constraints(dof_handler, other_constraints);
+  other_constraints.set_inhomogeneity(
+    other_constraints.get_lines().front().index, 1.);
+  other_constraints.close();
+
+  const QGauss<1> quadrature(2);
+
+  CacheType cache;
+
+  MatrixFreeData  data;
+  MatrixFreeConst reference =
+    cache.reinit(0, mapping, dof_handler, constraints, quadrature, data);
+
+  const auto check = [&](const std::string &name, const MatrixFreeConst &mf) {
+    deallog << name << ": " << (mf == reference ? "reused" : "set up")
+            << std::endl;
+    reference = mf;
+  };
+
+  check("same arguments",
+        cache.reinit(0, mapping, dof_handler, constraints, quadrature, data));
+
+  check("other mapping",
+        cache.reinit(
+          0, other_mapping, dof_handler, constraints, quadrature, data));
+
+  check("back to first mapping",
+        cache.reinit(0, mapping, dof_handler, constraints, quadrature, data));
+
+  deallog << "same number of constraints: "
+          << (constraints.n_constraints() == other_constraints.n_constraints())
+          << std::endl;
+  check("other constraint contents",
+        cache.reinit(
+          0, mapping, dof_handler, other_constraints, quadrature, data));
+
+  check("back to first constraints",
+        cache.reinit(0, mapping, dof_handler, constraints, quadrature, data));
+
+  MatrixFreeData data_flags = data;
+  data_flags.mapping_update_flags |= update_quadrature_points;
+  check(
+    "other update flags",
+    cache.reinit(0, mapping, dof_handler, constraints, quadrature, data_flags));
+
+  check(
+    "same update flags",
+    cache.reinit(0, mapping, dof_handler, constraints, quadrature, data_flags));
+
+  MatrixFreeData data_tasks = data_flags;
+  data_tasks.tasks_parallel_scheme = MatrixFreeData::none;
+  check(
+    "other tasks scheme",
+    cache.reinit(0, mapping, dof_handler, constraints, quadrature, data_tasks));
+
+  cache.get_statistics().print(deallog.get_file_stream());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+}
@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test that MGLevelMatrixFreeCache::reinit() only hashes the constraints if
+// they are a different object than the ones of the cached MatrixFree
+// object, and that a mapping created at the address of a destroyed one is
+// not mistaken for the latter.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include <deal.II/multigrid/mg_matrix_free_level_cache.h>
+
+#include <new>
+#include <type_traits>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test()
+{
+  using Number    = double;
+  using CacheType = MGLevelMatrixFreeCache<dim, Number>;
+  using MatrixFreeConst =
+    std::shared_ptr<const typename CacheType::MatrixFreeType>;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  FE_Q<dim>       fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<Number> constraints;
+  DoFTools::make_zero_boundary_constraints(dof_handler, constraints);
+  constraints.close();
+
+  // construct the mapping in a buffer of its own, so that a second mapping
+  // can be created at the same address later on
+  typename std::aligned_storage<sizeof(MappingQ1<dim>),
+                                alignof(MappingQ1<dim>)>::type storage;
+  MappingQ1<dim> *mapping = new (&storage) MappingQ1<dim>();
+
+  const QGauss<1> quadrature(2);
+
+  CacheType       cache;
+  MatrixFreeConst reference =
+    cache.reinit(0, *mapping, dof_handler, constraints, quadrature);
+
+  const auto check = [&](const std::string &name, const MatrixFreeConst &mf) {
+    deallog << name << ": " << (mf == reference ? "reused" : "set up")
+            << ", constraints hashed "
+            << cache.get_statistics().n_constraints_hashes << " times"
+            << std::endl;
+    reference = mf;
+  };
+
+  check("same constraints",
+        cache.reinit(0, *mapping, dof_handler, constraints, quadrature));
+
+  // constraints with the same contents in a different object, as they are
+  // typically rebuilt in every nonlinear iteration
+  AffineConstraints<Number> rebuilt_constraints;
+  DoFTools::make_zero_boundary_constraints(dof_handler, rebuilt_constraints);
+  rebuilt_constraints.close();
+
+  check("rebuilt constraints",
+        cache.reinit(
+          0, *mapping, dof_handler, rebuilt_constraints, quadrature));
+
+  check("rebuilt constraints again",
+        cache.reinit(
+          0, *mapping, dof_handler, rebuilt_constraints, quadrature));
+
+  // a new mapping at the address of the old one
+  mapping->~MappingQ1<dim>();
+  mapping = new (&storage) MappingQ1<dim>();
+
+  check("new mapping at the same address",
+        cache.reinit(
+          0, *mapping, dof_handler, rebuilt_constraints, quadrature));
+
+  check("same mapping",
+        cache.reinit(
+          0, *mapping, dof_handler, rebuilt_constraints, quadrature));
+
+  // the cache unsubscribes from the mapping when it is invalidated, so the
+  // mapping can be destroyed without a subscription being left
+  cache.invalidate();
+  mapping->~MappingQ1<dim>();
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+}
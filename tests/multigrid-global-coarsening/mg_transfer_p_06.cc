@@ -0,0 +1,270 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+/**
+ * Test transfer operator for polynomial coarsening on simplex, wedge and
+ * mixed meshes: the prolongation of a function of the coarse space must
+ * give the same function on the fine space, and the restriction must be the
+ * transpose of the prolongation.
+ *
+ * On the mixed mesh, the elements of the hp::FECollection are ordered
+ * differently on the fine and the coarse level, such that the FE indices
+ * of the two levels differ on every cell.
+ */
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_wedge_p.h>
+#include <deal.II/fe/mapping_fe.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/hp/mapping_collection.h>
+#include <deal.II/hp/q_collection.h>
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include "../simplex/simplex_grids.h"
+#include "mg_transfer_util.h"
+
+using namespace dealii;
+
+
+// Return the largest difference between the finite element functions given
+// by @p vec_fine and @p vec_coarse in the Gauss points of all cells
+template <int dim, typename VectorType>
+double
+max_difference(const hp::MappingCollection<dim> &mapping_fine,
+               const DoFHandler<dim> &           dof_handler_fine,
+               const VectorType &                vec_fine,
+               const hp::MappingCollection<dim> &mapping_coarse,
+               const DoFHandler<dim> &           dof_handler_coarse,
+               const VectorType &                vec_coarse)
+{
+  const auto create_quadrature = [](const hp::FECollection<dim> &fe) {
+    hp::QCollection<dim> quadrature;
+    for (unsigned int i = 0; i < fe.size(); ++i)
+      quadrature.push_back(
+        fe[i].reference_cell().template get_gauss_type_quadrature<dim>(3));
+    return quadrature;
+  };
+
+  hp::FEValues<dim> fe_values_fine(mapping_fine,
+                                   dof_handler_fine.get_fe_collection(),
+                                   create_quadrature(
+                                     dof_handler_fine.get_fe_collection()),
+                                   update_values);
+  hp::FEValues<dim> fe_values_coarse(mapping_coarse,
+                                     dof_handler_coarse.get_fe_collection(),
+                                     create_quadrature(
+                                       dof_handler_coarse.get_fe_collection()),
+                                     update_values);
+
+  double              difference = 0.;
+  std::vector<double> values_fine, values_coarse;
+  auto                cell_coarse = dof_handler_coarse.begin_active();
+  for (const auto &cell_fine : dof_handler_fine.active_cell_iterators())
+    {
+      fe_values_fine.reinit(cell_fine);
+      fe_values_coarse.reinit(cell_coarse);
+
+      const auto &fe_values = fe_values_fine.get_present_fe_values();
+      values_fine.resize(fe_values.n_quadrature_points);
+      values_coarse.resize(fe_values.n_quadrature_points);
+      fe_values.get_function_values(vec_fine, values_fine);
+      fe_values_coarse.get_present_fe_values().get_function_values(
+        vec_coarse, values_coarse);
+
+      for (unsigned int q = 0; q < values_fine.size(); ++q)
+        difference =
+          std::max(difference, std::abs(values_fine[q] - values_coarse[q]));
+
+      ++cell_coarse;
+    }
+
+  return difference;
+}
+
+
+
+// The elements of the collections are selected on each cell by the
+// reference cell of the cell, the first element matching the reference cell
+// is used.
+template <int dim>
+void
+do_test(const Triangulation<dim> &        tria,
+        const hp::FECollection<dim> &     fe_fine,
+        const hp::MappingCollection<dim> &mapping_fine,
+        const hp::FECollection<dim> &     fe_coarse,
+        const hp::MappingCollection<dim> &mapping_coarse)
+{
+  using VectorType = LinearAlgebra::distributed::Vector<double>;
+
+  const auto setup_dofs = [&](DoFHandler<dim> &            dof_handler,
+                              const hp::FECollection<dim> &fe) {
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      for (unsigned int i = 0; i < fe.size(); ++i)
+        if (fe[i].reference_cell() == cell->reference_cell())
+          {
+            cell->set_active_fe_index(i);
+            break;
+          }
+    dof_handler.distribute_dofs(fe);
+  };
+
+  DoFHandler<dim> dof_handler_fine(tria);
+  setup_dofs(dof_handler_fine, fe_fine);
+
+  DoFHandler<dim> dof_handler_coarse(tria);
+  setup_dofs(dof_handler_coarse, fe_coarse);
+
+  AffineConstraints<double> constraint_fine;
+  constraint_fine.close();
+  AffineConstraints<double> constraint_coarse;
+  constraint_coarse.close();
+
+  MGTwoLevelTransfer<dim, VectorType> transfer;
+  transfer.reinit(dof_handler_fine,
+                  dof_handler_coarse,
+                  constraint_fine,
+                  constraint_coarse);
+
+  VectorType src, dst;
+  initialize_dof_vector(dst, dof_handler_fine, numbers::invalid_unsigned_int);
+  initialize_dof_vector(src, dof_handler_coarse, numbers::invalid_unsigned_int);
+
+  // the prolongation of a function of the coarse space must give the same
+  // function on the fine space, which contains the coarse space
+  for (auto &value : src)
+    value = random_value<double>();
+  transfer.prolongate_and_add(dst, src);
+  deallog << "Prolongation reproduces coarse function: "
+          << (max_difference(mapping_fine,
+                             dof_handler_fine,
+                             dst,
+                             mapping_coarse,
+                             dof_handler_coarse,
+                             src) < 1e-12)
+          << std::endl;
+
+  // restriction as the transpose of the prolongation
+  VectorType fine_values;
+  fine_values.reinit(dst);
+  for (auto &value : fine_values)
+    value = random_value<double>();
+
+  dst = 0.;
+  transfer.prolongate_and_add(dst, src);
+  const double prolongated_product = dst * fine_values;
+
+  VectorType coarse_values;
+  coarse_values.reinit(src);
+  transfer.restrict_and_add(coarse_values, fine_values);
+  const double restricted_product = coarse_values * src;
+
+  deallog << "Restriction is transpose of prolongation: "
+          << (std::abs(prolongated_product - restricted_product) <
+              1e-12 * std::abs(prolongated_product))
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_simplex(const unsigned int degree_fine, const unsigned int degree_coarse)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, dim == 2 ? 4 : 2);
+
+  const MappingFE<dim> mapping(FE_SimplexP<dim>(1));
+
+  deallog.push("SimplexP<" + std::to_string(dim) + ">(" +
+               std::to_string(degree_fine) + ")<->SimplexP<" +
+               std::to_string(dim) + ">(" + std::to_string(degree_coarse) +
+               ")");
+  do_test<dim>(tria,
+               hp::FECollection<dim>(FE_SimplexP<dim>(degree_fine)),
+               hp::MappingCollection<dim>(mapping),
+               hp::FECollection<dim>(FE_SimplexP<dim>(degree_coarse)),
+               hp::MappingCollection<dim>(mapping));
+  deallog.pop();
+}
+
+
+
+void
+test_wedge(const unsigned int degree_fine, const unsigned int degree_coarse)
+{
+  Triangulation<3> tria;
+  GridGenerator::subdivided_hyper_cube_with_wedges(tria, 2);
+
+  const MappingFE<3> mapping(FE_WedgeP<3>(1));
+
+  deallog.push("WedgeP<3>(" + std::to_string(degree_fine) + ")<->WedgeP<3>(" +
+               std::to_string(degree_coarse) + ")");
+  do_test<3>(tria,
+             hp::FECollection<3>(FE_WedgeP<3>(degree_fine)),
+             hp::MappingCollection<3>(mapping),
+             hp::FECollection<3>(FE_WedgeP<3>(degree_coarse)),
+             hp::MappingCollection<3>(mapping));
+  deallog.pop();
+}
+
+
+
+void
+test_mixed(const unsigned int degree_fine, const unsigned int degree_coarse)
+{
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_cube_with_simplices_mix(tria, 4);
+
+  const MappingFE<2> mapping_simplex(FE_SimplexP<2>(1));
+  const MappingQ<2>  mapping_quad(1);
+
+  deallog.push("mixed(" + std::to_string(degree_fine) + ")<->mixed(" +
+               std::to_string(degree_coarse) + ")");
+  do_test<2>(tria,
+             hp::FECollection<2>(FE_SimplexP<2>(degree_fine),
+                                 FE_Q<2>(degree_fine)),
+             hp::MappingCollection<2>(mapping_simplex, mapping_quad),
+             hp::FECollection<2>(FE_Q<2>(degree_coarse),
+                                 FE_SimplexP<2>(degree_coarse)),
+             hp::MappingCollection<2>(mapping_quad, mapping_simplex));
+  deallog.pop();
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  initlog();
+
+  test_simplex<2>(2, 1);
+  test_simplex<3>(2, 1);
+  test_wedge(2, 1);
+  test_mixed(2, 1);
+}
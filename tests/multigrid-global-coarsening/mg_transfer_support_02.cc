@@ -0,0 +1,53 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Print all degree pairs for which a fast polynomial transfer is available
+// for simplex, wedge, and pyramid elements.
+
+#include <deal.II/multigrid/mg_transfer_global_coarsening.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const ReferenceCell &reference_cell)
+{
+  deallog << reference_cell.to_string() << std::endl;
+
+  for (unsigned int i = 1; i < 5; ++i)
+    {
+      for (unsigned int j = 1; j < 5; ++j)
+        if (MGTwoLevelTransfer<dim, LinearAlgebra::distributed::Vector<double>>::
+              fast_polynomial_transfer_supported(i, j, reference_cell))
+          deallog << 1 << " ";
+        else
+          deallog << "  ";
+      deallog << std::endl;
+    }
+}
+
+int
+main()
+{
+  initlog();
+
+  test<2>(ReferenceCells::Triangle);
+  test<3>(ReferenceCells::Tetrahedron);
+  test<3>(ReferenceCells::Wedge);
+  test<3>(ReferenceCells::Pyramid);
+}
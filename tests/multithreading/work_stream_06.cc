@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2020 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test WorkStream::run for ranges that are short or not a multiple of the
+// chunk size, where the last items of the pipeline get fewer elements than
+// chunk_size. verify that the copier still sees every element exactly once
+// and in the order of the input range, also for iterators that are not
+// random access iterators and for which the length of the range is therefore
+// not known in advance, and that the colored version visits every element
+// exactly once, too
+
+#include <deal.II/base/work_stream.h>
+
+#include <list>
+
+#include "../tests.h"
+
+
+struct ScratchData
+{};
+
+
+struct CopyData
+{
+  unsigned int computed;
+};
+
+
+void
+test(const unsigned int n_elements,
+     const unsigned int queue_length,
+     const unsigned int chunk_size)
+{
+  std::vector<unsigned int> v(n_elements);
+  for (unsigned int i = 0; i < n_elements; ++i)
+    v[i] = i;
+
+  std::vector<unsigned int> result;
+  WorkStream::run(
+    v.begin(),
+    v.end(),
+    [](const std::vector<unsigned int>::iterator &i,
+       ScratchData &,
+       CopyData &copy_data) { copy_data.computed = 2 * *i; },
+    [&result](const CopyData &copy_data) {
+      result.push_back(copy_data.computed);
+    },
+    ScratchData(),
+    CopyData(),
+    queue_length,
+    chunk_size);
+
+  bool in_order = (result.size() == n_elements);
+  for (unsigned int i = 0; i < result.size() && in_order; ++i)
+    if (result[i] != 2 * i)
+      in_order = false;
+
+  // same with a range of bidirectional iterators
+  const std::list<unsigned int> l(v.begin(), v.end());
+  result.clear();
+  WorkStream::run(
+    l.begin(),
+    l.end(),
+    [](const std::list<unsigned int>::const_iterator &i,
+       ScratchData &,
+       CopyData &copy_data) { copy_data.computed = 2 * *i; },
+    [&result](const CopyData &copy_data) {
+      result.push_back(copy_data.computed);
+    },
+    ScratchData(),
+    CopyData(),
+    queue_length,
+    chunk_size);
+
+  bool list_in_order = (result.size() == n_elements);
+  for (unsigned int i = 0; i < result.size() && list_in_order; ++i)
+    if (result[i] != 2 * i)
+      list_in_order = false;
+
+  // now split the range into three colors and run with a copier that
+  // only touches the entry of the current element
+  std::vector<std::vector<std::vector<unsigned int>::iterator>> colors(3);
+  for (auto it = v.begin(); it != v.end(); ++it)
+    colors[*it % 3].push_back(it);
+
+  std::vector<unsigned int> visited(n_elements, 0);
+  WorkStream::run(
+    colors,
+    [](const std::vector<unsigned int>::iterator &i,
+       ScratchData &,
+       CopyData &copy_data) { copy_data.computed = *i; },
+    [&visited](const CopyData &copy_data) { ++visited[copy_data.computed]; },
+    ScratchData(),
+    CopyData(),
+    queue_length,
+    chunk_size);
+
+  const bool all_visited_once =
+    static_cast<unsigned int>(
+      std::count(visited.begin(), visited.end(), 1U)) == n_elements;
+
+  deallog << "n=" << n_elements << " queue_length=" << queue_length
+          << " chunk_size=" << chunk_size << ": "
+          << (in_order ? "ordered" : "NOT ordered") << ", "
+          << (list_in_order ? "list ordered" : "list NOT ordered") << ", "
+          << (all_visited_once ? "complete" : "NOT complete") << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(1, 4, 8);
+  test(5, 4, 8);
+  test(37, 4, 8);
+  test(37, 16, 1);
+  test(1000, 3, 64);
+  test(1000, 32, 8);
+}
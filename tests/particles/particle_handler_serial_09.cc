@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that sort_particles_into_subdomains_and_cells() assigns the particles
+// to the same cells, in the same order, and with the same reference locations
+// on one and on several threads. There are enough cells with particles and
+// enough particles leaving their cells that the work is split into several
+// chunks.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+struct ParticleState
+{
+  types::particle_index id;
+  unsigned int          active_cell_index;
+  Point<dim>            location;
+  Point<dim>            reference_location;
+
+  bool
+  operator==(const ParticleState<dim> &other) const
+  {
+    return id == other.id && active_cell_index == other.active_cell_index &&
+           location == other.location &&
+           reference_location == other.reference_location;
+  }
+};
+
+
+
+// Insert particles into all cells, move them twice along a rotation around
+// the center of the domain such that many particles change their cell and
+// some leave the domain, and return the state of all particles in the order
+// of the particle handler after the insertion and after each step.
+template <int dim>
+std::vector<std::vector<ParticleState<dim>>>
+move_particles(const Triangulation<dim> &tria, const Mapping<dim> &mapping)
+{
+  Particles::ParticleHandler<dim> particle_handler(tria, mapping);
+
+  std::vector<Point<dim>> positions;
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int i = 0; i < 4; ++i)
+      {
+        Point<dim> position = cell->center();
+        for (unsigned int d = 0; d < dim; ++d)
+          position[d] +=
+            0.4 * cell->extent_in_direction(d) * std::sin(1. + i + 3. * d);
+        positions.push_back(position);
+      }
+  particle_handler.insert_particles(positions);
+
+  const auto get_state = [&]() {
+    std::vector<ParticleState<dim>> state;
+    for (const auto &particle : particle_handler)
+      state.push_back(
+        {particle.get_id(),
+         particle.get_surrounding_cell(tria)->active_cell_index(),
+         particle.get_location(),
+         particle.get_reference_location()});
+    return state;
+  };
+
+  std::vector<std::vector<ParticleState<dim>>> states(1, get_state());
+  for (unsigned int step = 0; step < 2; ++step)
+    {
+      for (auto &particle : particle_handler)
+        {
+          Point<dim> location = particle.get_location();
+          const double x = location[0] - 0.5, y = location[1] - 0.5;
+          location[0] += 0.1 * y + 0.02;
+          location[1] -= 0.1 * x;
+          particle.set_location(location);
+        }
+
+      particle_handler.sort_particles_into_subdomains_and_cells();
+      states.push_back(get_state());
+    }
+
+  return states;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+  MappingQ<dim> mapping(1);
+
+  MultithreadInfo::set_thread_limit(1);
+  const auto serial_states = move_particles(tria, mapping);
+
+  // count how many particles changed their cell in each step
+  deallog << serial_states[0].size() << " particles in "
+          << tria.n_active_cells() << " cells" << std::endl;
+  for (unsigned int step = 1; step < serial_states.size(); ++step)
+    {
+      std::map<types::particle_index, unsigned int> old_cells;
+      for (const auto &state : serial_states[step - 1])
+        old_cells[state.id] = state.active_cell_index;
+
+      unsigned int n_moved = 0;
+      for (const auto &state : serial_states[step])
+        if (old_cells[state.id] != state.active_cell_index)
+          ++n_moved;
+
+      deallog << "Step " << step << ": " << serial_states[step].size()
+              << " particles left, " << n_moved << " changed their cell"
+              << std::endl;
+    }
+
+  for (unsigned int n_threads = 2; n_threads <= 4; ++n_threads)
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      deallog << "Same particles, cells and order on " << n_threads
+              << " threads: " << (move_particles(tria, mapping) == serial_states)
+              << std::endl;
+    }
+
+  MultithreadInfo::set_thread_limit(testing_max_num_threads());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(4);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(3);
+  deallog.pop();
+}
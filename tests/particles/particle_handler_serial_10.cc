@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that ParticleHandler::insert_particles() for a vector of positions,
+// which registers all particles at once and fills the cells in parallel,
+// leads to the same particles as inserting them one by one with
+// insert_particle(), for enough cells to be processed by several threads
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+
+#include <deal.II/particles/particle_handler.h>
+
+#include "../tests.h"
+
+
+template <int dim, int spacedim>
+void
+test()
+{
+  Triangulation<dim, spacedim> tr;
+  GridGenerator::hyper_cube(tr);
+  tr.refine_global(3);
+
+  MappingQ<dim, spacedim> mapping(1);
+
+  std::vector<Point<spacedim>> points(2000);
+  for (auto &point : points)
+    point = random_point<spacedim>();
+
+  Particles::ParticleHandler<dim, spacedim> bulk_handler(tr, mapping);
+  bulk_handler.insert_particles(points);
+
+  Particles::ParticleHandler<dim, spacedim> single_handler(tr, mapping);
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      const auto cell_and_reference_location =
+        GridTools::find_active_cell_around_point(mapping, tr, points[i]);
+      single_handler.insert_particle(
+        Particles::Particle<dim, spacedim>(
+          points[i], cell_and_reference_location.second, i),
+        cell_and_reference_location.first);
+    }
+  single_handler.update_cached_numbers();
+
+  deallog << "Particle number: " << bulk_handler.n_global_particles()
+          << std::endl;
+
+  // compare the particles cell by cell, sorted by their ids
+  const auto sorted_particles = [](const auto &particles_in_cell) {
+    std::vector<std::tuple<types::particle_index, Point<spacedim>, Point<dim>>>
+      result;
+    for (const auto &particle : particles_in_cell)
+      result.emplace_back(particle.get_id(),
+                          particle.get_location(),
+                          particle.get_reference_location());
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+      return std::get<0>(a) < std::get<0>(b);
+    });
+    return result;
+  };
+
+  bool same_particles = (bulk_handler.n_locally_owned_particles() ==
+                         single_handler.n_locally_owned_particles());
+  for (const auto &cell : tr.active_cell_iterators())
+    {
+      const auto bulk = sorted_particles(bulk_handler.particles_in_cell(cell));
+      const auto single =
+        sorted_particles(single_handler.particles_in_cell(cell));
+      same_particles &= (bulk.size() == single.size());
+      for (unsigned int i = 0; i < std::min(bulk.size(), single.size()); ++i)
+        same_particles &=
+          (std::get<0>(bulk[i]) == std::get<0>(single[i]) &&
+           std::get<1>(bulk[i]).distance(std::get<1>(single[i])) < 1e-12 &&
+           std::get<2>(bulk[i]).distance(std::get<2>(single[i])) < 1e-12);
+    }
+  deallog << "Same particles as inserted one by one: " << same_particles
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d/2d");
+  test<2, 2>();
+  deallog.pop();
+  deallog.push("3d/3d");
+  test<3, 3>();
+  deallog.pop();
+}
@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// test PropertyPool::register_particles() and sort_memory_slots() for a
+// number of particles that is large enough to be processed in parallel
+
+#include <deal.II/particles/property_pool.h>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  const int          dim          = 2;
+  const int          spacedim     = 2;
+  const unsigned int n_properties = 2;
+  const unsigned int n_particles  = 10000;
+
+  using Handle = typename Particles::PropertyPool<dim, spacedim>::Handle;
+
+  Particles::PropertyPool<dim, spacedim> pool(n_properties);
+
+  // a single particle first, so that the bulk registration does not start
+  // at zero
+  Handle single = pool.register_particle();
+
+  const Handle first = pool.register_particles(n_particles);
+  deallog << "First handle: " << first
+          << ", registered slots: " << pool.n_registered_slots() << std::endl;
+
+  bool initialized = true;
+  for (Handle h = first; h < first + n_particles; ++h)
+    {
+      initialized &= (pool.get_id(h) == numbers::invalid_unsigned_int);
+      initialized &= (pool.get_properties(h)[0] == 0. &&
+                      pool.get_properties(h)[1] == 0.);
+
+      pool.set_id(h, h);
+      pool.set_location(h, Point<spacedim>(h, 2. * h));
+      pool.get_properties(h)[0] = 3. * h;
+      pool.get_properties(h)[1] = 4. * h;
+    }
+  deallog << "New slots initialized: " << initialized << std::endl;
+
+  pool.deregister_particle(single);
+
+  // sort in reverse order
+  std::vector<Handle> handles;
+  for (Handle h = first + n_particles; h > first; --h)
+    handles.push_back(h - 1);
+  pool.sort_memory_slots(handles);
+
+  bool sorted = (pool.n_slots() == n_particles);
+  for (Handle h = 0; h < n_particles; ++h)
+    {
+      const Handle old_handle = first + n_particles - 1 - h;
+      sorted &= (pool.get_id(h) == old_handle);
+      sorted &=
+        (pool.get_location(h) == Point<spacedim>(old_handle, 2. * old_handle));
+      sorted &= (pool.get_properties(h)[0] == 3. * old_handle &&
+                 pool.get_properties(h)[1] == 4. * old_handle);
+    }
+  deallog << "Slots sorted: " << sorted << std::endl;
+
+  for (Handle h = 0; h < n_particles; ++h)
+    {
+      Handle handle = h;
+      pool.deregister_particle(handle);
+    }
+
+  deallog << "OK" << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+  test();
+}
@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test Utilities::MPI::RemotePointEvaluation::reinit_incremental() for
+// points that move slightly, that move across the domain, that leave the
+// domain, and after the triangulation has been refined. The positions
+// recovered from the reference points must match the new points.
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+bool
+check_positions(const Utilities::MPI::RemotePointEvaluation<dim> &rpe,
+              const std::vector<Point<dim>> &                   points)
+{
+  using CellData =
+    typename Utilities::MPI::RemotePointEvaluation<dim>::CellData;
+
+  std::vector<Point<dim>> output;
+  std::vector<Point<dim>> buffer;
+  rpe.template evaluate_and_process<Point<dim>>(
+    output,
+    buffer,
+    [&](const ArrayView<Point<dim>> &values, const CellData &cell_data) {
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const typename Triangulation<dim>::active_cell_iterator cell(
+            &rpe.get_triangulation(),
+            cell_data.cells[c].first,
+            cell_data.cells[c].second);
+          for (unsigned int q = cell_data.reference_point_ptrs[c];
+               q < cell_data.reference_point_ptrs[c + 1];
+               ++q)
+            values[q] = rpe.get_mapping().transform_unit_to_real_cell(
+              cell, cell_data.reference_point_values[q]);
+        }
+    });
+
+  double error = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    error = std::max(error, points[i].distance(output[i]));
+  return Utilities::MPI::max(error, MPI_COMM_WORLD) < 1e-12;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  const MappingQ1<dim> mapping;
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 10; ++i)
+    {
+      Point<dim> p;
+      p[0] = 0.093 * i + 0.031;
+      for (unsigned int d = 1; d < dim; ++d)
+        p[d] = 0.27 + 0.05 * my_rank + 0.01 * d;
+      points.push_back(p);
+    }
+
+  Utilities::MPI::RemotePointEvaluation<dim> rpe;
+  rpe.reinit(points, tria, mapping);
+  deallog << "Initial setup, positions OK " << check_positions(rpe, points)
+          << std::endl;
+
+  // move the points by a small amount, partly within their cells and
+  // partly into neighbors
+  for (auto &p : points)
+    p[0] += 0.021;
+  const bool small_move = rpe.reinit_incremental(points);
+  deallog << "Small move, reused " << small_move << ", positions OK "
+          << check_positions(rpe, points) << std::endl;
+
+  // move the points to entirely different cells
+  for (auto &p : points)
+    p[dim - 1] = 1. - p[dim - 1];
+  const bool large_move = rpe.reinit_incremental(points);
+  deallog << "Large move, reused " << large_move << ", positions OK "
+          << check_positions(rpe, points) << std::endl;
+
+  // refining the mesh invalidates the data structures
+  tria.refine_global(1);
+  const bool refined = rpe.reinit_incremental(points);
+  deallog << "After refinement, reused " << refined << ", positions OK "
+          << check_positions(rpe, points) << std::endl;
+
+  // points outside of the domain are not assigned to any cell, so the map
+  // is not unique anymore
+  points[0][0] = 1.5;
+  rpe.reinit_incremental(points);
+  deallog << "Point outside, unique " << rpe.is_map_unique() << std::endl;
+  points[0][0] = 0.51;
+  const bool not_unique = rpe.reinit_incremental(points);
+  deallog << "Point back inside, reused " << not_unique << ", unique "
+          << rpe.is_map_unique() << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
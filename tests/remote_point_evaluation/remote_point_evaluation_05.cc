@@ -0,0 +1,101 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that Utilities::MPI::RemotePointEvaluation keeps its GridTools::Cache
+// across calls to reinit_incremental(), also when these fall back to a full
+// reinit(), and after the triangulation has been refined. The cache is held
+// by a SmartPointer, which would abort the test if the cache was destroyed
+// and built again.
+
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test()
+{
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  const MappingQ1<dim> mapping;
+
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 10; ++i)
+    {
+      Point<dim> p;
+      p[0] = 0.093 * i + 0.031;
+      for (unsigned int d = 1; d < dim; ++d)
+        p[d] = 0.27 + 0.05 * my_rank + 0.01 * d;
+      points.push_back(p);
+    }
+
+  Utilities::MPI::RemotePointEvaluation<dim> rpe;
+  rpe.reinit(points, tria, mapping);
+
+  const SmartPointer<const GridTools::Cache<dim>> cache(&rpe.get_cache());
+  const unsigned int n_vertices_in_cache = cache->get_used_vertices().size();
+
+  for (unsigned int step = 0; step < 5; ++step)
+    {
+      for (auto &p : points)
+        p[0] += 0.013;
+      rpe.reinit_incremental(points);
+    }
+  deallog << "Same cache after incremental updates: "
+          << (&rpe.get_cache() == cache) << std::endl;
+
+  // moving the points across the domain falls back to reinit()
+  for (auto &p : points)
+    p[dim - 1] = 1. - p[dim - 1];
+  const bool reused = rpe.reinit_incremental(points);
+  deallog << "Same cache after full reinit (reused pattern " << reused
+          << "): " << (&rpe.get_cache() == cache) << std::endl;
+
+  // the cache is kept, but its content is updated for the refined mesh
+  tria.refine_global(1);
+  rpe.reinit_incremental(points);
+  deallog << "Same cache after refinement: " << (&rpe.get_cache() == cache)
+          << ", vertices in cache " << n_vertices_in_cache << " -> "
+          << cache->get_used_vertices().size() << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
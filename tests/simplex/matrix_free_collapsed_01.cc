@@ -0,0 +1,174 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2021 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Apply a Helmholtz operator on a simplex mesh with FEEvaluation, set up by
+// MatrixFree with a QCollapsedSimplex quadrature formula so that the
+// sum-factorization kernels in collapsed coordinates are used, and compare
+// the result with the one of a matrix assembled with FEValues and the same
+// quadrature formula.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_fe.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const unsigned int n_q_points_1d)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube_with_simplices(tria, dim == 2 ? 4 : 2);
+
+  // distort the mesh, so that the Jacobians differ between the cells
+  GridTools::transform(
+    [](const Point<dim> &p) {
+      Point<dim> result = p;
+      result[0] += 0.1 * std::sin(3. * p[dim - 1]);
+      return result;
+    },
+    tria);
+
+  MappingFE<dim>               mapping(FE_SimplexP<dim>(1));
+  const QCollapsedSimplex<dim> quad(n_q_points_1d);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients;
+
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(mapping, dof_handler, constraints, quad, additional_data);
+
+  deallog << fe.get_name() << " with " << n_q_points_1d
+          << " points: collapsed kernels "
+          << (matrix_free.get_shape_info().element_type ==
+                  internal::MatrixFreeFunctions::tensor_collapsed_simplex ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  Vector<double> src, dst_mf, dst_mb;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst_mf);
+  matrix_free.initialize_dof_vector(dst_mb);
+  for (unsigned int i = 0; i < src.size(); ++i)
+    src(i) = random_value<double>();
+
+  matrix_free.template cell_loop<Vector<double>, Vector<double>>(
+    [&](const auto &, auto &dst, const auto &src, const auto cells) {
+      FEEvaluation<dim, -1, 0, 1, double> phi(matrix_free);
+      for (unsigned int cell = cells.first; cell < cells.second; ++cell)
+        {
+          phi.reinit(cell);
+          phi.gather_evaluate(src,
+                              EvaluationFlags::values |
+                                EvaluationFlags::gradients);
+          for (unsigned int q = 0; q < phi.n_q_points; ++q)
+            {
+              phi.submit_value(phi.get_value(q), q);
+              phi.submit_gradient(phi.get_gradient(q), q);
+            }
+          phi.integrate_scatter(EvaluationFlags::values |
+                                  EvaluationFlags::gradients,
+                                dst);
+        }
+    },
+    dst_mf,
+    src,
+    true);
+
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+  SparseMatrix<double> matrix(sparsity_pattern);
+
+  FEValues<dim> fe_values(mapping,
+                          fe,
+                          quad,
+                          update_values | update_gradients |
+                            update_JxW_values);
+
+  FullMatrix<double>                   cell_matrix(fe.n_dofs_per_cell(),
+                                 fe.n_dofs_per_cell());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      cell_matrix = 0;
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        for (const unsigned int i : fe_values.dof_indices())
+          for (const unsigned int j : fe_values.dof_indices())
+            cell_matrix(i, j) +=
+              (fe_values.shape_value(i, q) * fe_values.shape_value(j, q) +
+               fe_values.shape_grad(i, q) * fe_values.shape_grad(j, q)) *
+              fe_values.JxW(q);
+      cell->get_dof_indices(dof_indices);
+      constraints.distribute_local_to_global(cell_matrix, dof_indices, matrix);
+    }
+  matrix.vmult(dst_mb, src);
+
+  dst_mf -= dst_mb;
+  deallog << "Relative difference to matrix-based operator: "
+          << (dst_mf.linfty_norm() < 1e-12 * dst_mb.linfty_norm() ? "OK" :
+                                                                     "FAILED")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<2>(FE_SimplexP<2>(degree), degree + 1);
+      test<2>(FE_SimplexDGP<2>(degree), degree + 2);
+    }
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<3>(FE_SimplexP<3>(degree), degree + 1);
+      test<3>(FE_SimplexDGP<3>(degree), degree + 2);
+    }
+}
@@ -0,0 +1,151 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2022 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test the sum-factorization kernels in collapsed coordinates for
+// FE_SimplexP with QCollapsedSimplex against the dense evaluation
+// (tensor_none) that is set up for the same quadrature formula.
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_simplex_p.h>
+
+#include <deal.II/matrix_free/evaluation_kernels.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe, const unsigned int n_q_points_1d)
+{
+  const QCollapsedSimplex<dim> quad(n_q_points_1d);
+
+  double sum_of_weights = 0;
+  for (unsigned int q = 0; q < quad.size(); ++q)
+    sum_of_weights += quad.weight(q);
+
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info(quad, fe);
+
+  deallog << fe.get_name() << " with " << n_q_points_1d
+          << " points: sum of weights " << sum_of_weights
+          << ", collapsed kernels "
+          << (shape_info.element_type ==
+                  internal::MatrixFreeFunctions::tensor_collapsed_simplex ?
+                "yes" :
+                "no")
+          << std::endl;
+
+  const unsigned int n_dofs     = shape_info.dofs_per_component_on_cell;
+  const unsigned int n_q_points = shape_info.n_q_points;
+
+  using EvalCollapsed = internal::FEEvaluationImpl<
+    internal::MatrixFreeFunctions::tensor_collapsed_simplex,
+    dim,
+    -1,
+    0,
+    double>;
+  using EvalDense =
+    internal::FEEvaluationImpl<internal::MatrixFreeFunctions::tensor_none,
+                               dim,
+                               -1,
+                               0,
+                               double>;
+
+  AlignedVector<double> dofs(n_dofs), dofs_ref(n_dofs);
+  AlignedVector<double> values(n_q_points), values_ref(n_q_points);
+  AlignedVector<double> gradients(dim * n_q_points),
+    gradients_ref(dim * n_q_points);
+  AlignedVector<double> scratch(
+    3 * std::max(Utilities::pow(fe.degree + 1, dim), n_q_points));
+
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    dofs[i] = random_value<double>();
+
+  const auto flags = EvaluationFlags::values | EvaluationFlags::gradients;
+  EvalCollapsed::evaluate(1,
+                          flags,
+                          shape_info,
+                          dofs.data(),
+                          values.data(),
+                          gradients.data(),
+                          nullptr,
+                          scratch.data());
+  EvalDense::evaluate(1,
+                      flags,
+                      shape_info,
+                      dofs.data(),
+                      values_ref.data(),
+                      gradients_ref.data(),
+                      nullptr,
+                      scratch.data());
+
+  double error = 0;
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    error = std::max(error, std::abs(values[q] - values_ref[q]));
+  for (unsigned int q = 0; q < dim * n_q_points; ++q)
+    error = std::max(error, std::abs(gradients[q] - gradients_ref[q]));
+  deallog << "Evaluate:  " << (error < 1e-10 ? "OK" : "FAILED") << std::endl;
+
+  for (unsigned int q = 0; q < n_q_points; ++q)
+    values_ref[q] = values[q] = random_value<double>();
+  for (unsigned int q = 0; q < dim * n_q_points; ++q)
+    gradients_ref[q] = gradients[q] = random_value<double>();
+
+  // the collapsed kernels modify the gradients in place, so integrate with
+  // the reference kernel first
+  EvalDense::integrate(1,
+                       flags,
+                       shape_info,
+                       dofs_ref.data(),
+                       values_ref.data(),
+                       gradients_ref.data(),
+                       nullptr,
+                       scratch.data(),
+                       false);
+  EvalCollapsed::integrate(1,
+                           flags,
+                           shape_info,
+                           dofs.data(),
+                           values.data(),
+                           gradients.data(),
+                           nullptr,
+                           scratch.data(),
+                           false);
+
+  error = 0;
+  for (unsigned int i = 0; i < n_dofs; ++i)
+    error = std::max(error, std::abs(dofs[i] - dofs_ref[i]));
+  deallog << "Integrate: " << (error < 1e-10 ? "OK" : "FAILED") << std::endl;
+}
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<2>(FE_SimplexP<2>(degree), degree + 1);
+      test<2>(FE_SimplexDGP<2>(degree), degree + 2);
+    }
+  for (unsigned int degree = 1; degree <= 2; ++degree)
+    {
+      test<3>(FE_SimplexP<3>(degree), degree + 1);
+      test<3>(FE_SimplexDGP<3>(degree), degree + 2);
+    }
+}